@@ -4,25 +4,21 @@
 Automation g_automation;
 
 void Automation::begin() {
-  lastAutomationRun = millis();
-  soilHistoryCount  = 0;
-  soilHistoryIndex  = 0;
+  soilSlope.reset();
   lastSoilSampleMs  = millis();
 
   doorCurrentlyOpen = false;
   fanCurrentlyOn    = false;
   lastDoorChangeMs  = millis();
   lastFanChangeMs   = millis();
+  lastRunMs         = millis();
 }
 
-void Automation::loop() {
-  if (!g_settings.automationEnabled) return;
-
+void Automation::run() {
   unsigned long now = millis();
-  if ((long)(now - lastAutomationRun) < (long)Constants::AUTOMATION_INTERVAL_MS) {
-    return;
-  }
-  lastAutomationRun = now;
+  accountComfort(now);
+
+  if (!g_settings.automationEnabled) return;
 
   if ((long)(now - lastSoilSampleMs) >= (long)SOIL_SAMPLE_INTERVAL_MS &&
       !isnan(g_sensorData.soilMoisture)) {
@@ -35,6 +31,31 @@ void Automation::loop() {
   handleWatering();
 }
 
+// ===== Учёт комфорта =====
+void Automation::accountComfort(unsigned long nowMs) {
+  unsigned long dt = nowMs - lastRunMs;
+  lastRunMs        = nowMs;
+
+  uint8_t mode = g_settings.climateMode;
+  if (mode >= CLIMATE_MODES) return;
+
+  float t = g_sensorData.airTemperature;
+  float h = g_sensorData.airHumidity;
+  if (isnan(t) || isnan(h)) return;
+
+  addMs(climateModeSec[mode], climateModeRemMs[mode], dt);
+  if (t < g_settings.comfortTempMin || t > g_settings.comfortTempMax ||
+      h < g_settings.comfortHumMin  || h > g_settings.comfortHumMax) {
+    addMs(climateOutOfBandSec[mode], climateOutOfBandRemMs[mode], dt);
+  }
+}
+
+void Automation::addMs(unsigned long &sec, uint16_t &remMs, unsigned long dt) {
+  unsigned long ms = remMs + dt % 1000UL;
+  sec  += dt / 1000UL + ms / 1000UL;
+  remMs = ms % 1000UL;
+}
+
 // ===== Климат =====
 void Automation::handleClimate() {
   float t = g_sensorData.airTemperature;
@@ -223,6 +244,13 @@ bool Automation::isWithinWateringWindow() {
 }
 
 // ===== Полив =====
+// Тренд считаем настоящим, только если наклон больше двух стандартных ошибок
+float Automation::dryingRate(const SlopeEstimator::Fit &trend, bool &realTrend) {
+  float slope = (trend.valid && trend.slope < 0.0f && trend.slope > -20.0f) ? -trend.slope : 0.0f;
+  realTrend   = slope >= 0.1f && slope > 2.0f * trend.stdErr;
+  return slope;
+}
+
 void Automation::handleWatering() {
   float moist = g_sensorData.soilMoisture;
   if (isnan(moist)) return;
@@ -236,7 +264,9 @@ void Automation::handleWatering() {
   float lowTh    = setpoint - hyst;
   float highTh   = setpoint + hyst;
 
-  float slope = computeSoilDryingSlope(); // %/час
+  SlopeEstimator::Fit trend = soilSlope.fit();
+  bool  realTrend;
+  float slope      = dryingRate(trend, realTrend);
 
   bool veryDryNow  = moist < (lowTh - 5.0f);
   bool dryNow      = moist < lowTh;
@@ -249,8 +279,8 @@ void Automation::handleWatering() {
   }
 
   if (dryNow) {
-    if (slope >= 0.1f) {
-      Serial.printf("💧 Сухо (%.1f%%), тренд %.2f%%/ч — поливаем\n", moist, slope);
+    if (realTrend) {
+      Serial.printf("💧 Сухо (%.1f%%), тренд %.2f±%.2f%%/ч — поливаем\n", moist, slope, trend.stdErr);
       g_devices.setPump(true, 1200);
     } else {
       Serial.printf("💧 Сухо (%.1f%%), тренд медленный — краткий полив\n", moist);
@@ -267,47 +297,8 @@ void Automation::handleWatering() {
 
 // ===== История влажности =====
 void Automation::recordSoilHistory(float moisture, unsigned long nowMs) {
-  if (soilHistoryCount < SOIL_HISTORY_MAX) {
-    soilHistoryCount++;
-  }
-
-  soilMoistureHistory[soilHistoryIndex] = moisture;
-  soilTimeHistory[soilHistoryIndex]     = nowMs;
-  soilHistoryIndex = (soilHistoryIndex + 1) % SOIL_HISTORY_MAX;
+  SlopeEstimator::Mode mode = g_settings.soilSlopeMode ? SlopeEstimator::EXPONENTIAL
+                                                       : SlopeEstimator::WINDOW;
+  soilSlope.configure(mode, (unsigned long)g_settings.soilSlopeSpanMin * 60UL * 1000UL);
+  soilSlope.add(nowMs, moisture);
 }
-
-float Automation::computeSoilDryingSlope() {
-  if (soilHistoryCount < 4) return 0.0f;
-
-  float n = (float)soilHistoryCount;
-
-  double sumT = 0.0;
-  double sumM = 0.0;
-  double sumTT = 0.0;
-  double sumTM = 0.0;
-
-  uint8_t firstIdx = (soilHistoryIndex + SOIL_HISTORY_MAX - soilHistoryCount) %
-                     SOIL_HISTORY_MAX;
-  unsigned long t0 = soilTimeHistory[firstIdx];
-
-  for (uint8_t i = 0; i < soilHistoryCount; ++i) {
-    uint8_t idx = (firstIdx + i) % SOIL_HISTORY_MAX;
-    unsigned long dtMs = soilTimeHistory[idx] - t0;
-    double tHours = (double)dtMs / 3600000.0;
-    double m      = soilMoistureHistory[idx];
-
-    sumT  += tHours;
-    sumM  += m;
-    sumTT += tHours * tHours;
-    sumTM += tHours * m;
-  }
-
-  double denom = (n * sumTT - sumT * sumT);
-  if (fabs(denom) < 1e-6) return 0.0f;
-
-  double a = (n * sumTM - sumT * sumM) / denom; // slope %/час
-
-  if (a < -20.0 || a > 0.0) return 0.0f;
-
-  return (float)(-a);
-}
\ No newline at end of file
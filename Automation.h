@@ -5,24 +5,40 @@
 #include "Config.h"
 #include "Devices.h"
 #include "Profiles.h"
+#include "SlopeEstimator.h"
 
 class Automation {
 public:
   void begin();
-  void loop();
+  void run();   // задача планировщика, период AUTOMATION_INTERVAL_MS
+
+  // Время работы в каждом climateMode и сколько из него климат был вне
+  // комфортного диапазона (с момента загрузки)
+  static constexpr uint8_t CLIMATE_MODES = 3;
+
+  // Тренд влажности почвы (%/час, отрицательный — сохнет)
+  SlopeEstimator::Fit soilTrend() const { return soilSlope.fit(); }
+
+  // Скорость высыхания по тренду, %/час (0 — не сохнет или тренда нет);
+  // realTrend — наклон не меньше 0,1 %/ч и больше двух стандартных ошибок
+  static float dryingRate(const SlopeEstimator::Fit &trend, bool &realTrend);
+  unsigned long modeSec(uint8_t mode) const      { return mode < CLIMATE_MODES ? climateModeSec[mode] : 0; }
+  unsigned long outOfBandSec(uint8_t mode) const { return mode < CLIMATE_MODES ? climateOutOfBandSec[mode] : 0; }
 
 private:
-  unsigned long lastAutomationRun = 0;
+  unsigned long lastRunMs = 0;
+  // Счётчики в секундах: миллисекунды в 32 битах переполнились бы через
+  // 49,7 суток. Остаток до целой секунды копится отдельно.
+  unsigned long climateModeSec[CLIMATE_MODES]      = {0};
+  unsigned long climateOutOfBandSec[CLIMATE_MODES] = {0};
+  uint16_t      climateModeRemMs[CLIMATE_MODES]      = {0};
+  uint16_t      climateOutOfBandRemMs[CLIMATE_MODES] = {0};
 
   // История влажности почвы
-  static constexpr uint8_t  SOIL_HISTORY_MAX             = 32;
   static constexpr unsigned long SOIL_SAMPLE_INTERVAL_MS = 60UL * 1000UL;
 
-  float         soilMoistureHistory[SOIL_HISTORY_MAX];
-  unsigned long soilTimeHistory[SOIL_HISTORY_MAX];
-  uint8_t       soilHistoryCount  = 0;
-  uint8_t       soilHistoryIndex  = 0;
-  unsigned long lastSoilSampleMs  = 0;
+  SlopeEstimator soilSlope;
+  unsigned long  lastSoilSampleMs = 0;
 
   // Состояние климата
   bool          doorCurrentlyOpen = false;
@@ -42,8 +58,9 @@ private:
   bool  getLocalHour(uint8_t &hourOut);
   bool  isNightTime();
   bool  isWithinWateringWindow();
-  float computeSoilDryingSlope();
   void  recordSoilHistory(float moisture, unsigned long nowMs);
+  void  accountComfort(unsigned long nowMs);
+  static void addMs(unsigned long &sec, uint16_t &remMs, unsigned long dt);
 };
 
 extern Automation g_automation;
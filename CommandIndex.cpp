@@ -0,0 +1,29 @@
+// CommandIndex.cpp
+#include "CommandIndex.h"
+
+bool CommandIndex::add(const char *key, uint8_t id) {
+  if (used >= SLOTS / 2) return false;
+
+  size_t   len = strlen(key);
+  uint32_t h   = fnv1a(key, len);
+  for (uint8_t i = h & (SLOTS - 1);; i = (i + 1) & (SLOTS - 1)) {
+    Slot &s = slots[i];
+    if (!s.key) {
+      s.hash = h;
+      s.key  = key;
+      s.id   = id;
+      used++;
+      return true;
+    }
+    if (s.hash == h && strcmp(s.key, key) == 0) return false;
+  }
+}
+
+uint8_t CommandIndex::find(const char *s, size_t len) const {
+  uint32_t h = fnv1a(s, len);
+  for (uint8_t i = h & (SLOTS - 1);; i = (i + 1) & (SLOTS - 1)) {
+    const Slot &slot = slots[i];
+    if (!slot.key) return NONE;
+    if (slot.hash == h && strncmp(slot.key, s, len) == 0 && slot.key[len] == '\0') return slot.id;
+  }
+}
@@ -0,0 +1,34 @@
+// CommandIndex.h
+#ifndef COMMAND_INDEX_H
+#define COMMAND_INDEX_H
+
+#include <Arduino.h>
+#include "Fnv1a.h"
+
+// Хеш-индекс «строка → номер» для команд Telegram: открытая адресация
+// по FNV-1a, без кучи. Заполняется один раз при старте, поиск — O(1)
+// (заполнение не больше половины, коллизии хешей проверяются сравнением).
+class CommandIndex {
+public:
+  static constexpr uint8_t SLOTS = 128;    // степень двойки
+  static constexpr uint8_t NONE  = 0xFF;
+
+  // key хранится указателем — строка должна жить всё время работы.
+  // false — индекс заполнен или ключ уже есть
+  bool    add(const char *key, uint8_t id);
+  uint8_t find(const char *s, size_t len) const;
+
+  uint8_t size() const { return used; }
+
+private:
+  struct Slot {
+    uint32_t    hash = 0;
+    const char *key  = nullptr;   // nullptr — пусто
+    uint8_t     id   = NONE;
+  };
+
+  Slot    slots[SLOTS];
+  uint8_t used = 0;
+};
+
+#endif // COMMAND_INDEX_H
@@ -0,0 +1,92 @@
+// Commands.cpp
+#include "Commands.h"
+#include "Devices.h"
+#include "Runtime.h"
+
+namespace Commands {
+
+static const char *const DEVICE_NAMES[DEVICE_COUNT] = { "pump", "fan", "light", "door", "auto" };
+static const char *const ACTION_NAMES[ACTION_COUNT] = { "on", "off", "pulse", "open", "half", "close" };
+
+// Допустимые действия устройства: бит (1 << Action)
+static constexpr uint8_t bit(Action a) { return (uint8_t)(1u << a); }
+static constexpr uint8_t ALLOWED[DEVICE_COUNT] = {
+  bit(ACT_ON) | bit(ACT_OFF) | bit(ACT_PULSE),      // pump
+  bit(ACT_ON) | bit(ACT_OFF),                       // fan
+  bit(ACT_ON) | bit(ACT_OFF),                       // light
+  bit(ACT_OPEN) | bit(ACT_HALF) | bit(ACT_CLOSE),   // door
+  bit(ACT_ON) | bit(ACT_OFF),                       // auto
+};
+
+static int8_t lookup(const char *const *names, uint8_t count, const char *s) {
+  for (uint8_t i = 0; i < count; ++i) {
+    if (strcmp(names[i], s) == 0) return (int8_t)i;
+  }
+  return -1;
+}
+
+Result make(const char *device, const char *action, uint16_t arg, Command &out) {
+  int8_t d = lookup(DEVICE_NAMES, DEVICE_COUNT, device);
+  if (d < 0) return UNKNOWN_DEVICE;
+  int8_t a = lookup(ACTION_NAMES, ACTION_COUNT, action);
+  if (a < 0 || !(ALLOWED[d] & bit((Action)a))) return UNKNOWN_ACTION;
+
+  if (a == ACT_PULSE) {
+    if (arg == 0) arg = DEFAULT_PULSE_MS;
+    if (arg > MAX_PULSE_MS) return BAD_ARG;
+  } else if (arg != 0) {
+    return BAD_ARG;
+  }
+
+  out.device = (uint8_t)d;
+  out.action = (uint8_t)a;
+  out.arg    = arg;
+  return OK;
+}
+
+static void apply(const Command &c) {
+  switch (c.device) {
+    case DEV_PUMP:
+      if (c.action == ACT_PULSE) g_devices.setPump(true, c.arg);
+      else                       g_devices.setPump(c.action == ACT_ON, 0);
+      break;
+    case DEV_FAN:
+      g_devices.setFan(c.action == ACT_ON);
+      break;
+    case DEV_LIGHT:
+      g_devices.setLight(c.action == ACT_ON);
+      break;
+    case DEV_DOOR:
+      if      (c.action == ACT_OPEN) g_devices.setDoorAngle(Constants::SERVO_OPEN_ANGLE);
+      else if (c.action == ACT_HALF) g_devices.setDoorAngle(Constants::SERVO_HALF_ANGLE);
+      else                           g_devices.setDoorAngle(Constants::SERVO_CLOSED_ANGLE);
+      break;
+    case DEV_AUTO:
+      g_settings.automationEnabled = (c.action == ACT_ON);
+      break;
+  }
+}
+
+void applyAll(const Command *cmds, uint8_t n, uint32_t *atMs) {
+  ControlLock lock;
+  for (uint8_t i = 0; i < n; ++i) {
+    apply(cmds[i]);
+    if (atMs) atMs[i] = millis();
+  }
+}
+
+const char *deviceName(uint8_t d) { return d < DEVICE_COUNT ? DEVICE_NAMES[d] : "?"; }
+const char *actionName(uint8_t a) { return a < ACTION_COUNT ? ACTION_NAMES[a] : "?"; }
+
+const char *resultName(Result r) {
+  switch (r) {
+    case OK:             return "ok";
+    case UNKNOWN_DEVICE: return "unknown_device";
+    case UNKNOWN_ACTION: return "unknown_action";
+    case BAD_ARG:        return "bad_arg";
+    case NOT_APPLIED:    return "not_applied";
+  }
+  return "?";
+}
+
+}
@@ -0,0 +1,36 @@
+// Commands.h
+#ifndef COMMANDS_H
+#define COMMANDS_H
+
+#include "Config.h"
+
+// Команды исполнителям: «устройство + действие» в компактном виде.
+// Общие для /api/control, сцен (Scenes.h) и Telegram.
+namespace Commands {
+  enum Device : uint8_t { DEV_PUMP = 0, DEV_FAN, DEV_LIGHT, DEV_DOOR, DEV_AUTO, DEVICE_COUNT };
+  enum Action : uint8_t { ACT_ON = 0, ACT_OFF, ACT_PULSE, ACT_OPEN, ACT_HALF, ACT_CLOSE, ACTION_COUNT };
+  enum Result : uint8_t { OK = 0, UNKNOWN_DEVICE, UNKNOWN_ACTION, BAD_ARG, NOT_APPLIED };
+
+  struct Command {
+    uint8_t  device = DEV_PUMP;
+    uint8_t  action = ACT_OFF;
+    uint16_t arg    = 0;     // длительность импульса насоса, мс
+  };
+
+  constexpr uint8_t  MAX_BATCH        = 8;
+  constexpr uint16_t DEFAULT_PULSE_MS = 1000;
+  constexpr uint16_t MAX_PULSE_MS     = 30000;
+
+  // Проверка имён по таблице; arg = 0 — значение по умолчанию
+  Result make(const char *device, const char *action, uint16_t arg, Command &out);
+
+  // Выполнить все команды одним шагом под ControlLock; atMs[i] — millis()
+  // момента, когда команда i вступила в силу
+  void applyAll(const Command *cmds, uint8_t n, uint32_t *atMs);
+
+  const char *deviceName(uint8_t d);
+  const char *actionName(uint8_t a);
+  const char *resultName(Result r);
+}
+
+#endif // COMMANDS_H
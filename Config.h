@@ -5,9 +5,13 @@
 #include <Arduino.h>
 
 // ===== Версия настроек для EEPROM =====
-#define SETTINGS_VERSION 3
+#define SETTINGS_VERSION 5
 #define EEPROM_SIZE      2048
 
+// ===== Сцены (Scenes.h) — в EEPROM после настроек =====
+#define SCENES_VERSION     1
+#define SCENES_EEPROM_ADDR 1024
+
 // ===== Пины =====
 namespace Pins {
   // Реле
@@ -47,13 +51,61 @@ namespace Constants {
 
   constexpr unsigned long SERVO_MOVE_DURATION_MS    = 800;
   constexpr unsigned long SENSOR_READ_INTERVAL_MS   = 5000;
+  constexpr unsigned long SENSOR_POLL_MS            = 10;    // шаг сбора результатов преобразований
+  constexpr unsigned long SOIL_SAMPLE_PERIOD_MS     = 100;   // фоновая пачка АЦП почвы
   constexpr unsigned long AUTOMATION_INTERVAL_MS    = 5000;
+  constexpr unsigned long ACTUATOR_UPDATE_MS        = 20;    // насос, плавное движение двери
+  constexpr unsigned long TIME_PRINT_INTERVAL_MS    = 60000;
+  constexpr unsigned long HISTORY_INTERVAL_MS       = 60000;  // запись в журнал (HistoryStore)
 
   constexpr unsigned long PUMP_COOLDOWN_MS     = 5UL * 60UL * 1000UL;
   constexpr unsigned long PUMP_DAILY_LIMIT_MS  = 15UL * 60UL * 1000UL;
   constexpr unsigned long DAILY_RESET_MS       = 24UL * 60UL * 60UL * 1000UL;
 
   constexpr unsigned long DISPLAY_UPDATE_MS    = 5000;
+
+  constexpr unsigned long STREAM_HEARTBEAT_MS  = 15000;  // ping в /api/stream
+
+  constexpr unsigned long WIFI_SCAN_TTL_MS     = 30000;  // кэш /api/wifi_scan, потом — новый скан
+  constexpr uint8_t       WIFI_SCAN_MAX        = 16;     // сетей в кэше (лучшие по RSSI)
+
+  // Подключение к Wi-Fi (WifiManager)
+  constexpr unsigned long WIFI_CONNECT_TIMEOUT_MS = 15000;           // на одну попытку
+  constexpr unsigned long WIFI_BACKOFF_MIN_MS     = 2000;            // пауза между попытками,
+  constexpr unsigned long WIFI_BACKOFF_MAX_MS     = 5UL * 60UL * 1000UL;  // удваивается до максимума
+  constexpr uint8_t       WIFI_AP_AFTER_FAILS     = 3;               // потеря связи → точка доступа
+  constexpr unsigned long WIFI_AP_LINGER_MS       = 60000;           // AP после подключения
+
+  // Датчики: одиночные преобразования (время — максимум по даташиту)
+  constexpr uint32_t      I2C_CLOCK_HZ          = 400000;
+  constexpr uint8_t       BME280_REG_CTRL_MEAS  = 0xF4;
+  constexpr uint8_t       BME280_CTRL_FORCED_X1 = 0x25; // osrs_t=x1, osrs_p=x1, forced
+  constexpr unsigned long BME280_CONVERSION_MS  = 10;   // 9.3 мс при x1/x1/x1
+  constexpr unsigned long BH1750_CONVERSION_MS  = 180;  // H-Resolution, max
+  constexpr uint8_t       BH1750_OP_ONE_TIME_H  = 0x20; // одно измерение 1 лк, затем power down
+  constexpr float         BH1750_COUNTS_PER_LUX = 1.2f; // при MTreg по умолчанию (69)
+}
+
+// ===== Задачи FreeRTOS =====
+// Управление (датчики, автоматика, исполнители) — на ядре 1 с высоким
+// приоритетом, сеть (Web, Telegram) — на ядре 0, где живёт стек Wi-Fi.
+namespace Tasks {
+  constexpr BaseType_t CONTROL_CORE = 1;
+  constexpr BaseType_t NET_CORE     = 0;
+
+  constexpr UBaseType_t CONTROL_PRIORITY     = 5;
+  constexpr UBaseType_t WEB_PRIORITY         = 2;
+  constexpr UBaseType_t TELEGRAM_PRIORITY    = 1;
+  constexpr UBaseType_t TELEGRAM_RX_PRIORITY = 1;   // long polling getUpdates
+  constexpr UBaseType_t HISTORY_PRIORITY     = 1;   // запись журнала в LittleFS
+
+  constexpr uint32_t CONTROL_STACK     = 6144;
+  constexpr uint32_t WEB_STACK         = 8192;
+  constexpr uint32_t TELEGRAM_STACK    = 12288;
+  constexpr uint32_t TELEGRAM_RX_STACK = 10240;
+  constexpr uint32_t HISTORY_STACK     = 4096;
+
+  constexpr unsigned long WEB_PERIOD_MS     = 50;   // рассылка /api/stream и отложенные действия; запросы — в async_tcp
 }
 
 // ===== Настройки системы (EEPROM) =====
@@ -81,6 +133,15 @@ struct SystemSettings {
   float soilMoistureSetpoint   = 55.0f;
   float soilMoistureHysteresis = 5.0f;
 
+  // Фильтр датчика почвы: медиана пачки → EMA
+  uint8_t soilBurstLen = 15;    // отсчётов в пачке (1..31)
+  float   soilEmaAlpha = 0.1f;  // 0..1, меньше — сильнее сглаживание
+
+  // Оценка скорости высыхания почвы: 0 = скользящее окно, 1 = экспоненциальные веса;
+  // span — длина окна или постоянная времени, минуты (4..60)
+  uint8_t soilSlopeMode    = 0;
+  uint8_t soilSlopeSpanMin = 32;
+
   // Окно времени для полива
   uint8_t wateringStartHour = 6;
   uint8_t wateringEndHour   = 22;
@@ -105,6 +166,7 @@ struct SystemSettings {
 };
 
 // ===== Текущие показания =====
+// POD без кучи: копируется целиком в снимки SensorStore (см. SensorStore.h)
 struct SensorData {
   // Воздух
   float airTemperature = NAN;
@@ -114,6 +176,7 @@ struct SensorData {
   // Почва
   float soilTemperature = NAN;
   float soilMoisture    = NAN;
+  float soilMoistureVar = NAN;  // дисперсия после фильтра, %²
 
   // Свет
   float lightLevelLux   = NAN;
@@ -125,10 +188,37 @@ struct SensorData {
   bool doorOpen = false;
 
   // Диагностика
-  bool   sensorsHealthy = true;
-  String lastError      = "";
+  bool sensorsHealthy = true;
+  char lastError[48]  = "";
+
+  // Момент последнего опроса датчиков (millis)
+  uint32_t timestampMs = 0;
 };
 
+// ===== Числовые каналы SensorData =====
+// Общий порядок каналов для журнала (HistoryStore) и сводок (Rollup)
+namespace Channels {
+  enum : uint8_t { AIR_TEMP = 0, AIR_HUM, AIR_PRESSURE, SOIL_MOISTURE, LIGHT_LUX, COUNT };
+
+  inline const char *name(uint8_t ch) {
+    static const char *const NAMES[COUNT] = {
+      "airTemperature", "airHumidity", "airPressure", "soilMoisture", "lightLevelLux"
+    };
+    return ch < COUNT ? NAMES[ch] : "?";
+  }
+
+  inline float value(const SensorData &sd, uint8_t ch) {
+    switch (ch) {
+      case AIR_TEMP:      return sd.airTemperature;
+      case AIR_HUM:       return sd.airHumidity;
+      case AIR_PRESSURE:  return sd.airPressure;
+      case SOIL_MOISTURE: return sd.soilMoisture;
+      case LIGHT_LUX:     return sd.lightLevelLux;
+      default:            return NAN;
+    }
+  }
+}
+
 // ===== Конфигурация железа =====
 struct DeviceConfig {
   bool    hasBME280  = false;
@@ -151,6 +241,18 @@ struct DeviceConfig {
 namespace TelegramConfig {
   constexpr const char* BOT_TOKEN = "";
   constexpr const char* CHAT_ID   = "";
+
+  // Закрепление сертификата: SHA-256 отпечаток листового сертификата
+  // api.telegram.org ("AB CD ..." или слитно). Пусто — проверяется только
+  // цепочка до корня TELEGRAM_CERTIFICATE_ROOT из UniversalTelegramBot.
+  constexpr const char* CERT_SHA256 = "";
+
+  // Стенд: вместо api.telegram.org — поддельный Bot API на ПК
+  // (tools/tls_resume_bench.py --bot печатает адрес, корень и отпечаток).
+  // Сертификат проверяется по имени api.telegram.org. Пусто — настоящий сервер
+  constexpr const char* TEST_API_HOST = "";
+  constexpr uint16_t    TEST_API_PORT = 8443;
+  constexpr const char* TEST_ROOT_CA  = "";
 }
 
 // Глобальные экземпляры (определены в Devices.cpp)
@@ -1,6 +1,8 @@
 // Devices.cpp
 #include "Devices.h"
 #include "EEPROMManager.h"
+#include "Perf.h"
+#include "SoilSampler.h"
 
 SystemSettings g_settings;
 SensorData     g_sensorData;
@@ -54,61 +56,200 @@ void Devices::begin() {
 
 void Devices::initSensors() {
   Wire.begin();
-
-  // BME280
-  if (bme.begin(0x76) || bme.begin(0x77)) {
+  Wire.setClock(Constants::I2C_CLOCK_HZ);
+
+  // BME280 — forced mode: спит между измерениями
+  uint8_t bmeAddr = 0;
+  if      (bme.begin(0x76)) bmeAddr = 0x76;
+  else if (bme.begin(0x77)) bmeAddr = 0x77;
+  if (bmeAddr) {
+    bme.setSampling(Adafruit_BME280::MODE_FORCED,
+                    Adafruit_BME280::SAMPLING_X1,   // температура
+                    Adafruit_BME280::SAMPLING_X1,   // давление
+                    Adafruit_BME280::SAMPLING_X1,   // влажность
+                    Adafruit_BME280::FILTER_OFF);
     g_deviceConfig.hasBME280  = true;
     g_deviceConfig.bmeHealthy = true;
+    g_deviceConfig.bmeAddr    = bmeAddr;
   }
 
-  // BH1750
-  if (lightMeter.begin(BH1750::CONTINUOUS_HIGH_RES_MODE)) {
+  // BH1750 — one-shot: после измерения сам уходит в power down
+  if (lightMeter.begin(BH1750::ONE_TIME_HIGH_RES_MODE)) {
     g_deviceConfig.hasBH1750  = true;
     g_deviceConfig.bhHealthy  = true;
+    g_deviceConfig.bhAddr     = 0x23;
   }
 
-  // Почва
+  // Почва — фоновая выборка с фильтром
   pinMode(Pins::SOIL_ADC_PIN, INPUT);
+  g_soilSampler.begin();
   g_deviceConfig.hasSoilSensor = true;
 }
 
-void Devices::readSensors() {
-  readBME280();
-  readBH1750();
-  readSoil();
+const char *Devices::sensorName(SensorId id) {
+  switch (id) {
+    case SENSOR_BME280: return "bme280";
+    case SENSOR_BH1750: return "bh1750";
+    case SENSOR_SOIL:   return "soil";
+    default:            return "?";
+  }
+}
+
+// ===== Опрос датчиков (неблокирующий) =====
+void Devices::startSensorCycle() {
+  if (cycleActive) {
+    // Предыдущий цикл не успел — что не ответило, считаем ошибкой
+    for (uint8_t i = 0; i < SENSOR_COUNT; ++i) {
+      if (pendingMask & (1U << i)) timing[i].errors++;
+    }
+  }
+
+  PerfScope perf(Perf::SENSORS);
+  unsigned long now = millis();
+  pendingMask = 0;
+
+  if (g_deviceConfig.hasBME280) {
+    uint32_t t0 = micros();
+    if (triggerBME280()) {
+      pendingMask |= 1U << SENSOR_BME280;
+      triggerMs[SENSOR_BME280] = now;
+      readyAtMs[SENSOR_BME280] = now + Constants::BME280_CONVERSION_MS;
+    } else {
+      timing[SENSOR_BME280].errors++;
+      g_deviceConfig.bmeHealthy = false;
+    }
+    timing[SENSOR_BME280].lastBusUs = micros() - t0;
+  }
+
+  if (g_deviceConfig.hasBH1750) {
+    uint32_t t0 = micros();
+    if (triggerBH1750()) {
+      pendingMask |= 1U << SENSOR_BH1750;
+      triggerMs[SENSOR_BH1750] = now;
+      readyAtMs[SENSOR_BH1750] = now + Constants::BH1750_CONVERSION_MS;
+    } else {
+      timing[SENSOR_BH1750].errors++;
+      g_deviceConfig.bhHealthy = false;
+    }
+    timing[SENSOR_BH1750].lastBusUs = micros() - t0;
+  }
+
+  // Почва — забираем результат фонового фильтра, сразу
+  if (g_deviceConfig.hasSoilSensor) {
+    uint32_t t0 = micros();
+    triggerMs[SENSOR_SOIL] = now;
+    readSoil();
+    finishSensor(SENSOR_SOIL, micros() - t0);
+  }
+
+  cycleActive = true;
+}
+
+bool Devices::serviceSensors() {
+  if (!cycleActive) return false;
+
+  unsigned long now = millis();
+
+  if ((pendingMask & (1U << SENSOR_BME280)) &&
+      (long)(now - readyAtMs[SENSOR_BME280]) >= 0) {
+    PerfScope perf(Perf::SENSORS);
+    uint32_t t0 = micros();
+    collectBME280();
+    finishSensor(SENSOR_BME280, timing[SENSOR_BME280].lastBusUs + (micros() - t0));
+  }
+
+  if ((pendingMask & (1U << SENSOR_BH1750)) &&
+      (long)(now - readyAtMs[SENSOR_BH1750]) >= 0) {
+    PerfScope perf(Perf::SENSORS);
+    uint32_t t0 = micros();
+    collectBH1750();
+    finishSensor(SENSOR_BH1750, timing[SENSOR_BH1750].lastBusUs + (micros() - t0));
+  }
+
+  if (pendingMask != 0) return false;
+
+  cycleActive = false;
+  g_sensorData.timestampMs = now;
+  g_sensorData.sensorsHealthy =
+    (!g_deviceConfig.hasBME280 || g_deviceConfig.bmeHealthy) &&
+    (!g_deviceConfig.hasBH1750 || g_deviceConfig.bhHealthy);
+  return true;
+}
+
+void Devices::finishSensor(SensorId id, uint32_t busUs) {
+  SensorTiming &t = timing[id];
+  t.lastLatencyMs = millis() - triggerMs[id];
+  t.lastBusUs     = busUs;
+  if (t.lastLatencyMs > t.maxLatencyMs) t.maxLatencyMs = t.lastLatencyMs;
+  if (busUs > t.maxBusUs)               t.maxBusUs     = busUs;
+  pendingMask &= ~(1U << id);
+}
+
+bool Devices::triggerBME280() {
+  // Запуск одиночного измерения — одна запись ctrl_meas, без ожидания
+  // (takeForcedMeasurement() библиотеки ждёт окончания преобразования)
+  Wire.beginTransmission(g_deviceConfig.bmeAddr);
+  Wire.write(Constants::BME280_REG_CTRL_MEAS);
+  Wire.write(Constants::BME280_CTRL_FORCED_X1);
+  return Wire.endTransmission() == 0;
 }
 
-void Devices::readBME280() {
-  if (!g_deviceConfig.hasBME280) return;
+bool Devices::triggerBH1750() {
+  // Один байт кода операции, без ожидания
+  // (configure() и readLightLevel() библиотеки ждут преобразования)
+  Wire.beginTransmission(g_deviceConfig.bhAddr);
+  Wire.write(Constants::BH1750_OP_ONE_TIME_H);
+  return Wire.endTransmission() == 0;
+}
 
+void Devices::collectBME280() {
   float t = bme.readTemperature();
   float h = bme.readHumidity();
   float p = bme.readPressure() / 100.0f;
 
+  if (isnan(t) || isnan(h)) {
+    timing[SENSOR_BME280].errors++;
+    g_deviceConfig.bmeHealthy = false;
+    strlcpy(g_sensorData.lastError, "BME280: нет данных", sizeof(g_sensorData.lastError));
+  } else {
+    g_deviceConfig.bmeHealthy = true;
+  }
+
   if (!isnan(t)) g_sensorData.airTemperature = t + g_settings.airTempOffset;
   if (!isnan(h)) g_sensorData.airHumidity    = h + g_settings.airHumOffset;
   if (!isnan(p)) g_sensorData.airPressure    = p;
 }
 
-void Devices::readBH1750() {
-  if (!g_deviceConfig.hasBH1750) return;
-
-  float lux = lightMeter.readLightLevel();
-  if (!isnan(lux) && lux >= 0 && lux <= 65535) {
+void Devices::collectBH1750() {
+  // Результат — два байта, старший первым
+  float lux = NAN;
+  if (Wire.requestFrom(g_deviceConfig.bhAddr, (uint8_t)2) == 2) {
+    uint16_t raw = (uint16_t)Wire.read() << 8;
+    raw |= (uint8_t)Wire.read();
+    lux = raw / Constants::BH1750_COUNTS_PER_LUX;
+  }
+  if (!isnan(lux) && lux <= 65535) {
     g_sensorData.lightLevelLux = lux;
+    g_deviceConfig.bhHealthy   = true;
+  } else {
+    timing[SENSOR_BH1750].errors++;
+    g_deviceConfig.bhHealthy = false;
+    strlcpy(g_sensorData.lastError, "BH1750: нет данных", sizeof(g_sensorData.lastError));
   }
 }
 
 void Devices::readSoil() {
-  if (!g_deviceConfig.hasSoilSensor) return;
+  // Готовое отфильтрованное значение — без обращения к АЦП
+  float raw, rawVar;
+  if (!g_soilSampler.read(raw, rawVar)) return;
 
-  uint16_t raw = analogRead(Pins::SOIL_ADC_PIN);
-  raw          = constrain(raw, Constants::SOIL_ADC_MIN, Constants::SOIL_ADC_MAX);
+  raw = constrain(raw, (float)Constants::SOIL_ADC_MIN, (float)Constants::SOIL_ADC_MAX);
 
-  float moisture = 100.0f * (Constants::SOIL_ADC_MAX - raw) /
-                   (Constants::SOIL_ADC_MAX - Constants::SOIL_ADC_MIN);
+  const float scale = 100.0f / (Constants::SOIL_ADC_MAX - Constants::SOIL_ADC_MIN);
+  float moisture    = scale * (Constants::SOIL_ADC_MAX - raw);
 
-  g_sensorData.soilMoisture = moisture + g_settings.soilMoistOffset;
+  g_sensorData.soilMoisture    = moisture + g_settings.soilMoistOffset;
+  g_sensorData.soilMoistureVar = rawVar * scale * scale;
   // Температуру почвы можно добавить отдельным датчиком
 }
 
@@ -131,6 +272,11 @@ void Devices::setPump(bool on, unsigned long pulseMs) {
       return;
     }
 
+    if (g_sensorData.pumpOn) {
+      accountPumpRun(now);   // перезапуск импульса — засчитываем прошлый
+    } else {
+      switches[ACT_PUMP]++;
+    }
     relayWrite(Pins::RELAY_PUMP, true);
     g_sensorData.pumpOn   = true;
     lastPumpStartMs       = now;
@@ -138,9 +284,9 @@ void Devices::setPump(bool on, unsigned long pulseMs) {
     pumpAutoOff           = (pulseMs > 0);
     pumpOffAtMillis       = now + pulseMs;
   } else {
-    if (g_sensorData.pumpOn && lastPumpStartMs != 0) {
-      unsigned long runMs = now - lastPumpStartMs;
-      totalPumpMsToday   += runMs;
+    if (g_sensorData.pumpOn) {
+      accountPumpRun(now);
+      switches[ACT_PUMP]++;
     }
     relayWrite(Pins::RELAY_PUMP, false);
     g_sensorData.pumpOn = false;
@@ -157,25 +303,42 @@ void Devices::updatePump() {
     relayWrite(Pins::RELAY_PUMP, false);
     g_sensorData.pumpOn = false;
     pumpAutoOff         = false;
-
-    if (lastPumpStartMs != 0) {
-      unsigned long runMs = now - lastPumpStartMs;
-      totalPumpMsToday   += runMs;
-    }
+    switches[ACT_PUMP]++;
+    accountPumpRun(now);
 
     Serial.printf("💧 Насос авто-выкл, сегодня: %lus\n",
                   totalPumpMsToday / 1000UL);
   }
 }
 
+void Devices::accountPumpRun(unsigned long now) {
+  if (lastPumpStartMs == 0) return;
+  unsigned long runMs = now - lastPumpStartMs;
+  totalPumpMsToday   += runMs;
+  totalPumpMsEver    += runMs;
+  lastPumpStartMs     = now;
+}
+
+const char *Devices::actuatorName(ActuatorId id) {
+  switch (id) {
+    case ACT_PUMP:  return "pump";
+    case ACT_FAN:   return "fan";
+    case ACT_LIGHT: return "light";
+    case ACT_DOOR:  return "door";
+    default:        return "?";
+  }
+}
+
 // ===== Вентилятор =====
 void Devices::setFan(bool on) {
+  if (on != g_sensorData.fanOn) switches[ACT_FAN]++;
   relayWrite(Pins::RELAY_FAN, on);
   g_sensorData.fanOn = on;
 }
 
 // ===== Свет =====
 void Devices::setLight(bool on) {
+    if (on != g_sensorData.lightOn) switches[ACT_LIGHT]++;
     relayWrite(Pins::RELAY_LIGHT, on);
     g_sensorData.lightOn = on;
 
@@ -222,6 +385,7 @@ void Devices::setDoorAngle(uint8_t angle) {
   }
 
   angle = constrain(angle, 0, 180);
+  if (angle != targetDoorAngle) switches[ACT_DOOR]++;
 
   targetDoorAngle      = angle;
   doorMoveStartMs      = millis();
@@ -9,10 +9,32 @@
 #include <ESP32Servo.h>
 #include <FastLED.h>
 
+// Задержка опроса одного датчика: от запуска преобразования до готового
+// значения (мс) и собственно работа на шине (мкс)
+struct SensorTiming {
+  uint32_t lastLatencyMs = 0;
+  uint32_t maxLatencyMs  = 0;
+  uint32_t lastBusUs     = 0;
+  uint32_t maxBusUs      = 0;
+  uint32_t errors        = 0;
+};
+
 class Devices {
 public:
+  enum SensorId : uint8_t { SENSOR_BME280 = 0, SENSOR_BH1750, SENSOR_SOIL, SENSOR_COUNT };
+  enum ActuatorId : uint8_t { ACT_PUMP = 0, ACT_FAN, ACT_LIGHT, ACT_DOOR, ACT_COUNT };
+
   void begin();
-  void readSensors();
+
+  // Неблокирующий опрос датчиков:
+  //  startSensorCycle() запускает преобразования (каждые SENSOR_READ_INTERVAL_MS),
+  //  serviceSensors() забирает готовые результаты (каждые SENSOR_POLL_MS)
+  //  и возвращает true, когда цикл завершён и g_sensorData обновлены.
+  void startSensorCycle();
+  bool serviceSensors();
+
+  const SensorTiming &sensorTiming(SensorId id) const { return timing[id]; }
+  static const char  *sensorName(SensorId id);
 
   void loop() {
     updatePump();
@@ -25,6 +47,12 @@ public:
   void setLight(bool on);
   void setDoorAngle(uint8_t angle); // неблокирующее движение
 
+  // Учёт работы исполнителей (с момента загрузки)
+  uint32_t      switchCount(ActuatorId id) const { return switches[id]; }
+  unsigned long pumpMsToday() const { return totalPumpMsToday; }
+  unsigned long pumpMsTotal() const { return totalPumpMsEver; }
+  static const char *actuatorName(ActuatorId id);
+
 private:
   // Датчики
   BH1750          lightMeter;
@@ -46,13 +74,27 @@ private:
   unsigned long totalPumpMsToday = 0;
   unsigned long lastPumpStartMs  = 0;
   unsigned long lastPumpPulseMs  = 0;
+  unsigned long totalPumpMsEver  = 0;
+
+  uint32_t switches[ACT_COUNT] = {0};
+
+  // Цикл опроса
+  bool          cycleActive = false;
+  uint8_t       pendingMask = 0;          // 1 << SensorId
+  unsigned long triggerMs[SENSOR_COUNT]  = {0};
+  unsigned long readyAtMs[SENSOR_COUNT]  = {0};
+  SensorTiming  timing[SENSOR_COUNT];
 
   void initSensors();
-  void readBME280();
-  void readBH1750();
+  bool triggerBME280();
+  bool triggerBH1750();
+  void collectBME280();
+  void collectBH1750();
   void readSoil();
+  void finishSensor(SensorId id, uint32_t busUs);
 
   void updatePump();
+  void accountPumpRun(unsigned long now);
   void updateDoor();
 
   friend class Automation;
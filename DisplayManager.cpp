@@ -1,9 +1,8 @@
 // DisplayManager.cpp
 #include "DisplayManager.h"
+#include "SensorStore.h"
 #include <math.h>
 
-extern SensorData g_sensorData;
-
 DisplayManager g_display;
 
 void DisplayManager::begin() {
@@ -12,17 +11,15 @@ void DisplayManager::begin() {
 }
 
 void DisplayManager::update() {
-  unsigned long now = millis();
-  if (now - lastUpdate < Constants::DISPLAY_UPDATE_MS) return;
-  lastUpdate = now;
+  SensorData sd = g_sensorStore.snapshot();
 
   mode = (mode + 1) % 4;
 
   switch (mode) {
-    case 0: showAirTemp();     break;
-    case 1: showAirHumidity(); break;
-    case 2: showSoilMoisture();break;
-    case 3: showLux();         break;
+    case 0: showAirTemp(sd);     break;
+    case 1: showAirHumidity(sd); break;
+    case 2: showSoilMoisture(sd);break;
+    case 3: showLux(sd);         break;
   }
 }
 
@@ -30,12 +27,12 @@ void DisplayManager::update() {
 // Мы используем кастомные сегменты для буквы 't' и пробел
 static const uint8_t SEG_T = SEG_A | SEG_F | SEG_E | SEG_D; // что-то похожее на 't'
 
-void DisplayManager::showAirTemp() {
-  if (isnan(g_sensorData.airTemperature)) {
+void DisplayManager::showAirTemp(const SensorData &sd) {
+  if (isnan(sd.airTemperature)) {
     display.clear();
     return;
   }
-  int temp = (int)round(g_sensorData.airTemperature);
+  int temp = (int)round(sd.airTemperature);
   temp = constrain(temp, -99, 99);
 
   uint8_t data[4];
@@ -54,12 +51,12 @@ void DisplayManager::showAirTemp() {
   display.setSegments(data);
 }
 
-void DisplayManager::showAirHumidity() {
-  if (isnan(g_sensorData.airHumidity)) {
+void DisplayManager::showAirHumidity(const SensorData &sd) {
+  if (isnan(sd.airHumidity)) {
     display.clear();
     return;
   }
-  int hum = (int)round(g_sensorData.airHumidity);
+  int hum = (int)round(sd.airHumidity);
   hum = constrain(hum, 0, 99);
   // Формат: H XX
   uint8_t data[4];
@@ -74,12 +71,12 @@ void DisplayManager::showAirHumidity() {
   display.setSegments(data);
 }
 
-void DisplayManager::showSoilMoisture() {
-  if (isnan(g_sensorData.soilMoisture)) {
+void DisplayManager::showSoilMoisture(const SensorData &sd) {
+  if (isnan(sd.soilMoisture)) {
     display.clear();
     return;
   }
-  int mos = (int)round(g_sensorData.soilMoisture);
+  int mos = (int)round(sd.soilMoisture);
   mos = constrain(mos, 0, 99);
   // Формат: S XX
   uint8_t data[4];
@@ -94,12 +91,12 @@ void DisplayManager::showSoilMoisture() {
   display.setSegments(data);
 }
 
-void DisplayManager::showLux() {
-  if (isnan(g_sensorData.lightLevelLux)) {
+void DisplayManager::showLux(const SensorData &sd) {
+  if (isnan(sd.lightLevelLux)) {
     display.clear();
     return;
   }
-  int l = (int)round(g_sensorData.lightLevelLux);
+  int l = (int)round(sd.lightLevelLux);
   if (l > 9999) l = 9999;
   if (l < 0) l = 0;
   // Формат: просто число (lux)
@@ -8,17 +8,16 @@
 class DisplayManager {
 public:
   void begin();
-  void update();
+  void update();   // задача планировщика, период DISPLAY_UPDATE_MS
 
 private:
   TM1637Display display{Pins::TM1637_CLK, Pins::TM1637_DIO};
-  unsigned long lastUpdate = 0;
-  uint8_t       mode       = 0;
+  uint8_t       mode = 0;
 
-  void showAirTemp();
-  void showAirHumidity();
-  void showSoilMoisture();
-  void showLux();
+  void showAirTemp(const SensorData &sd);
+  void showAirHumidity(const SensorData &sd);
+  void showSoilMoisture(const SensorData &sd);
+  void showLux(const SensorData &sd);
 };
 
 extern DisplayManager g_display;
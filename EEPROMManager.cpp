@@ -3,6 +3,9 @@
 
 EEPROMManager g_eeprom;
 
+static_assert(sizeof(SystemSettings) <= SCENES_EEPROM_ADDR, "SystemSettings залезает на сцены");
+static_assert(SCENES_EEPROM_ADDR + sizeof(SceneTable) <= EEPROM_SIZE, "SceneTable не помещается в EEPROM");
+
 void EEPROMManager::begin() {
   EEPROM.begin(EEPROM_SIZE);
 }
@@ -32,4 +35,28 @@ void EEPROMManager::resetDefaults(SystemSettings &settings) {
   SystemSettings def;
   settings = def;
   Serial.println(F("🔄 Настройки сброшены к заводским"));
-}
\ No newline at end of file
+}
+
+void EEPROMManager::loadScenes(SceneTable &table) {
+  SceneTable tmp;
+  EEPROM.get(SCENES_EEPROM_ADDR, tmp);
+
+  if (tmp.version != SCENES_VERSION || tmp.count > SceneTable::MAX_SCENES) {
+    Serial.println(F("⚠️ Сцены в EEPROM не найдены, начинаем с пустого списка"));
+    table = SceneTable();
+    saveScenes(table);
+    return;
+  }
+  for (uint8_t i = 0; i < tmp.count; ++i) {
+    if (tmp.scenes[i].count > Scene::MAX_COMMANDS) tmp.scenes[i].count = 0;
+    tmp.scenes[i].name[Scene::NAME_LEN - 1] = '\0';
+  }
+
+  table = tmp;
+}
+
+void EEPROMManager::saveScenes(const SceneTable &table) {
+  EEPROM.put(SCENES_EEPROM_ADDR, table);
+  EEPROM.commit();
+  Serial.println(F("💾 Сцены сохранены в EEPROM"));
+}
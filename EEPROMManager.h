@@ -3,6 +3,7 @@
 #define EEPROM_MANAGER_H
 
 #include "Config.h"
+#include "Scenes.h"
 #include <EEPROM.h>
 
 class EEPROMManager {
@@ -11,6 +12,9 @@ public:
   void loadSettings(SystemSettings &settings);
   void saveSettings(const SystemSettings &settings);
   void resetDefaults(SystemSettings &settings);
+
+  void loadScenes(SceneTable &table);
+  void saveScenes(const SceneTable &table);
 };
 
 extern EEPROMManager g_eeprom;
@@ -0,0 +1,22 @@
+// Fnv1a.h
+#ifndef FNV1A_H
+#define FNV1A_H
+
+#include <Arduino.h>
+
+// 32-битный FNV-1a: ключи индекса команд, чатов и текстов сообщений.
+// Не криптографический — совпадения проверяются сравнением, где это важно.
+inline uint32_t fnv1a(const char *s, size_t len) {
+  uint32_t h = 2166136261UL;
+  for (size_t i = 0; i < len; ++i) {
+    h ^= (uint8_t)s[i];
+    h *= 16777619UL;
+  }
+  return h;
+}
+
+inline uint32_t fnv1a(const char *s) {
+  return fnv1a(s, strlen(s));
+}
+
+#endif // FNV1A_H
@@ -0,0 +1,371 @@
+// HistoryStore.cpp
+#include "HistoryStore.h"
+#include <LittleFS.h>
+#include <time.h>
+
+HistoryStore g_history;
+
+static const char  *HIST_DIR   = "/hist";
+static const float  SCALE[HistoryStore::CHANNELS] = {10.0f, 10.0f, 10.0f, 10.0f, 1.0f};
+
+static constexpr uint8_t  FLAG_STATE = 0x20;
+static constexpr uint8_t  FLAG_TIME  = 0x40;
+static constexpr uint8_t  FLAG_KEY   = 0x80;
+static constexpr size_t   MAX_RECORD = 1 + 5 + 3 + HistoryStore::CHANNELS * 5;
+static constexpr uint32_t NOMINAL_DT = Constants::HISTORY_INTERVAL_MS / 1000UL;
+static constexpr time_t   MIN_VALID_TIME = 1700000000; // NTP ещё не пришёл — не пишем
+
+// Мьютекс журнала на время операции
+class StoreGuard {
+public:
+  explicit StoreGuard(SemaphoreHandle_t m) : mutex(m) { if (mutex) xSemaphoreTake(mutex, portMAX_DELAY); }
+  ~StoreGuard() { if (mutex) xSemaphoreGive(mutex); }
+
+  StoreGuard(const StoreGuard &) = delete;
+  StoreGuard &operator=(const StoreGuard &) = delete;
+
+private:
+  SemaphoreHandle_t mutex;
+};
+
+// ===== varint / zigzag =====
+static inline uint8_t *putVarint(uint8_t *p, uint32_t v) {
+  while (v >= 0x80) {
+    *p++ = (uint8_t)(v | 0x80);
+    v >>= 7;
+  }
+  *p++ = (uint8_t)v;
+  return p;
+}
+
+static inline bool getVarint(const uint8_t *&p, const uint8_t *end, uint32_t &v) {
+  v = 0;
+  for (uint8_t shift = 0; shift < 35; shift += 7) {
+    if (p >= end) return false;
+    uint8_t b = *p++;
+    v |= (uint32_t)(b & 0x7F) << shift;
+    if (!(b & 0x80)) return true;
+  }
+  return false;
+}
+
+static inline uint32_t zigzag(int32_t v)    { return ((uint32_t)v << 1) ^ (uint32_t)(v >> 31); }
+static inline int32_t  unzigzag(uint32_t v) { return (int32_t)(v >> 1) ^ -(int32_t)(v & 1); }
+
+// Время начала блока — из его ключевой записи
+static bool readBlockStart(const char *path, uint32_t &t) {
+  File f = LittleFS.open(path, FILE_READ);
+  if (!f) return false;
+  uint8_t h[5];
+  bool ok = f.read(h, sizeof(h)) == sizeof(h) && (h[0] & FLAG_KEY);
+  f.close();
+  if (ok) t = h[1] | (h[2] << 8) | (h[3] << 16) | ((uint32_t)h[4] << 24);
+  return ok;
+}
+
+// ===== Инициализация =====
+bool HistoryStore::begin() {
+  if (!LittleFS.begin(true)) {
+    Serial.println(F("⚠️ History: LittleFS не смонтирован"));
+    return false;
+  }
+  if (!LittleFS.exists(HIST_DIR)) LittleFS.mkdir(HIST_DIR);
+
+  queue = xQueueCreate(QUEUE_DEPTH, sizeof(Sample));
+  lock  = xSemaphoreCreateMutex();
+  if (!queue || !lock) {
+    Serial.println(F("⚠️ History: нет памяти под очередь"));
+    return false;
+  }
+
+  // Диапазон номеров блоков по именам файлов
+  uint32_t minSeq = 0xFFFFFFFFUL, maxSeq = 0;
+  File dir = LittleFS.open(HIST_DIR);
+  for (File f = dir.openNextFile(); f; f = dir.openNextFile()) {
+    uint32_t seq = strtoul(f.name(), nullptr, 10);
+    if (seq == 0) continue;
+    if (seq < minSeq) minSeq = seq;
+    if (seq > maxSeq) maxSeq = seq;
+  }
+
+  if (maxSeq == 0) {
+    firstSeq = 1;
+    lastSeq  = 0;
+  } else {
+    firstSeq = minSeq;
+    lastSeq  = maxSeq;
+  }
+
+  char path[24];
+  for (uint32_t seq = firstSeq; seq <= lastSeq; ++seq) {
+    uint32_t t = 0;
+    blockPath(seq, path, sizeof(path));
+    readBlockStart(path, t);
+    blockStart[seq % MAX_BLOCKS] = t;
+  }
+
+  needKey = true;
+  ready   = true;
+
+  Serial.printf("🗄 History: блоков %u, использовано %u КБ\n",
+                blockCount(), (unsigned)(LittleFS.usedBytes() / 1024));
+  return true;
+}
+
+void HistoryStore::blockPath(uint32_t seq, char *out, size_t len) const {
+  snprintf(out, len, "%s/%08lu", HIST_DIR, (unsigned long)seq);
+}
+
+void HistoryStore::startBlock() {
+  lastSeq++;
+  while (lastSeq - firstSeq + 1 > MAX_BLOCKS) {
+    char path[24];
+    blockPath(firstSeq, path, sizeof(path));
+    LittleFS.remove(path);
+    firstSeq++;
+  }
+  curSize = 0;
+  needKey = true;
+  blockStart[lastSeq % MAX_BLOCKS] = 0;
+}
+
+bool HistoryStore::appendRecord(const uint8_t *data, size_t len) {
+  char path[24];
+  blockPath(lastSeq, path, sizeof(path));
+  File f = LittleFS.open(path, FILE_APPEND);
+  if (!f) return false;
+  size_t n = f.write(data, len);
+  f.close();
+  curSize += n;
+  return n == len;
+}
+
+// ===== Запись =====
+size_t HistoryStore::encode(uint32_t t, uint16_t state, const int32_t *vals, uint8_t *out) {
+  uint8_t *p = out + 1;
+  uint8_t  flags;
+
+  if (needKey) {
+    flags = FLAG_KEY;
+    *p++ = (uint8_t)(t);
+    *p++ = (uint8_t)(t >> 8);
+    *p++ = (uint8_t)(t >> 16);
+    *p++ = (uint8_t)(t >> 24);
+    p = putVarint(p, state);
+    for (uint8_t i = 0; i < CHANNELS; ++i) p = putVarint(p, zigzag(vals[i]));
+  } else {
+    flags = 0;
+    uint32_t dt = t - lastTime;
+    if (dt != NOMINAL_DT) {
+      flags |= FLAG_TIME;
+      p = putVarint(p, dt);
+    }
+    if (state != lastState) {
+      flags |= FLAG_STATE;
+      p = putVarint(p, state);
+    }
+    for (uint8_t i = 0; i < CHANNELS; ++i) {
+      int32_t d = vals[i] - lastVals[i];
+      if (d != 0) {
+        flags |= (uint8_t)(1U << i);
+        p = putVarint(p, zigzag(d));
+      }
+    }
+  }
+
+  out[0] = flags;
+  return (size_t)(p - out);
+}
+
+void HistoryStore::record(const SensorData &sd) {
+  if (!ready) return;
+
+  time_t now = time(nullptr);
+  if (now < MIN_VALID_TIME) return;
+
+  Sample s;
+  s.t     = (uint32_t)now;
+  s.state = (sd.pumpOn  ? 0x01 : 0) | (sd.fanOn    ? 0x02 : 0) |
+            (sd.lightOn ? 0x04 : 0) | (sd.doorOpen ? 0x08 : 0);
+  for (uint8_t i = 0; i < CHANNELS; ++i) {
+    float v = Channels::value(sd, i);
+    if (isnan(v)) {
+      s.vals[i] = INT32_MIN;          // нет данных — подставит write()
+    } else {
+      s.vals[i] = (int32_t)lroundf(v * SCALE[i]);
+      s.state  |= (uint16_t)(1U << (4 + i));
+    }
+  }
+
+  if (xQueueSend(queue, &s, 0) != pdTRUE) droppedSamples++;
+}
+
+void HistoryStore::writerLoop() {
+  if (!queue) {                         // begin() не удался — писать некуда
+    vTaskDelete(nullptr);
+    return;
+  }
+  Sample s;
+  for (;;) {
+    if (xQueueReceive(queue, &s, portMAX_DELAY) != pdTRUE) continue;
+    StoreGuard guard(lock);
+    write(s);
+  }
+}
+
+// Под мьютексом журнала
+void HistoryStore::write(const Sample &s) {
+  uint32_t t     = s.t;
+  uint16_t state = s.state;
+  int32_t  vals[CHANNELS];
+  for (uint8_t i = 0; i < CHANNELS; ++i) {
+    // Нет данных — дельта 0, бит валидности снят
+    vals[i] = (state & (1U << (4 + i))) ? s.vals[i] : lastVals[i];
+  }
+
+  // Время пошло назад (пересинхронизация NTP) — новый блок с ключевой записью
+  if (!needKey && t <= lastTime) needKey = true;
+
+  if (needKey || curSize + MAX_RECORD > BLOCK_SIZE) {
+    startBlock();
+  }
+
+  bool    key = needKey;
+  uint8_t buf[MAX_RECORD];
+  size_t  len = encode(t, state, vals, buf);
+  if (!appendRecord(buf, len)) {
+    Serial.println(F("⚠️ History: ошибка записи"));
+    needKey = true;
+    return;
+  }
+
+  if (key) blockStart[lastSeq % MAX_BLOCKS] = t;
+  needKey   = false;
+  lastTime  = t;
+  lastState = state;
+  memcpy(lastVals, vals, sizeof(lastVals));
+}
+
+// ===== Чтение =====
+uint32_t HistoryStore::oldestTime() {
+  if (!ready) return 0;
+  StoreGuard guard(lock);
+  return lastSeq >= firstSeq ? blockStart[firstSeq % MAX_BLOCKS] : 0;
+}
+
+uint16_t HistoryStore::blockCount() {
+  if (!ready) return 0;
+  StoreGuard guard(lock);
+  return (uint16_t)(lastSeq - firstSeq + 1);
+}
+
+uint32_t HistoryStore::query(uint32_t from, uint32_t to, uint32_t step,
+                             PointFn fn, void *ctx) {
+  if (!ready || from > to) return 0;
+  if (step < NOMINAL_DT) step = NOMINAL_DT;
+
+  // Мьютекс — на один вызов: /api/history читает порциями по
+  // HISTORY_POINTS_PER_CHUNK, запись ждёт не дольше чтения нескольких блоков
+  StoreGuard guard(lock);
+
+  // Накопитель текущего интервала
+  Point    pt;
+  float    sum[CHANNELS];
+  uint16_t cnt[CHANNELS];
+  uint32_t bucket  = 0;
+  uint32_t emitted = 0;
+  pt.samples = 0;
+
+  auto flush = [&]() {
+    if (pt.samples == 0) return;
+    pt.t = bucket;
+    for (uint8_t i = 0; i < CHANNELS; ++i) {
+      pt.valid[i] = cnt[i] > 0;
+      pt.v[i]     = cnt[i] ? sum[i] / cnt[i] / SCALE[i] : 0.0f;
+    }
+    fn(pt, ctx);
+    emitted++;
+    pt.samples = 0;
+  };
+
+  char path[24];
+  for (uint32_t seq = firstSeq; seq <= lastSeq; ++seq) {
+    // Весь блок раньше from — если следующий начинается не позже from
+    if (seq < lastSeq) {
+      uint32_t nextStart = blockStart[(seq + 1) % MAX_BLOCKS];
+      if (nextStart != 0 && nextStart <= from) continue;
+    }
+
+    blockPath(seq, path, sizeof(path));
+    File f = LittleFS.open(path, FILE_READ);
+    if (!f) continue;
+    size_t n = f.read(readBuf, sizeof(readBuf));
+    f.close();
+
+    const uint8_t *p   = readBuf;
+    const uint8_t *end = readBuf + n;
+
+    uint32_t t = 0;
+    uint32_t state = 0;
+    int32_t  vals[CHANNELS] = {0};
+
+    while (p < end) {
+      uint8_t  flags = *p++;
+      uint32_t v;
+
+      if (flags & FLAG_KEY) {
+        if (end - p < 4) break;
+        t = p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+        p += 4;
+        if (!getVarint(p, end, state)) break;
+        bool ok = true;
+        for (uint8_t i = 0; i < CHANNELS && ok; ++i) {
+          ok = getVarint(p, end, v);
+          vals[i] = unzigzag(v);
+        }
+        if (!ok) break;
+      } else {
+        uint32_t dt = NOMINAL_DT;
+        if ((flags & FLAG_TIME)  && !getVarint(p, end, dt))    break;
+        if ((flags & FLAG_STATE) && !getVarint(p, end, state)) break;
+        t += dt;
+        bool ok = true;
+        for (uint8_t i = 0; i < CHANNELS && ok; ++i) {
+          if (!(flags & (1U << i))) continue;
+          ok = getVarint(p, end, v);
+          vals[i] += unzigzag(v);
+        }
+        if (!ok) break;   // запись оборвана (питание пропало посреди записи)
+      }
+
+      if (t < from) continue;
+      if (t > to) {
+        flush();
+        return emitted;
+      }
+
+      uint32_t b = from + ((t - from) / step) * step;
+      if (pt.samples == 0 || b != bucket) {
+        flush();
+        bucket       = b;
+        pt.actuators = 0;
+        for (uint8_t i = 0; i < CHANNELS; ++i) {
+          sum[i] = 0.0f;
+          cnt[i] = 0;
+        }
+      }
+
+      pt.samples++;
+      pt.actuators |= (uint8_t)(state & 0x0F);
+      for (uint8_t i = 0; i < CHANNELS; ++i) {
+        if (state & (1U << (4 + i))) {
+          sum[i] += (float)vals[i];
+          cnt[i]++;
+        }
+      }
+    }
+  }
+
+  flush();
+  return emitted;
+}
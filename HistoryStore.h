@@ -0,0 +1,100 @@
+// HistoryStore.h
+#ifndef HISTORY_STORE_H
+#define HISTORY_STORE_H
+
+#include "Config.h"
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/semphr.h>
+
+// Журнал показаний в LittleFS: только дописывание, блоки по BLOCK_SIZE
+// (по одному файлу на блок, выровнено по странице флеша).
+//
+// Формат записи:
+//   байт флагов: бит i (0..4) — есть дельта канала i,
+//                бит 5 — изменилось слово состояния (исполнители + валидность),
+//                бит 6 — шаг времени отличен от номинального;
+//   далее varint-поля: шаг времени, состояние, zigzag-дельты каналов.
+// Первая запись блока — ключевая (бит 7): абсолютное время uint32 LE,
+// состояние и абсолютные значения, поэтому каждый блок декодируется
+// независимо. Значения — целые: T/H/P/почва ×10, lux ×1.
+//
+// Флеш трогает только задача history (writerLoop): задача управления
+// кладёт готовый снимок в очередь и ControlLock на время записи не держит.
+// Запись и чтение (query из async_tcp) разделяет мьютекс журнала.
+class HistoryStore {
+public:
+  static constexpr uint8_t  CHANNELS    = Channels::COUNT;
+  static constexpr size_t   BLOCK_SIZE  = 4096;
+  static constexpr uint16_t MAX_BLOCKS  = 96;   // ~384 КБ, > 30 суток по минуте
+  static constexpr uint8_t  QUEUE_DEPTH = 8;    // минут, если запись отстала
+
+  // Точка после прореживания (среднее по интервалу step)
+  struct Point {
+    uint32_t t;
+    float    v[CHANNELS];
+    bool     valid[CHANNELS];
+    uint8_t  actuators;      // биты: насос, вентилятор, свет, дверь — «было включено»
+    uint16_t samples;
+  };
+  typedef void (*PointFn)(const Point &p, void *ctx);
+
+  bool begin();
+
+  // Задача управления, раз в HISTORY_INTERVAL_MS: снимок в очередь, без ожидания
+  void record(const SensorData &sd);
+
+  // Задача history: дописывает снимки из очереди, не возвращается
+  void writerLoop();
+
+  // Потоковое чтение диапазона [from, to] (unix-секунды) с шагом step;
+  // возвращает число выданных точек
+  uint32_t query(uint32_t from, uint32_t to, uint32_t step,
+                 PointFn fn, void *ctx);
+
+  // Время первой записи журнала (0 — журнал пуст)
+  uint32_t oldestTime();
+  uint16_t blockCount();
+
+  uint32_t dropped() const { return droppedSamples; }
+
+private:
+  // Снимок, уже приведённый к целым журнала
+  struct Sample {
+    uint32_t t;
+    uint16_t state;
+    int32_t  vals[CHANNELS];
+  };
+
+  QueueHandle_t     queue          = nullptr;
+  SemaphoreHandle_t lock           = nullptr;
+  volatile uint32_t droppedSamples = 0;
+
+  bool     ready    = false;
+  uint32_t firstSeq = 0;
+  uint32_t lastSeq  = 0;
+  size_t   curSize  = 0;
+  bool     needKey  = true;
+
+  // Состояние кодировщика
+  uint32_t lastTime = 0;
+  uint16_t lastState = 0;
+  int32_t  lastVals[CHANNELS] = {0};
+
+  // Время начала каждого блока (индекс seq % MAX_BLOCKS, 0 — неизвестно):
+  // query() пропускает ранние блоки, не открывая файлы
+  uint32_t blockStart[MAX_BLOCKS] = {0};
+
+  // Буфер чтения одного блока (под мьютексом журнала)
+  uint8_t readBuf[BLOCK_SIZE];
+
+  void   write(const Sample &s);
+  void   blockPath(uint32_t seq, char *out, size_t len) const;
+  void   startBlock();
+  bool   appendRecord(const uint8_t *data, size_t len);
+  size_t encode(uint32_t t, uint16_t state, const int32_t *vals, uint8_t *out);
+};
+
+extern HistoryStore g_history;
+
+#endif // HISTORY_STORE_H
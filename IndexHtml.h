@@ -0,0 +1,349 @@
+// IndexHtml.h
+// Сгенерировано tools/embed_index.py из web/index.html — не редактировать вручную.
+#ifndef INDEX_HTML_H
+#define INDEX_HTML_H
+
+#include <Arduino.h>
+
+static constexpr size_t INDEX_HTML_RAW_LEN = 19093;
+static constexpr size_t INDEX_HTML_GZ_LEN  = 5332;
+static const char INDEX_HTML_ETAG[] = "\"01e169db7aa9a51a\"";
+
+static const uint8_t INDEX_HTML_GZ[] PROGMEM = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xbd, 0x3c, 0x6b, 0x8f, 0x1b, 0xc7,
+  0x91, 0xdf, 0xfd, 0x2b, 0x5a, 0xd4, 0x29, 0xe4, 0x40, 0xe4, 0x2c, 0xc9, 0x25, 0x57, 0x2b, 0xee,
+  0x23, 0xb0, 0xe5, 0x15, 0xe4, 0x40, 0x92, 0x05, 0xec, 0x06, 0x86, 0xe1, 0x18, 0x97, 0x5e, 0x4e,
+  0x93, 0x1c, 0xed, 0x70, 0x86, 0x99, 0x19, 0xee, 0x23, 0x9b, 0x05, 0xf4, 0x80, 0x4f, 0x0e, 0x6c,
+  0x9c, 0x12, 0x9d, 0x81, 0xf3, 0x25, 0x38, 0xdb, 0xb1, 0x3f, 0xe6, 0x0e, 0x58, 0xc9, 0xda, 0x68,
+  0x23, 0x4b, 0x2b, 0xc0, 0x3f, 0xe0, 0x30, 0xfc, 0x0b, 0xf9, 0x05, 0xf9, 0x09, 0x57, 0xd5, 0xdd,
+  0x33, 0xd3, 0xf3, 0x20, 0x97, 0xfb, 0x48, 0x2c, 0x8b, 0x9c, 0xe9, 0xe9, 0xae, 0xae, 0x77, 0x55,
+  0x57, 0x0d, 0xb5, 0x78, 0xe1, 0xdd, 0xf7, 0xaf, 0xad, 0x7d, 0x78, 0x67, 0x85, 0xf4, 0xfc, 0xbe,
+  0xb5, 0xfc, 0xd6, 0x22, 0x7e, 0x11, 0x8b, 0xda, 0xdd, 0xa5, 0x82, 0x3b, 0x2c, 0xe0, 0x00, 0xa3,
+  0x06, 0x7c, 0xf5, 0x99, 0x4f, 0x49, 0xbb, 0x47, 0x5d, 0x8f, 0xf9, 0x4b, 0x85, 0x9f, 0xaf, 0x5d,
+  0xaf, 0xcc, 0xe3, 0x53, 0xdf, 0xf4, 0x2d, 0xb6, 0x1c, 0xfc, 0x57, 0x70, 0x14, 0x7c, 0x1b, 0x1c,
+  0x06, 0x2f, 0xc9, 0xad, 0x3a, 0xf9, 0xdb, 0xbd, 0x2f, 0x48, 0xf0, 0x5d, 0xf0, 0x2a, 0x78, 0x1d,
+  0xec, 0x8f, 0x1e, 0x93, 0xd1, 0x83, 0xe0, 0x20, 0x78, 0x13, 0xfc, 0x10, 0x1c, 0x8e, 0xfe, 0x2d,
+  0xd8, 0x5f, 0x9c, 0x11, 0x4b, 0x24, 0x44, 0x9b, 0xf6, 0xd9, 0x52, 0x61, 0xd3, 0x64, 0x5b, 0x03,
+  0xc7, 0xf5, 0x0b, 0xa4, 0xed, 0xd8, 0x3e, 0xb3, 0x61, 0x87, 0x2d, 0xd3, 0xf0, 0x7b, 0x4b, 0x06,
+  0xdb, 0x34, 0xdb, 0xac, 0xc2, 0x6f, 0xca, 0xc4, 0xb4, 0x4d, 0xdf, 0xa4, 0x56, 0xc5, 0x6b, 0x53,
+  0x8b, 0x2d, 0xd5, 0xf4, 0x2a, 0x62, 0xe0, 0xf9, 0x3b, 0x08, 0x8e, 0x90, 0x96, 0xeb, 0x38, 0x3e,
+  0xd9, 0x85, 0x2b, 0x42, 0x3a, 0x00, 0xa6, 0xd2, 0xa1, 0x7d, 0xd3, 0xda, 0x69, 0x11, 0x6f, 0xc7,
+  0xf3, 0x59, 0xbf, 0x32, 0x34, 0xcb, 0xa4, 0x42, 0x07, 0x03, 0x8b, 0x55, 0xc4, 0x48, 0x99, 0xbc,
+  0x63, 0x99, 0xf6, 0xc6, 0x2d, 0xda, 0x5e, 0xe5, 0xf7, 0xd7, 0x61, 0x51, 0x99, 0x14, 0x56, 0x59,
+  0xd7, 0x61, 0xe4, 0xe7, 0xef, 0x15, 0xca, 0xc4, 0xa3, 0xb6, 0x57, 0xf1, 0x98, 0x6b, 0x76, 0x16,
+  0x38, 0xd8, 0xb6, 0x63, 0x39, 0x2e, 0x6c, 0xdf, 0x63, 0x7d, 0xd6, 0x22, 0x06, 0x75, 0x37, 0x70,
+  0x7c, 0x0f, 0xfe, 0xae, 0x3b, 0xc6, 0x8e, 0xdc, 0xbb, 0x4f, 0xdd, 0xae, 0x69, 0xb7, 0x48, 0x55,
+  0xac, 0x19, 0x50, 0xc3, 0x30, 0xed, 0x6e, 0x74, 0xdf, 0x37, 0xed, 0x4a, 0x8f, 0x99, 0xdd, 0x9e,
+  0xdf, 0x22, 0xb5, 0x6a, 0x75, 0xb3, 0x27, 0x86, 0xd7, 0x69, 0x7b, 0xa3, 0xeb, 0x3a, 0x43, 0xdb,
+  0x68, 0x11, 0x97, 0x1a, 0x48, 0x66, 0x17, 0xbf, 0x81, 0x19, 0xa5, 0xb6, 0xe9, 0xb6, 0x2d, 0x46,
+  0xa8, 0x4f, 0x7c, 0x67, 0x50, 0x26, 0x17, 0xeb, 0xed, 0x59, 0xd6, 0xac, 0xc2, 0x45, 0x75, 0xbd,
+  0x56, 0xad, 0x57, 0x35, 0x05, 0xb9, 0x16, 0xb9, 0xd8, 0x69, 0xe2, 0x1f, 0x31, 0x66, 0x98, 0xde,
+  0xc0, 0xa2, 0xc0, 0x83, 0x8e, 0xc5, 0xb6, 0xc5, 0xd0, 0xdd, 0xa1, 0xe7, 0x9b, 0x9d, 0x9d, 0x8a,
+  0xe4, 0x74, 0x8b, 0xb4, 0xe1, 0x93, 0xb9, 0xe2, 0x21, 0xb5, 0xcc, 0xae, 0x5d, 0x31, 0x81, 0x19,
+  0x9e, 0x58, 0x53, 0xf1, 0x7c, 0xea, 0xfa, 0x21, 0x95, 0x3a, 0x2e, 0xa2, 0xa6, 0xcd, 0x5c, 0x49,
+  0x2b, 0x17, 0x0c, 0xa7, 0xe3, 0x92, 0xa4, 0x8e, 0x6e, 0x57, 0xa2, 0xc1, 0xf9, 0xea, 0x60, 0x3b,
+  0xc5, 0x84, 0x7a, 0x63, 0xb0, 0x4d, 0x6a, 0x73, 0xf0, 0xd1, 0x90, 0x0f, 0x39, 0x5c, 0x54, 0xb2,
+  0x08, 0xe8, 0x34, 0x48, 0x7b, 0x03, 0x0a, 0x7a, 0xb1, 0xce, 0xfc, 0x2d, 0xc6, 0xec, 0x1c, 0xdc,
+  0x55, 0xa2, 0x84, 0x40, 0x2a, 0xeb, 0x8e, 0xef, 0x3b, 0xfd, 0x16, 0xdf, 0x5d, 0x3c, 0xe8, 0xd2,
+  0x01, 0xdc, 0xd6, 0x15, 0x3c, 0xb8, 0x6e, 0xaa, 0x3a, 0xe4, 0x99, 0xbf, 0x06, 0x49, 0xd7, 0xf4,
+  0x39, 0x97, 0xf5, 0x17, 0xe2, 0xe1, 0x2d, 0x29, 0xc0, 0x2b, 0xd5, 0xea, 0x58, 0x46, 0x8f, 0xc5,
+  0x87, 0x6f, 0x3b, 0x9f, 0xd9, 0x15, 0x48, 0xb2, 0x75, 0xcb, 0xe9, 0x3a, 0x69, 0x36, 0x98, 0x36,
+  0xa8, 0x29, 0xab, 0xc4, 0x90, 0x25, 0x83, 0x67, 0xeb, 0x21, 0x21, 0xa1, 0x3e, 0xc5, 0x23, 0xeb,
+  0x8e, 0x0b, 0x0c, 0xad, 0xa0, 0x06, 0x0d, 0xbd, 0x98, 0xc8, 0xa4, 0x9e, 0x21, 0x58, 0xea, 0xc6,
+  0x7a, 0x56, 0x9b, 0x6d, 0x1a, 0xac, 0x8b, 0x0a, 0x76, 0x85, 0xb2, 0x39, 0x54, 0xb0, 0x79, 0xd6,
+  0x68, 0x50, 0x43, 0x3b, 0x86, 0xa0, 0x89, 0x2a, 0x95, 0x60, 0x63, 0x4d, 0xb2, 0x91, 0x93, 0xbd,
+  0x4e, 0x8d, 0x6e, 0xc8, 0xec, 0x48, 0x41, 0xb8, 0x7e, 0x54, 0xc7, 0x90, 0x71, 0xf5, 0xea, 0xd5,
+  0x3c, 0x3a, 0xdc, 0xee, 0x3a, 0x2d, 0xd5, 0x9b, 0xcd, 0x72, 0xf8, 0xb7, 0xaa, 0x57, 0x9b, 0x5a,
+  0x66, 0xfb, 0xaa, 0x7e, 0xa5, 0x19, 0x89, 0x51, 0x40, 0x06, 0x9c, 0x60, 0x3f, 0xcf, 0xb1, 0x4c,
+  0x23, 0x17, 0xca, 0xbc, 0x16, 0x61, 0xdb, 0x75, 0x61, 0x4e, 0x4a, 0x32, 0x38, 0x26, 0x65, 0x0a,
+  0x57, 0x15, 0xe0, 0x0c, 0x8c, 0xfb, 0x0c, 0x18, 0x61, 0x0d, 0xfb, 0x36, 0x20, 0xec, 0xb2, 0x01,
+  0xa3, 0x7e, 0x89, 0x0e, 0x7d, 0xa7, 0xd2, 0x31, 0xc1, 0xbb, 0x80, 0xf5, 0x83, 0x89, 0x94, 0xea,
+  0x73, 0x40, 0x62, 0x99, 0xd4, 0x3a, 0xae, 0xa6, 0xa9, 0xba, 0x38, 0xa7, 0x68, 0x45, 0x9b, 0xba,
+  0xe1, 0x86, 0x19, 0x62, 0x6b, 0x57, 0xca, 0xf5, 0x46, 0x79, 0xf6, 0x2a, 0xe0, 0x78, 0x55, 0xcb,
+  0x97, 0xf8, 0x7c, 0xc6, 0xf6, 0xb8, 0xd9, 0xc5, 0xe3, 0xeb, 0x0e, 0x58, 0x77, 0x8f, 0x1a, 0xce,
+  0x16, 0xb0, 0x86, 0x8f, 0x93, 0x46, 0x13, 0x3e, 0xf8, 0x06, 0xd5, 0x32, 0xff, 0xa3, 0x37, 0x9a,
+  0xda, 0x49, 0xf8, 0xd5, 0xd0, 0x62, 0xe9, 0x18, 0xae, 0x33, 0x00, 0xa2, 0x2d, 0x1f, 0x97, 0xad,
+  0x5b, 0x43, 0xb7, 0x84, 0x7b, 0x68, 0x49, 0xfa, 0x7a, 0xb3, 0x69, 0xaf, 0x89, 0xb8, 0x44, 0xf2,
+  0x4f, 0x28, 0x4f, 0xb5, 0x99, 0x6f, 0x84, 0x73, 0xc2, 0x08, 0x39, 0x50, 0x08, 0x2a, 0xae, 0xd9,
+  0xf6, 0x4e, 0x2b, 0xa8, 0x7a, 0x24, 0xa1, 0x6a, 0x39, 0x23, 0x1c, 0xd5, 0x61, 0x89, 0x7d, 0xd2,
+  0xca, 0x3b, 0x3f, 0x49, 0x79, 0xf3, 0x6d, 0x30, 0x8f, 0x8b, 0xf5, 0x13, 0xf1, 0x7c, 0x2e, 0x4f,
+  0xd3, 0xe7, 0xe7, 0x55, 0x4b, 0x93, 0xd8, 0xea, 0x16, 0x5d, 0x67, 0x96, 0x44, 0xda, 0x01, 0x0f,
+  0x6a, 0xfa, 0x3b, 0xc2, 0x2c, 0xf2, 0x6c, 0x25, 0x17, 0xc2, 0x26, 0xb5, 0x86, 0x79, 0x0e, 0x72,
+  0x5a, 0xc9, 0x84, 0x10, 0xbc, 0x3e, 0xb5, 0xf2, 0x30, 0xc9, 0x01, 0xd2, 0x08, 0x7d, 0xac, 0xf4,
+  0xe3, 0x16, 0xeb, 0xf8, 0xdc, 0x4f, 0xa4, 0x40, 0xeb, 0xce, 0x06, 0xce, 0xda, 0x0d, 0xf9, 0x2e,
+  0xe3, 0x21, 0x67, 0x59, 0x13, 0x04, 0x5b, 0xaf, 0xd5, 0xc0, 0xe2, 0x9a, 0xb3, 0xc0, 0xb3, 0x2b,
+  0xda, 0x42, 0x62, 0xe5, 0x16, 0x75, 0xed, 0x31, 0x2b, 0xeb, 0x18, 0x68, 0xeb, 0xd5, 0x06, 0xae,
+  0xcf, 0x59, 0x49, 0x2d, 0xea, 0xf6, 0xc7, 0xac, 0x6c, 0xcc, 0xc3, 0x7e, 0xb5, 0x59, 0xf1, 0x01,
+  0x22, 0xe1, 0x4b, 0xc3, 0x28, 0xea, 0x3a, 0x18, 0xe0, 0x9d, 0xe1, 0x60, 0x7c, 0xd0, 0xe3, 0xf1,
+  0x77, 0xcb, 0x45, 0xdd, 0xc3, 0xcf, 0x6c, 0xf0, 0xc8, 0x86, 0xb6, 0x48, 0xf7, 0xc6, 0xf8, 0xea,
+  0xbd, 0xec, 0xf6, 0x18, 0x76, 0xb2, 0x02, 0x05, 0x74, 0x63, 0x6b, 0xcb, 0x51, 0x15, 0xcc, 0x62,
+  0x64, 0x18, 0x9a, 0x57, 0xec, 0x62, 0x7d, 0x08, 0x88, 0x84, 0xe0, 0x26, 0x38, 0x6f, 0xa9, 0xd8,
+  0xb6, 0x63, 0xb3, 0x94, 0x93, 0xba, 0x82, 0x26, 0xd4, 0xc8, 0xb1, 0xff, 0x04, 0x46, 0x09, 0x05,
+  0x69, 0x86, 0x0a, 0xd2, 0x1e, 0xba, 0x1e, 0xb2, 0x7f, 0xe0, 0x98, 0x71, 0xfc, 0x39, 0xce, 0xd8,
+  0xe6, 0x26, 0xa4, 0x4f, 0xbe, 0x0b, 0x09, 0x20, 0xe4, 0x9c, 0x0e, 0x38, 0x26, 0x7e, 0xdd, 0x71,
+  0x40, 0xda, 0x18, 0x17, 0x3c, 0xc2, 0xa8, 0xc7, 0xca, 0x8a, 0x13, 0x85, 0xe1, 0x5a, 0x3d, 0x1a,
+  0x8e, 0x36, 0x55, 0x86, 0x93, 0x4c, 0xd2, 0x07, 0xae, 0x09, 0xe2, 0xdb, 0xc9, 0x71, 0xf1, 0x63,
+  0xe2, 0xf2, 0xc5, 0x7a, 0xbd, 0xdd, 0x6c, 0xb2, 0xf2, 0xc5, 0xda, 0x1c, 0x9d, 0x6d, 0x50, 0x2d,
+  0x05, 0xcf, 0x80, 0xa4, 0x3d, 0xca, 0xa1, 0xa6, 0x01, 0xc7, 0x3a, 0x0d, 0xf8, 0xaf, 0x7c, 0x71,
+  0xfd, 0x6a, 0xad, 0x5d, 0x6b, 0xa7, 0xc1, 0x39, 0x43, 0x1f, 0x17, 0xe6, 0xc0, 0xe3, 0x9c, 0x18,
+  0x50, 0x17, 0x60, 0x9d, 0xc0, 0x4f, 0xd5, 0xea, 0xa9, 0x1d, 0x5a, 0x3d, 0x67, 0x33, 0xc2, 0x37,
+  0xe2, 0xae, 0x04, 0x8f, 0xde, 0xf9, 0xc3, 0x52, 0xa5, 0x26, 0x03, 0x46, 0x26, 0x5a, 0x81, 0xce,
+  0x91, 0x7a, 0x26, 0x5a, 0xd5, 0x9b, 0xe9, 0x3d, 0x68, 0xdb, 0x37, 0x37, 0xd9, 0xc4, 0x4d, 0xaa,
+  0x39, 0x3b, 0x84, 0x8a, 0xc9, 0xed, 0x15, 0x57, 0xe8, 0x70, 0xec, 0xf1, 0x41, 0x41, 0xbd, 0x0a,
+  0x57, 0x81, 0x53, 0x87, 0x97, 0x63, 0xa3, 0xcb, 0x58, 0x9b, 0xe6, 0xa6, 0xdb, 0x31, 0x99, 0x65,
+  0x1c, 0xe3, 0x31, 0x0c, 0xd3, 0x65, 0x6d, 0xa1, 0xb3, 0x62, 0x7f, 0x65, 0x97, 0x7a, 0x06, 0x96,
+  0x1a, 0x12, 0x92, 0xfe, 0x7f, 0x2e, 0xcf, 0xfe, 0xe7, 0x53, 0xcb, 0x4d, 0x7b, 0x30, 0x84, 0xb4,
+  0x46, 0xde, 0x79, 0xcc, 0x82, 0xad, 0xf3, 0xcd, 0x3f, 0x1d, 0x17, 0xa7, 0x4b, 0xbd, 0xf2, 0x72,
+  0x1f, 0x98, 0x32, 0x5b, 0x6e, 0xd4, 0x95, 0xdc, 0x27, 0xcf, 0x76, 0x93, 0xae, 0x23, 0x26, 0x26,
+  0xf2, 0x34, 0x98, 0x0d, 0x5d, 0x55, 0xf9, 0x01, 0xc7, 0xc7, 0x48, 0x1f, 0xa5, 0x10, 0xe0, 0xbc,
+  0xa5, 0xa6, 0x52, 0xe3, 0x92, 0x49, 0x85, 0x41, 0x73, 0x0b, 0x67, 0x39, 0xc3, 0x24, 0xbd, 0x7b,
+  0x4e, 0x00, 0x10, 0x0e, 0xbc, 0x67, 0x0e, 0xd2, 0xa9, 0xc7, 0x2c, 0x50, 0x33, 0x3f, 0x45, 0xda,
+  0x9c, 0xcf, 0xfb, 0x1a, 0xc4, 0xaa, 0xda, 0xdc, 0x6c, 0xb9, 0x36, 0xdf, 0x10, 0x41, 0x2e, 0x87,
+  0x5c, 0x35, 0x1d, 0x80, 0x53, 0xa1, 0x3f, 0xf4, 0x2a, 0x46, 0x74, 0xe0, 0x8e, 0xce, 0x7c, 0xe9,
+  0x23, 0xc9, 0x49, 0x73, 0x79, 0xe9, 0xe4, 0x12, 0xa6, 0xe0, 0xca, 0x6c, 0x42, 0x11, 0x96, 0x44,
+  0xc0, 0x05, 0xbf, 0xbb, 0x7b, 0xba, 0x03, 0xd8, 0x5c, 0x7e, 0x8c, 0x51, 0xa9, 0xdc, 0x32, 0x3b,
+  0x66, 0xc5, 0x06, 0xad, 0xc8, 0xb5, 0x8f, 0xc9, 0xf1, 0x51, 0xd1, 0x9f, 0x28, 0x55, 0x59, 0x9c,
+  0x91, 0xc5, 0x8a, 0xc5, 0x19, 0x59, 0x55, 0xc1, 0xb2, 0x01, 0x7c, 0x19, 0xe6, 0x26, 0x69, 0x5b,
+  0xd4, 0xf3, 0x96, 0x0a, 0xd1, 0x09, 0xbb, 0x80, 0x35, 0x0d, 0xf5, 0x89, 0x38, 0x23, 0xf3, 0xe1,
+  0xe4, 0x03, 0x7e, 0x7c, 0x94, 0xe3, 0xf0, 0x84, 0x07, 0x74, 0xf9, 0x08, 0x8f, 0x93, 0x85, 0xe5,
+  0xbf, 0x7f, 0xfd, 0xf9, 0x53, 0xd8, 0x1b, 0xc6, 0x13, 0x93, 0x4e, 0x56, 0xb6, 0x89, 0x97, 0x2f,
+  0xce, 0xc0, 0xe6, 0x59, 0x34, 0xf8, 0x71, 0xae, 0xb0, 0x1c, 0x3c, 0x81, 0x75, 0x4f, 0x2b, 0xb0,
+  0x74, 0x1f, 0x20, 0x1d, 0x04, 0x3f, 0x8c, 0x3e, 0x27, 0x3f, 0xbe, 0x20, 0x9b, 0x75, 0xbd, 0x16,
+  0x2d, 0x94, 0x17, 0x29, 0x02, 0xd1, 0x77, 0x86, 0xe4, 0x5d, 0xa8, 0x54, 0x48, 0xf0, 0xa7, 0xe0,
+  0x68, 0x74, 0x1f, 0xf0, 0x38, 0x1a, 0x3d, 0x06, 0x50, 0x87, 0xc1, 0x01, 0xa9, 0x54, 0xb2, 0xfb,
+  0xe2, 0x39, 0x22, 0xa6, 0xbe, 0x37, 0xbb, 0x0c, 0x24, 0x1d, 0x04, 0x2f, 0x47, 0x0f, 0x47, 0xbf,
+  0x85, 0xef, 0x03, 0x32, 0xba, 0x9f, 0x06, 0x03, 0xec, 0x9f, 0x8d, 0x16, 0x28, 0x90, 0xe4, 0xe1,
+  0xa1, 0x40, 0x4c, 0x23, 0xbe, 0x09, 0x27, 0xe6, 0x4d, 0x95, 0x33, 0x2b, 0xd4, 0x74, 0xd7, 0x94,
+  0x89, 0xc9, 0xa9, 0xdc, 0xc3, 0x16, 0x04, 0x56, 0xaf, 0x80, 0x2d, 0x07, 0xa3, 0x7b, 0xc0, 0xe0,
+  0x07, 0x80, 0x1f, 0x7c, 0x93, 0xe0, 0x19, 0xc8, 0xe0, 0x45, 0xf0, 0x1c, 0x6e, 0x3f, 0x41, 0x36,
+  0x47, 0xac, 0xcd, 0x02, 0xe2, 0x99, 0x73, 0x61, 0xb9, 0x52, 0x59, 0xe4, 0xd9, 0xf3, 0xf2, 0x8f,
+  0xfb, 0xd7, 0x40, 0x2c, 0xfc, 0x32, 0xb5, 0x2e, 0x7d, 0x3b, 0x09, 0xf1, 0x1b, 0xc7, 0x22, 0xfe,
+  0x04, 0x94, 0x60, 0x3f, 0xf8, 0x0b, 0xf0, 0x8e, 0xf3, 0x11, 0xe4, 0x79, 0x06, 0xa4, 0x2f, 0x9d,
+  0x15, 0x65, 0xcf, 0x31, 0xad, 0x0f, 0x4e, 0x83, 0xf3, 0x1b, 0xb8, 0x7c, 0x14, 0x3c, 0x1b, 0x7d,
+  0xf6, 0xcf, 0xc5, 0xd7, 0x1a, 0x6e, 0x1f, 0x8b, 0xed, 0x57, 0xa0, 0xa3, 0xcf, 0x40, 0x31, 0x7e,
+  0x3b, 0xfa, 0x3d, 0x60, 0x1c, 0xe1, 0x7c, 0x22, 0x44, 0x61, 0x9f, 0x69, 0x50, 0x55, 0x8d, 0x37,
+  0xb2, 0xc2, 0xd0, 0xe0, 0xbe, 0x0b, 0xde, 0xa0, 0x52, 0x02, 0x2e, 0x3f, 0x80, 0xb2, 0x9e, 0xc4,
+  0xe4, 0xbe, 0x01, 0x55, 0x78, 0x84, 0x98, 0xa3, 0xc1, 0x3d, 0xcc, 0x82, 0x19, 0x67, 0x72, 0x89,
+  0xb3, 0x88, 0x6a, 0x6b, 0xc2, 0x41, 0xfd, 0x37, 0x58, 0x0a, 0x37, 0xdf, 0xa4, 0xfb, 0x82, 0xe7,
+  0xf2, 0xa4, 0x21, 0xc1, 0xc8, 0x5c, 0xba, 0x40, 0x1c, 0xbb, 0x6d, 0x99, 0xed, 0x0d, 0x00, 0xec,
+  0xbb, 0x56, 0xa9, 0x38, 0x18, 0xf6, 0x07, 0xc5, 0x32, 0x7c, 0x59, 0x1e, 0x2b, 0x6a, 0xc0, 0xe9,
+  0x2f, 0xd1, 0x04, 0x01, 0x41, 0xf0, 0x4a, 0x08, 0x54, 0x40, 0x19, 0x0b, 0x56, 0xe6, 0xc0, 0xe3,
+  0xc0, 0x3a, 0x36, 0x87, 0xf9, 0x24, 0xf8, 0x43, 0xf0, 0xc7, 0x33, 0xc3, 0xea, 0x74, 0x24, 0xb0,
+  0x3f, 0xe7, 0x81, 0x4b, 0xca, 0x70, 0x7a, 0x06, 0xfe, 0x89, 0xeb, 0xd5, 0x83, 0x53, 0xb2, 0xcf,
+  0xc2, 0xc0, 0x7b, 0x5e, 0x84, 0x46, 0xc0, 0xfe, 0x31, 0x94, 0x62, 0xd8, 0x79, 0x0d, 0x5e, 0xfe,
+  0x10, 0x64, 0xfb, 0x18, 0x42, 0xd6, 0xe1, 0xe8, 0xf1, 0x29, 0xa9, 0xee, 0x50, 0xfb, 0xbc, 0x68,
+  0x96, 0xa0, 0xfe, 0x31, 0x14, 0x7f, 0xc1, 0x65, 0x7b, 0x0f, 0xfd, 0xc4, 0xa9, 0xe8, 0x34, 0x1c,
+  0xc7, 0x45, 0xec, 0x06, 0x4c, 0x90, 0xfa, 0x15, 0x84, 0xa8, 0x3f, 0x04, 0xdf, 0x00, 0x92, 0xdf,
+  0x06, 0xff, 0x73, 0x6a, 0x92, 0x25, 0xd4, 0x1e, 0xb5, 0x04, 0xd1, 0x5f, 0x03, 0xc4, 0x2f, 0xcf,
+  0x17, 0x76, 0xdb, 0x72, 0xa4, 0x39, 0xff, 0x67, 0xf0, 0xbb, 0xf1, 0x60, 0x4f, 0xcb, 0xd7, 0xdf,
+  0x41, 0x90, 0x80, 0x6c, 0x01, 0x3c, 0xc5, 0x3e, 0xd7, 0xa7, 0x97, 0xc9, 0xf4, 0xe7, 0x04, 0x1c,
+  0xc6, 0xba, 0xef, 0x79, 0xa9, 0x52, 0x08, 0x6b, 0x6a, 0x5d, 0xca, 0xba, 0x77, 0xee, 0x4d, 0x21,
+  0xb0, 0xdc, 0x03, 0xe2, 0xfe, 0x0a, 0x64, 0x1d, 0x4e, 0xe9, 0xdc, 0xb3, 0xeb, 0xe0, 0x03, 0x12,
+  0x43, 0xc9, 0x21, 0x48, 0x62, 0x0e, 0x79, 0x78, 0xe5, 0x63, 0xcf, 0x90, 0x5b, 0x8a, 0xb3, 0xe7,
+  0xe7, 0x65, 0x09, 0x3a, 0x71, 0x88, 0x16, 0x01, 0x32, 0x1c, 0xba, 0xce, 0x47, 0x1c, 0xdb, 0x1b,
+  0xae, 0xf7, 0x4d, 0x1f, 0xc6, 0xe9, 0x26, 0x5b, 0x95, 0xcf, 0x4a, 0xda, 0x82, 0xcb, 0xfc, 0xa1,
+  0x6b, 0x93, 0x0e, 0x05, 0x47, 0xbe, 0x30, 0x26, 0x27, 0xe3, 0x67, 0xd0, 0x64, 0xac, 0xe5, 0x01,
+  0x76, 0x79, 0x0d, 0xce, 0xe3, 0x04, 0x90, 0x3d, 0x0c, 0x5e, 0x2f, 0xce, 0x88, 0x21, 0x75, 0x12,
+  0x3f, 0xc3, 0x12, 0x7f, 0x67, 0xc0, 0x96, 0x0a, 0xf6, 0xb0, 0xbf, 0x0e, 0x49, 0x36, 0xf1, 0x7c,
+  0x36, 0x58, 0x2a, 0x54, 0xf5, 0x9a, 0xc0, 0xb2, 0xed, 0xf4, 0x01, 0x65, 0x1f, 0x01, 0xdd, 0x32,
+  0xed, 0xc2, 0x54, 0x69, 0xc0, 0xb1, 0xe8, 0xec, 0x43, 0x92, 0x7a, 0xff, 0x1c, 0x10, 0xa2, 0xdb,
+  0x67, 0x44, 0xe8, 0xc6, 0xb0, 0x7f, 0x2e, 0xec, 0x01, 0x38, 0x67, 0xe7, 0x8e, 0x44, 0xe6, 0x1c,
+  0x98, 0x83, 0xe8, 0x9c, 0x99, 0x37, 0xe0, 0xbf, 0x8e, 0xb8, 0xe2, 0x7f, 0xaf, 0x64, 0x90, 0xe4,
+  0xd2, 0xc9, 0x30, 0x93, 0x78, 0x61, 0xea, 0x7a, 0xcb, 0x31, 0x3d, 0x50, 0x65, 0xd4, 0x6d, 0x5e,
+  0xa6, 0x3c, 0x2b, 0x7a, 0xff, 0x01, 0x81, 0x0e, 0x0f, 0x37, 0x78, 0xaa, 0x38, 0x80, 0x9c, 0x1c,
+  0xee, 0xce, 0x17, 0xd1, 0x1b, 0xd8, 0x1b, 0x77, 0x99, 0x67, 0x7a, 0xe7, 0xc7, 0x49, 0x99, 0xee,
+  0xa2, 0xeb, 0xe0, 0x69, 0xeb, 0x29, 0x50, 0xe4, 0xd9, 0xc4, 0xcd, 0xe1, 0xf6, 0xd9, 0x15, 0x0e,
+  0x62, 0xd3, 0x4b, 0xcc, 0x5c, 0x13, 0x2e, 0x8c, 0x94, 0x00, 0xd9, 0x07, 0x33, 0xc1, 0xf3, 0xe0,
+  0x48, 0xcb, 0xc3, 0x0f, 0x01, 0xf3, 0xc3, 0xfc, 0x52, 0x21, 0xac, 0x3c, 0xf0, 0xc2, 0x03, 0x96,
+  0x16, 0xf0, 0xbc, 0x9f, 0xd8, 0x68, 0x0c, 0x3d, 0x7d, 0xd3, 0x06, 0xa5, 0x2d, 0x60, 0xcf, 0x7c,
+  0xa9, 0x50, 0x9f, 0x15, 0x74, 0x6d, 0x51, 0xe0, 0x36, 0x38, 0xbd, 0x55, 0xec, 0xbb, 0xdf, 0x70,
+  0x86, 0x9c, 0x6e, 0xbe, 0x8f, 0x28, 0xb1, 0x34, 0xab, 0x97, 0xce, 0x0e, 0x7c, 0xc5, 0x36, 0xa6,
+  0x01, 0x3d, 0xfd, 0x91, 0x67, 0x12, 0x73, 0xbf, 0xe7, 0x67, 0x01, 0x38, 0x05, 0x80, 0x4a, 0x86,
+  0x87, 0x0a, 0x45, 0x01, 0x4a, 0x30, 0x0c, 0xe1, 0x45, 0x9b, 0x56, 0x0b, 0x72, 0x09, 0xe3, 0xda,
+  0x70, 0x0d, 0x22, 0x64, 0xa7, 0xc3, 0x09, 0x3b, 0x23, 0xd2, 0xdf, 0x00, 0xa2, 0x7f, 0xc1, 0xf8,
+  0x96, 0x0a, 0x74, 0x79, 0x38, 0xca, 0x9a, 0x27, 0xf7, 0x3b, 0x16, 0xa4, 0x01, 0x3e, 0xbb, 0xe5,
+  0x18, 0x2c, 0x2d, 0x22, 0x67, 0x80, 0x15, 0x59, 0xc2, 0x0f, 0x6d, 0x88, 0xfe, 0xf2, 0x4a, 0xdb,
+  0x59, 0x9c, 0x11, 0xa3, 0x13, 0xa7, 0xd6, 0x0a, 0xcb, 0xb7, 0x21, 0x34, 0x52, 0x6b, 0xaa, 0xd9,
+  0xf5, 0xc2, 0xf2, 0xdb, 0xdd, 0x2e, 0x58, 0xab, 0x67, 0x6e, 0xb2, 0xbc, 0x15, 0x90, 0xc8, 0x70,
+  0x7c, 0xcf, 0xc1, 0x94, 0x1f, 0xa1, 0x9d, 0xb4, 0x08, 0xda, 0x09, 0x78, 0xa0, 0x47, 0xa3, 0xdf,
+  0xf3, 0xa4, 0xe9, 0x19, 0xc1, 0xff, 0xdf, 0x00, 0xbf, 0x1e, 0x01, 0xef, 0x0e, 0x4e, 0x24, 0xd5,
+  0x9a, 0x94, 0xea, 0xac, 0xe2, 0x86, 0xde, 0x19, 0xba, 0x9e, 0x7f, 0x93, 0xd9, 0x85, 0xf3, 0xc3,
+  0x78, 0xe5, 0xd6, 0xdb, 0xe4, 0xff, 0x9e, 0x9e, 0x34, 0xb6, 0x54, 0x6b, 0xa1, 0xee, 0x89, 0x4b,
+  0x44, 0x54, 0xc1, 0x73, 0xa5, 0x4f, 0xdf, 0xb6, 0x06, 0x3d, 0x7a, 0x56, 0x3c, 0xbf, 0xe5, 0x7e,
+  0xfc, 0x75, 0xf0, 0x3c, 0x51, 0xb0, 0x98, 0xa8, 0x76, 0xb8, 0xfd, 0xaa, 0x05, 0x69, 0x3c, 0x57,
+  0xbc, 0xe3, 0xdd, 0x45, 0x46, 0x17, 0x43, 0x0f, 0x38, 0xad, 0x42, 0x06, 0xff, 0x8b, 0xc1, 0x99,
+  0xbb, 0xcb, 0xd7, 0xf2, 0xd4, 0xb5, 0x3f, 0x9d, 0xb2, 0x4d, 0x92, 0x7e, 0x43, 0x32, 0x75, 0xae,
+  0x5a, 0x48, 0x92, 0xb5, 0x0a, 0xa9, 0x37, 0xba, 0xf9, 0x24, 0x65, 0x8d, 0x26, 0x50, 0x46, 0x78,
+  0xed, 0x73, 0xa9, 0x20, 0xb2, 0x97, 0xd1, 0x43, 0x50, 0xc5, 0xcf, 0x0a, 0x63, 0x2b, 0x1f, 0x98,
+  0x75, 0x46, 0x77, 0xc7, 0x65, 0xf0, 0xc9, 0x04, 0x14, 0x8b, 0xa8, 0x4f, 0x8e, 0x44, 0x49, 0xf2,
+  0x93, 0xc8, 0xa1, 0xf1, 0x1a, 0x8d, 0x9a, 0x80, 0x67, 0x73, 0xee, 0x2f, 0x00, 0xb1, 0xfd, 0xe0,
+  0xfb, 0xb0, 0xa8, 0x23, 0x8e, 0x13, 0x64, 0x86, 0x7c, 0x60, 0x56, 0xae, 0x9b, 0x53, 0xe6, 0xdf,
+  0xf9, 0x30, 0x20, 0xe9, 0x06, 0x21, 0x1c, 0x08, 0x24, 0x94, 0x84, 0x7b, 0xe0, 0x32, 0xce, 0x3f,
+  0xc3, 0xa4, 0xdd, 0x88, 0x67, 0x71, 0xe9, 0x3a, 0xac, 0x5c, 0xe3, 0x9b, 0x5a, 0xb2, 0x48, 0x5f,
+  0x6b, 0x62, 0x91, 0x1e, 0xbb, 0x71, 0x1d, 0xcb, 0xd9, 0x6a, 0xe1, 0x49, 0x63, 0x41, 0xa9, 0xc9,
+  0xe7, 0x74, 0x5d, 0xc2, 0xb6, 0x03, 0x76, 0x1c, 0x92, 0x75, 0x7d, 0x5e, 0xef, 0x97, 0x5d, 0x86,
+  0x89, 0x4d, 0x86, 0x86, 0x06, 0x8a, 0xb9, 0x38, 0x03, 0xd8, 0x4a, 0x7e, 0x9d, 0xe4, 0x8c, 0xc6,
+  0xb9, 0x77, 0xcc, 0xa1, 0x2c, 0x7b, 0x90, 0xf2, 0xda, 0xd4, 0xfe, 0xc0, 0xec, 0x98, 0x28, 0x4e,
+  0x90, 0xe4, 0x4b, 0x29, 0x45, 0xcc, 0x49, 0x9e, 0xf1, 0x92, 0xec, 0xe7, 0xc7, 0x1f, 0x21, 0x79,
+  0x18, 0x05, 0x18, 0x37, 0x21, 0x3b, 0xca, 0xe7, 0x2e, 0x6f, 0x21, 0x84, 0x2d, 0x01, 0xec, 0x5a,
+  0x2f, 0x24, 0x3b, 0x7a, 0xc8, 0xb3, 0xad, 0x9e, 0xe9, 0xb3, 0x0a, 0x6f, 0x00, 0xb5, 0x80, 0x03,
+  0x15, 0x44, 0x94, 0xb3, 0x23, 0x56, 0x9f, 0xc9, 0x0e, 0x43, 0xba, 0x8b, 0xd5, 0xd5, 0xf7, 0xde,
+  0x95, 0x5a, 0x10, 0x1c, 0x66, 0xdc, 0x44, 0xc2, 0xd6, 0x7c, 0xb6, 0xed, 0x17, 0x22, 0xf4, 0x57,
+  0x3d, 0xd3, 0x28, 0x10, 0xc8, 0x5b, 0xda, 0xac, 0xe7, 0x58, 0x20, 0x2c, 0xb0, 0xa1, 0x2f, 0x83,
+  0x57, 0xa3, 0xc7, 0x52, 0x31, 0x43, 0x98, 0x85, 0x63, 0x0f, 0xd3, 0x63, 0x30, 0x03, 0x87, 0xbb,
+  0xcf, 0x39, 0xfb, 0x03, 0x72, 0x75, 0x12, 0x62, 0x03, 0x00, 0xb3, 0x05, 0x0a, 0x13, 0x23, 0x77,
+  0x07, 0x46, 0xd2, 0xc8, 0x29, 0xe0, 0x04, 0x8a, 0x85, 0x13, 0x1e, 0xf3, 0x43, 0x59, 0x29, 0x9d,
+  0x99, 0xf9, 0x64, 0xa2, 0x36, 0x95, 0x4b, 0x88, 0xf4, 0x07, 0x02, 0x0a, 0x64, 0x87, 0x90, 0x1e,
+  0x8c, 0xfe, 0x1d, 0xbc, 0xf4, 0xa1, 0xa8, 0x31, 0xbf, 0x24, 0x52, 0x33, 0xa7, 0xac, 0x44, 0x44,
+  0x1d, 0x26, 0x05, 0x8d, 0xe0, 0x6b, 0x20, 0x14, 0x6c, 0x1b, 0x9d, 0xcc, 0x53, 0x8c, 0xae, 0x90,
+  0x2f, 0x41, 0x4c, 0xe5, 0x71, 0x81, 0x27, 0x25, 0x98, 0x3f, 0x3d, 0xe0, 0xb1, 0x81, 0x1f, 0xc5,
+  0x9f, 0xcb, 0x72, 0xf1, 0x43, 0x8c, 0xba, 0xa4, 0xf4, 0xa1, 0xe3, 0x9b, 0x1b, 0xb7, 0xea, 0x15,
+  0xf0, 0x5d, 0xc3, 0x81, 0x86, 0xa5, 0x7a, 0xc8, 0xb4, 0x60, 0xd2, 0xa1, 0x00, 0xf4, 0x02, 0x2e,
+  0x0f, 0x60, 0xfe, 0xe7, 0x7c, 0x21, 0x4f, 0x6c, 0x3e, 0xe5, 0x49, 0xd9, 0x5f, 0x05, 0xea, 0x65,
+  0xd1, 0x2f, 0x51, 0x7c, 0x1c, 0xac, 0xc2, 0xd6, 0x10, 0x38, 0xd7, 0xa8, 0x06, 0xc0, 0xbd, 0xd0,
+  0xb3, 0x30, 0x65, 0x7e, 0x33, 0xfa, 0x0c, 0x23, 0x00, 0x77, 0x45, 0xf7, 0x41, 0x83, 0xf8, 0x60,
+  0x8a, 0x35, 0xe2, 0xc1, 0x4b, 0xc2, 0x03, 0xc6, 0xab, 0xd1, 0x43, 0x7d, 0x6c, 0xbd, 0x62, 0x5c,
+  0x77, 0x48, 0xb4, 0x67, 0x73, 0xda, 0x5f, 0x71, 0x2b, 0x30, 0xbf, 0x07, 0x16, 0xf7, 0x2a, 0x65,
+  0x5c, 0xe1, 0xf7, 0xef, 0xc2, 0xed, 0x72, 0x4e, 0x53, 0x4c, 0x99, 0xb2, 0x86, 0x16, 0x83, 0xc1,
+  0xf1, 0x29, 0x2f, 0x6c, 0xab, 0x45, 0x71, 0x20, 0x0f, 0xb9, 0xf3, 0x1a, 0x28, 0xff, 0x44, 0xd7,
+  0xf5, 0x29, 0xba, 0x63, 0xd8, 0xb3, 0x05, 0x60, 0x7f, 0xc4, 0xf3, 0x0f, 0xc6, 0xaa, 0x19, 0x9e,
+  0x23, 0x85, 0x1a, 0x1d, 0x77, 0xcb, 0x82, 0xc3, 0x16, 0xa1, 0x06, 0x04, 0x44, 0x88, 0x11, 0x90,
+  0xc8, 0x31, 0xbb, 0xe7, 0x0c, 0x3d, 0x96, 0xe6, 0x4d, 0xc8, 0xa2, 0x45, 0xaf, 0xed, 0x9a, 0x03,
+  0x08, 0xb0, 0x16, 0xf3, 0x09, 0x6c, 0xe4, 0xaf, 0x32, 0xdb, 0x73, 0x5c, 0x8f, 0x2c, 0x11, 0x7b,
+  0x68, 0x59, 0x0b, 0x6f, 0xbd, 0xd5, 0x19, 0xda, 0xfc, 0x65, 0x00, 0x81, 0xc7, 0x75, 0xc7, 0xbd,
+  0xc5, 0xbb, 0x13, 0x25, 0xd3, 0x28, 0x8b, 0x88, 0xae, 0xf1, 0xe6, 0xa6, 0xd9, 0x21, 0x25, 0xf1,
+  0x66, 0xd6, 0xd2, 0x92, 0x58, 0xab, 0x11, 0x59, 0x73, 0x29, 0x16, 0x17, 0xe4, 0x04, 0x70, 0xe4,
+  0xf8, 0xb4, 0x28, 0x1a, 0x5e, 0x45, 0x4d, 0xb6, 0x45, 0xe3, 0xb5, 0x8b, 0xa4, 0x56, 0x25, 0xbf,
+  0xf9, 0x8d, 0x00, 0x4c, 0x96, 0x49, 0xa3, 0x1a, 0x43, 0xe1, 0x6f, 0x4a, 0x15, 0x17, 0xb2, 0x2b,
+  0x9a, 0xea, 0x8a, 0xd9, 0x66, 0xbc, 0x02, 0xdf, 0xca, 0x92, 0x0b, 0xc2, 0x21, 0x67, 0xa3, 0x18,
+  0x76, 0x67, 0x33, 0x08, 0xdd, 0xc8, 0x45, 0xa8, 0x9e, 0x40, 0xe8, 0xea, 0x14, 0x08, 0xcd, 0x26,
+  0x56, 0xcc, 0x57, 0x4f, 0x87, 0x10, 0x6f, 0x53, 0xe5, 0xb3, 0x28, 0x41, 0xf0, 0xd5, 0xe6, 0xf1,
+  0x18, 0xd5, 0x9b, 0xe3, 0x68, 0x38, 0x09, 0x46, 0x70, 0xd2, 0x8e, 0xf0, 0x49, 0x88, 0x16, 0xa7,
+  0x2a, 0x03, 0x7b, 0x8a, 0xd2, 0x0c, 0x07, 0x06, 0x1e, 0x68, 0x44, 0x2b, 0xb4, 0xe4, 0x89, 0xe5,
+  0x49, 0x3d, 0xf3, 0x10, 0x04, 0xb8, 0x5a, 0xcf, 0x87, 0xf4, 0x6d, 0x00, 0x03, 0x62, 0x87, 0x50,
+  0x49, 0x5a, 0x64, 0x77, 0xb3, 0x45, 0x3c, 0x1d, 0x6f, 0x58, 0x7f, 0xc0, 0x5c, 0x8a, 0x45, 0x85,
+  0x32, 0x19, 0xb6, 0x8a, 0x3f, 0xee, 0x5f, 0x2b, 0xee, 0x95, 0x95, 0xd9, 0x37, 0xd4, 0xd9, 0x37,
+  0x86, 0x7d, 0xd3, 0x80, 0x10, 0x5a, 0xc6, 0xe7, 0x30, 0xfb, 0x92, 0x32, 0x57, 0x30, 0xb7, 0x25,
+  0xe6, 0xaa, 0xc5, 0x8a, 0x72, 0x76, 0x2e, 0x92, 0xdd, 0x22, 0x12, 0xae, 0xa8, 0x1a, 0xb0, 0x4d,
+  0x66, 0xdd, 0x1c, 0x6e, 0x97, 0xf9, 0x5c, 0x7c, 0x8e, 0x1c, 0xd8, 0x43, 0x3a, 0xde, 0x5f, 0xbf,
+  0x0b, 0xf9, 0xaa, 0xbe, 0xc1, 0x76, 0xbc, 0x12, 0x50, 0xa3, 0xe9, 0x90, 0x32, 0xae, 0xd0, 0x76,
+  0x8f, 0xb3, 0x71, 0x59, 0x92, 0x26, 0x88, 0x65, 0x16, 0x01, 0x62, 0x0d, 0xa7, 0x3d, 0xec, 0x33,
+  0xdb, 0xd7, 0xbb, 0xcc, 0x5f, 0xb1, 0x18, 0x5e, 0xbe, 0xb3, 0xf3, 0x9e, 0x01, 0xf3, 0xa3, 0x57,
+  0x53, 0x70, 0x32, 0xc8, 0x0e, 0x26, 0x03, 0xc4, 0x8f, 0x4c, 0xe3, 0x63, 0x7d, 0x53, 0x7d, 0x34,
+  0x24, 0x44, 0x79, 0x34, 0x8c, 0xa5, 0x7f, 0x81, 0x45, 0x36, 0x98, 0x00, 0xb5, 0x82, 0xa0, 0x98,
+  0xa5, 0xff, 0x6a, 0xc8, 0xdc, 0x9d, 0x55, 0x9e, 0x60, 0x3b, 0x6e, 0xa9, 0x28, 0x5e, 0xac, 0x2c,
+  0x6a, 0x09, 0xf5, 0x89, 0xac, 0x19, 0x15, 0xc8, 0xf4, 0x6e, 0xd3, 0xdb, 0x38, 0xaa, 0x85, 0x6a,
+  0x40, 0x10, 0x9a, 0x6e, 0xda, 0x36, 0x73, 0x6f, 0xac, 0xdd, 0xba, 0x09, 0x70, 0x8b, 0x51, 0x3f,
+  0xb1, 0x78, 0x79, 0x78, 0xb9, 0x18, 0x76, 0x14, 0xa5, 0x8e, 0x11, 0xdc, 0x97, 0x3b, 0x92, 0xdb,
+  0xb4, 0xcf, 0x70, 0xba, 0xe8, 0x75, 0xca, 0xc7, 0x7b, 0xf0, 0xd8, 0x63, 0x63, 0x61, 0xc3, 0xce,
+  0xba, 0xef, 0x5c, 0x37, 0xb7, 0x99, 0x51, 0xaa, 0x69, 0x00, 0x7c, 0xd2, 0x46, 0x82, 0xd8, 0xb6,
+  0x85, 0x2a, 0x96, 0xef, 0xba, 0xb4, 0x63, 0x70, 0xba, 0x5c, 0xc2, 0xd5, 0x3f, 0x25, 0x45, 0x52,
+  0xbc, 0x8c, 0x57, 0x2d, 0xd0, 0x6e, 0xb9, 0x86, 0xcb, 0x1b, 0xae, 0x23, 0xcd, 0xc5, 0x17, 0x59,
+  0xc6, 0x0b, 0xb3, 0x18, 0x85, 0x0c, 0x01, 0x40, 0xac, 0xf1, 0xb7, 0xa7, 0x58, 0x83, 0x31, 0x44,
+  0x2c, 0x42, 0x89, 0x80, 0x62, 0x43, 0x6e, 0xdd, 0xa7, 0x68, 0x5b, 0x2b, 0x36, 0x5d, 0xb7, 0x98,
+  0x11, 0x8a, 0x02, 0x30, 0xd0, 0x79, 0x86, 0xa2, 0x2b, 0xef, 0x0e, 0x02, 0x31, 0xf2, 0x7d, 0x18,
+  0xc9, 0x17, 0xd8, 0x53, 0xc7, 0x44, 0xee, 0x9a, 0x78, 0x87, 0x08, 0x27, 0xe4, 0xb5, 0x2b, 0xe0,
+  0x54, 0xce, 0x9b, 0x0d, 0xc2, 0xbc, 0x55, 0xa9, 0x8c, 0xdd, 0xa6, 0x73, 0xf5, 0xca, 0x6c, 0x6d,
+  0xee, 0x14, 0xdb, 0xfc, 0x39, 0xde, 0x08, 0x5d, 0x07, 0xf5, 0x76, 0xec, 0x36, 0x89, 0x1c, 0x48,
+  0x87, 0xf9, 0xed, 0xde, 0xcf, 0x3c, 0xc7, 0x2e, 0x0d, 0x5d, 0xab, 0x4c, 0xe0, 0x8c, 0x28, 0x9d,
+  0x88, 0xe0, 0xa1, 0xcb, 0x50, 0xbe, 0x74, 0x8b, 0x9a, 0xbe, 0x98, 0x1a, 0x4f, 0x43, 0x8d, 0xdd,
+  0xdd, 0x8b, 0x58, 0x77, 0x01, 0xa6, 0xea, 0xce, 0x86, 0x46, 0xfc, 0x1e, 0xbe, 0xf4, 0x63, 0xb3,
+  0x2d, 0xb2, 0xe2, 0xba, 0xa8, 0xf8, 0x37, 0xd6, 0xd6, 0xee, 0x80, 0x88, 0xf1, 0xb9, 0xe0, 0x39,
+  0x5f, 0x23, 0x1d, 0x9a, 0x00, 0x8d, 0xcf, 0xee, 0x22, 0x12, 0xda, 0x42, 0x0e, 0x8e, 0x96, 0x43,
+  0x0d, 0xe9, 0xcf, 0x4a, 0x02, 0x39, 0x3f, 0x7a, 0x2d, 0x53, 0xaa, 0x07, 0xf5, 0x69, 0x12, 0x4f,
+  0x4e, 0x52, 0x71, 0x86, 0x0e, 0x4c, 0x38, 0xe3, 0xf2, 0xa5, 0xa1, 0x6e, 0x25, 0x5d, 0x26, 0xae,
+  0x14, 0xef, 0x24, 0x92, 0x36, 0x45, 0xfa, 0x98, 0xa6, 0x40, 0x76, 0x40, 0x0e, 0x8c, 0x53, 0xc1,
+  0xb4, 0x71, 0x1c, 0x14, 0xd8, 0x85, 0xe7, 0xd0, 0x5c, 0xf4, 0xbc, 0x09, 0xb8, 0x89, 0x85, 0xc5,
+  0x84, 0x37, 0x82, 0x51, 0x58, 0x81, 0x76, 0x84, 0x66, 0xb4, 0xb4, 0xbc, 0x1b, 0xb9, 0xb4, 0xa5,
+  0x49, 0xfe, 0x0c, 0xe4, 0x50, 0x42, 0x9f, 0x04, 0xf6, 0x26, 0x53, 0x05, 0x34, 0xc3, 0x05, 0xe1,
+  0x39, 0x09, 0x42, 0x2d, 0x15, 0x93, 0x8d, 0x92, 0x62, 0x19, 0x7c, 0x6e, 0x72, 0x48, 0x1b, 0x33,
+  0x99, 0x6e, 0x67, 0x26, 0xd3, 0xed, 0x9c, 0xc9, 0xa2, 0xc7, 0x00, 0x73, 0xe3, 0xc9, 0x62, 0x68,
+  0xcc, 0x5c, 0x0e, 0x37, 0x39, 0x37, 0x09, 0x37, 0xaf, 0x28, 0xcf, 0x51, 0xc9, 0x7b, 0x30, 0x6e,
+  0x61, 0x5c, 0x24, 0xcf, 0x2c, 0x8d, 0x1f, 0xa9, 0x8b, 0x95, 0xf2, 0x35, 0x5f, 0xa1, 0xdc, 0xab,
+  0xd3, 0x32, 0xd5, 0x60, 0x3e, 0x39, 0x33, 0x9a, 0xb7, 0x44, 0xd6, 0x78, 0x91, 0x7a, 0x65, 0x89,
+  0x1c, 0xcd, 0xa0, 0x12, 0xd7, 0x4e, 0xe5, 0x82, 0xd4, 0x68, 0x82, 0xbb, 0x71, 0x99, 0x93, 0x4f,
+  0xe6, 0x0f, 0x74, 0x65, 0x34, 0xcd, 0xa5, 0xb0, 0x86, 0x17, 0xce, 0x16, 0x0c, 0x0a, 0x47, 0xd3,
+  0xb3, 0xc3, 0x4a, 0x5a, 0x72, 0x76, 0x38, 0x9a, 0x9e, 0x1d, 0x15, 0xbe, 0xe4, 0x74, 0x31, 0x3b,
+  0x1a, 0xcd, 0x9d, 0x2e, 0x0b, 0x4a, 0x42, 0x31, 0xd2, 0xa3, 0x67, 0xb3, 0xd6, 0x64, 0xd5, 0x48,
+  0xf1, 0x74, 0xa6, 0x81, 0x56, 0xfa, 0x51, 0xc6, 0x40, 0x32, 0x46, 0x90, 0x56, 0xf4, 0xb4, 0x32,
+  0x27, 0x6a, 0x73, 0x98, 0xe2, 0xe4, 0x2b, 0xf0, 0x58, 0xf5, 0x4c, 0xaa, 0x5e, 0x06, 0x5a, 0x8e,
+  0xc6, 0x65, 0x55, 0x2a, 0xab, 0x33, 0x49, 0xa5, 0xc8, 0xc5, 0x31, 0xd6, 0x82, 0x94, 0x98, 0xd3,
+  0x72, 0xcc, 0x0a, 0xea, 0xe3, 0x38, 0xea, 0xf2, 0x1f, 0x5a, 0x42, 0x92, 0xc9, 0x9d, 0x0e, 0x30,
+  0x75, 0x72, 0x86, 0x36, 0x45, 0x82, 0x96, 0x9b, 0x6a, 0xe1, 0x60, 0xe4, 0xe6, 0x2e, 0x60, 0xfe,
+  0x0c, 0xa9, 0x33, 0x6e, 0x8d, 0x49, 0x1a, 0x40, 0xbd, 0xcd, 0x0b, 0x97, 0xd1, 0x14, 0xa1, 0x0e,
+  0x22, 0xa1, 0x48, 0x3b, 0xe7, 0x6c, 0x88, 0x4b, 0xb9, 0xe6, 0x72, 0x94, 0x30, 0x41, 0xe2, 0xd2,
+  0x73, 0x0c, 0xc8, 0x53, 0xee, 0xbc, 0xbf, 0xba, 0x16, 0x71, 0x51, 0xbc, 0xf7, 0xe9, 0x41, 0x6a,
+  0x4c, 0x8a, 0x32, 0x20, 0x57, 0xd6, 0x76, 0x06, 0xac, 0xd8, 0x2a, 0xe2, 0xaf, 0x59, 0xcd, 0x36,
+  0x4f, 0x27, 0x66, 0x30, 0xbe, 0x15, 0xc9, 0x5e, 0xb8, 0x0a, 0x91, 0x6d, 0x91, 0x9f, 0xad, 0xbe,
+  0x7f, 0x1b, 0xa2, 0x22, 0x0a, 0xcf, 0xec, 0xec, 0x94, 0x70, 0x50, 0x13, 0x19, 0x50, 0x22, 0x20,
+  0x24, 0xe2, 0x9b, 0x1a, 0x2c, 0x43, 0x5e, 0xe0, 0x04, 0x1e, 0x7d, 0x43, 0x54, 0xa9, 0xc5, 0x5c,
+  0x30, 0xa9, 0x9c, 0x57, 0x03, 0x12, 0xe5, 0x03, 0x2c, 0x0e, 0x7f, 0x16, 0x65, 0x5d, 0xc9, 0xf4,
+  0x50, 0xca, 0x93, 0x62, 0xfe, 0x21, 0x36, 0x30, 0x6d, 0xe0, 0x26, 0xc8, 0x11, 0x22, 0xff, 0x47,
+  0x1f, 0x6b, 0x3a, 0xe4, 0xc4, 0xa5, 0x0e, 0x0a, 0xf5, 0x97, 0xff, 0xb2, 0xdb, 0x11, 0x6f, 0x98,
+  0xef, 0xb5, 0x08, 0x5e, 0x73, 0x2b, 0xdc, 0xfb, 0xa5, 0xa6, 0xdf, 0x05, 0x65, 0x2f, 0x15, 0x7f,
+  0x61, 0x17, 0xa3, 0x64, 0x30, 0x46, 0xec, 0x20, 0x83, 0x4a, 0x70, 0x54, 0x26, 0xfc, 0xd5, 0xb4,
+  0xa3, 0xf0, 0xcd, 0x19, 0x51, 0x13, 0xe1, 0x7d, 0xbf, 0xd1, 0xe3, 0x16, 0xc0, 0x21, 0x97, 0x11,
+  0x23, 0x25, 0x4d, 0x54, 0xe8, 0x1f, 0xda, 0x1b, 0xb6, 0xb3, 0x65, 0x93, 0x9f, 0xfc, 0x84, 0xa8,
+  0xf7, 0xba, 0xc5, 0xec, 0xae, 0xdf, 0xd3, 0x22, 0x1f, 0x81, 0x87, 0x32, 0x81, 0x01, 0xa4, 0x49,
+  0x2f, 0xf8, 0x56, 0x58, 0x2f, 0x01, 0x4e, 0x28, 0x9b, 0x81, 0xd8, 0x55, 0x20, 0x72, 0xc7, 0x64,
+  0xb0, 0x9f, 0xda, 0x13, 0xc5, 0x64, 0x7f, 0x35, 0xfa, 0x14, 0x36, 0x7d, 0xca, 0x0b, 0xc4, 0x19,
+  0xf2, 0x0f, 0x61, 0xdb, 0xb1, 0x9e, 0x8b, 0xbf, 0x65, 0x22, 0x7e, 0x6f, 0x5d, 0x26, 0x94, 0x8f,
+  0xa5, 0xb3, 0x8d, 0xac, 0x12, 0xcb, 0x12, 0xdb, 0x09, 0x74, 0xf8, 0x58, 0x15, 0x9e, 0xac, 0xc1,
+  0xbb, 0x24, 0x89, 0x22, 0x28, 0xb2, 0xa2, 0xcf, 0xa7, 0x77, 0xdb, 0x51, 0x65, 0x58, 0x71, 0xd9,
+  0x16, 0x38, 0xcf, 0x95, 0x49, 0x3e, 0xa4, 0x18, 0x16, 0x82, 0x05, 0x57, 0xc5, 0xfc, 0x4c, 0xe2,
+  0x9c, 0x29, 0x34, 0x8b, 0x1a, 0x92, 0xae, 0xeb, 0xc5, 0xd8, 0xad, 0x79, 0x3d, 0x48, 0x6a, 0xa5,
+  0x1d, 0x68, 0x69, 0x47, 0x66, 0x33, 0x1f, 0x7d, 0x08, 0xd7, 0x17, 0xb8, 0xde, 0x72, 0xdc, 0x0d,
+  0x4f, 0x18, 0x89, 0xe2, 0xc2, 0x70, 0x52, 0xa4, 0x8a, 0xa1, 0x34, 0x72, 0x51, 0xe2, 0x70, 0x90,
+  0x62, 0x1b, 0x98, 0x8a, 0x07, 0xa4, 0x49, 0x28, 0xe2, 0xb1, 0x09, 0x9e, 0xf3, 0x62, 0x30, 0xaf,
+  0xde, 0xe1, 0xc7, 0x3e, 0xd8, 0xfa, 0x73, 0x69, 0xdc, 0xa1, 0xe1, 0xa9, 0xee, 0x53, 0x18, 0x4e,
+  0xee, 0xe6, 0x1c, 0x4d, 0xb4, 0x6c, 0x9b, 0x5b, 0xf6, 0xdf, 0xee, 0x7d, 0x0b, 0x16, 0x6d, 0xeb,
+  0x9e, 0x67, 0x1a, 0x7b, 0xa4, 0x84, 0x97, 0x2e, 0x5c, 0xef, 0x11, 0xe3, 0x9d, 0xbe, 0xc6, 0x1f,
+  0xb0, 0x36, 0x04, 0x30, 0x7e, 0x8c, 0xfb, 0xfb, 0xd7, 0x5f, 0x3c, 0xe1, 0xf8, 0x14, 0xf3, 0x4c,
+  0x3f, 0x32, 0xd3, 0x90, 0x32, 0x2d, 0x0f, 0x81, 0xcb, 0x20, 0x91, 0x5f, 0xd8, 0x25, 0xa0, 0x32,
+  0x2a, 0xea, 0x8d, 0x1e, 0x87, 0x95, 0x4b, 0xa0, 0x57, 0x13, 0x27, 0x99, 0x85, 0x84, 0xde, 0x63,
+  0x71, 0x6d, 0xe2, 0x11, 0x00, 0xf5, 0xe0, 0x5f, 0x71, 0xdf, 0x10, 0x19, 0x14, 0x67, 0x9c, 0xfb,
+  0xf3, 0x9f, 0x10, 0x91, 0x12, 0x82, 0x31, 0x01, 0x46, 0x75, 0x21, 0x25, 0x02, 0x70, 0x28, 0x26,
+  0x2f, 0x55, 0x2d, 0x90, 0xcb, 0x97, 0x4d, 0xc5, 0xc9, 0xf2, 0xcd, 0xf0, 0xa8, 0x73, 0xc7, 0x75,
+  0xfa, 0xa6, 0xc7, 0x4a, 0x2e, 0x32, 0x0d, 0x22, 0xc7, 0x9a, 0xd9, 0x67, 0xce, 0xd0, 0x2f, 0xb9,
+  0x65, 0xfc, 0xf5, 0x9b, 0x16, 0x79, 0xbf, 0x93, 0x61, 0x99, 0xc5, 0x73, 0x6f, 0x7a, 0x8f, 0x33,
+  0x46, 0xdb, 0x53, 0x0e, 0x28, 0x47, 0xaf, 0xc0, 0x09, 0x4d, 0xca, 0x9e, 0x32, 0x66, 0x88, 0xaa,
+  0x71, 0x9c, 0x11, 0x62, 0x3b, 0xa3, 0xa8, 0x89, 0x60, 0xac, 0x83, 0xb3, 0xe8, 0x97, 0x94, 0x83,
+  0x3a, 0x36, 0x18, 0x8e, 0x03, 0x80, 0x2d, 0x87, 0x1c, 0x00, 0xdc, 0xb2, 0x10, 0x81, 0x90, 0x17,
+  0xa1, 0x9f, 0x7d, 0x92, 0xa8, 0xaa, 0x27, 0xda, 0x30, 0x21, 0x77, 0x63, 0x83, 0xd8, 0x3b, 0x41,
+  0x5a, 0x20, 0x84, 0xc4, 0xfc, 0x7f, 0x66, 0x5a, 0xb0, 0xcb, 0x79, 0x5c, 0x26, 0x61, 0x27, 0xa6,
+  0x25, 0x58, 0xb6, 0x97, 0x97, 0x2a, 0x88, 0xaa, 0x47, 0x9c, 0x29, 0xa0, 0xfc, 0xc3, 0x4c, 0x21,
+  0xa6, 0x31, 0x9c, 0x7d, 0x17, 0xe6, 0xf2, 0xcd, 0x06, 0xf8, 0x0f, 0x87, 0x94, 0x60, 0x71, 0x2a,
+  0x50, 0xdf, 0xd5, 0xfb, 0xcc, 0xf3, 0x68, 0x97, 0xa1, 0x3f, 0x9b, 0x2e, 0x9d, 0xd0, 0x49, 0xf0,
+  0x5d, 0x7e, 0x2b, 0x22, 0x7c, 0x07, 0x6a, 0x1f, 0x5f, 0xf1, 0x96, 0xca, 0x07, 0x22, 0x11, 0x8d,
+  0x0d, 0x3d, 0x4e, 0x43, 0xb8, 0x7e, 0x67, 0x52, 0x99, 0xaf, 0x38, 0x20, 0x98, 0x0f, 0x9c, 0xbe,
+  0x1c, 0x63, 0xba, 0x77, 0xb6, 0x20, 0xcc, 0x1b, 0x38, 0xe1, 0xeb, 0xf0, 0x2f, 0x85, 0x0f, 0x8d,
+  0x69, 0x3c, 0x08, 0x3b, 0x46, 0xc5, 0x89, 0xe7, 0xff, 0x77, 0x4d, 0xda, 0x3d, 0x4d, 0x69, 0x02,
+  0x5b, 0xc0, 0xb6, 0xe3, 0xf9, 0x66, 0x3b, 0x55, 0x01, 0xc0, 0x1e, 0xf1, 0x24, 0x93, 0xc0, 0x85,
+  0xe1, 0x0a, 0x98, 0x9b, 0x17, 0x40, 0x70, 0xe8, 0x64, 0x31, 0x77, 0x66, 0x86, 0xf0, 0xae, 0x19,
+  0x8a, 0xe5, 0x45, 0xe8, 0x0b, 0x44, 0x42, 0x76, 0x38, 0xfa, 0x04, 0x7b, 0x46, 0xa3, 0xc7, 0x20,
+  0x2d, 0xfe, 0xde, 0xc3, 0x03, 0x3e, 0xef, 0x28, 0x78, 0x45, 0x44, 0xb2, 0xec, 0xbb, 0x8c, 0xf6,
+  0x5b, 0xe1, 0x2b, 0x5a, 0xf2, 0x77, 0x06, 0x99, 0x1f, 0xf6, 0x48, 0x60, 0xe9, 0x0e, 0x94, 0xe8,
+  0xda, 0x1c, 0x96, 0x39, 0x06, 0xd8, 0xb9, 0xc1, 0xb7, 0xff, 0x3f, 0x0d, 0xfb, 0x5a, 0x0f, 0x44,
+  0x0f, 0x06, 0xb7, 0x23, 0x3c, 0x61, 0x7b, 0x25, 0x17, 0x3c, 0xe3, 0x62, 0x3c, 0x88, 0x7b, 0x5a,
+  0x10, 0x2a, 0xf4, 0x88, 0x04, 0x05, 0x4f, 0xd1, 0xd5, 0x52, 0xfb, 0x70, 0x00, 0x40, 0xfc, 0x9e,
+  0xea, 0x48, 0xe4, 0x9b, 0xa3, 0xfb, 0xa2, 0x9f, 0xf7, 0x02, 0x3b, 0x79, 0x0d, 0xc0, 0x5c, 0xe7,
+  0x1d, 0x9b, 0x81, 0x63, 0x59, 0xe8, 0xca, 0xdd, 0x9c, 0x7e, 0x0d, 0xff, 0x87, 0x57, 0xee, 0xc0,
+  0x04, 0x30, 0xd2, 0x52, 0xdc, 0xa4, 0x89, 0x96, 0xa8, 0x07, 0x96, 0x44, 0x05, 0x0b, 0x07, 0x54,
+  0xc0, 0xe0, 0x4c, 0xde, 0xc3, 0xdf, 0xbe, 0x81, 0x6f, 0x2b, 0x29, 0x13, 0xcb, 0xf8, 0xc3, 0xfa,
+  0xaa, 0x96, 0xac, 0xf7, 0x7b, 0xbe, 0x33, 0xc8, 0xee, 0x79, 0x21, 0x77, 0xd3, 0xb6, 0xc5, 0xa8,
+  0x1b, 0x41, 0x8e, 0xa7, 0xa4, 0xf7, 0x17, 0x84, 0xed, 0xa5, 0x49, 0x5b, 0xe5, 0x22, 0x55, 0x77,
+  0xd9, 0x32, 0x6d, 0xc3, 0xd9, 0xd2, 0x57, 0x36, 0x41, 0xcb, 0x56, 0xe1, 0x54, 0xd9, 0x8e, 0x54,
+  0x2a, 0xc9, 0x8b, 0x3c, 0xf7, 0x2a, 0x4f, 0x7c, 0xbc, 0xf1, 0x85, 0xa5, 0xc1, 0x18, 0x46, 0x78,
+  0xdc, 0xe2, 0xdb, 0x09, 0x9d, 0x06, 0xb7, 0x45, 0x0d, 0x83, 0xcf, 0xc1, 0xec, 0x8d, 0xd9, 0x70,
+  0x94, 0xe3, 0xf5, 0x5a, 0x2c, 0x22, 0xb0, 0x38, 0xfb, 0x4a, 0x70, 0x23, 0xaf, 0xba, 0xa7, 0xb8,
+  0x36, 0xa6, 0xf3, 0x30, 0x1a, 0x9d, 0x04, 0xc7, 0xec, 0x62, 0x30, 0xcb, 0xa7, 0xc9, 0x5d, 0x92,
+  0x20, 0x65, 0x07, 0x02, 0xfc, 0xaf, 0xd9, 0xb5, 0x4b, 0xbb, 0x7b, 0xe5, 0x44, 0xbb, 0x85, 0xd7,
+  0x44, 0xcb, 0x24, 0x67, 0xdf, 0xe4, 0xc6, 0x8e, 0xcd, 0xad, 0x0f, 0x33, 0x4a, 0x9e, 0x4d, 0xa6,
+  0x18, 0x08, 0xbb, 0x82, 0x29, 0x28, 0x4c, 0x8a, 0xbd, 0x67, 0xb6, 0x77, 0x8b, 0xea, 0x0f, 0xa6,
+  0xb6, 0x1f, 0xbc, 0x42, 0x21, 0xa6, 0xb5, 0x09, 0x5d, 0x13, 0xfe, 0xb3, 0x0a, 0x42, 0x97, 0xde,
+  0x4a, 0x88, 0x76, 0xe1, 0xad, 0xf4, 0x79, 0x26, 0x76, 0x66, 0x0b, 0xf8, 0x6b, 0x48, 0xd9, 0xbc,
+  0x5c, 0x9c, 0x91, 0xbf, 0x83, 0x9c, 0x11, 0xff, 0x08, 0xd5, 0xff, 0x03, 0x65, 0x76, 0x82, 0x17,
+  0x95, 0x4a, 0x00, 0x00,
+};
+
+#endif // INDEX_HTML_H
@@ -0,0 +1,284 @@
+// JsonReader.cpp
+#include "JsonReader.h"
+
+JsonReader::JsonReader(const char *json, size_t len)
+  : begin(json), p(json), end(json + len) {}
+
+bool JsonReader::fail() {
+  err = true;
+  return false;
+}
+
+void JsonReader::skipWs() {
+  while (p < end && (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r')) p++;
+}
+
+bool JsonReader::expect(char c) {
+  skipWs();
+  if (p >= end || *p != c) return fail();
+  p++;
+  return true;
+}
+
+// ===== Объект / массив =====
+bool JsonReader::beginObject() {
+  first = true;
+  return expect('{');
+}
+
+bool JsonReader::beginArray() {
+  first = true;
+  return expect('[');
+}
+
+// Перед очередным элементом: конец контейнера или запятая
+bool JsonReader::separator(char close) {
+  if (err) return false;
+  skipWs();
+  if (p < end && *p == close) {
+    p++;
+    return false;
+  }
+  if (!first && !expect(',')) return false;
+  first = false;
+  return true;
+}
+
+bool JsonReader::nextMember(char *key, size_t keyCap, Value &v) {
+  if (!separator('}')) return false;
+
+  Value k;
+  skipWs();
+  if (!readString(k)) return false;
+  if (!k.copyString(key, keyCap)) markLongKey(k, key, keyCap);
+  if (!expect(':')) return false;
+  return readValue(v);
+}
+
+// Ключ длиннее keyCap (или с неверным escape) не должен совпасть с полем,
+// которое равно его началу: отдаём начало + «…» — такого поля нет, и
+// вызывающий пропустит значение как неизвестное
+void JsonReader::markLongKey(const Value &k, char *key, size_t keyCap) {
+  static const char MARK[] = "\xE2\x80\xA6";   // «…» в UTF-8
+  if (keyCap == 0) return;
+  if (keyCap < sizeof(MARK) + 1) {
+    key[0] = '\0';
+    return;
+  }
+  size_t n = keyCap - sizeof(MARK);
+  if (n > k.len) n = k.len;
+  while (n > 0 && ((uint8_t)k.start[n] & 0xC0) == 0x80) n--;   // не режем символ UTF-8
+  memcpy(key, k.start, n);
+  memcpy(key + n, MARK, sizeof(MARK));
+}
+
+bool JsonReader::nextElement(Value &v) {
+  if (!separator(']')) return false;
+  return readValue(v);
+}
+
+// ===== Значения =====
+bool JsonReader::readValue(Value &v) {
+  skipWs();
+  if (p >= end) return fail();
+
+  v = Value();
+  const char c = *p;
+
+  if (c == '"') return readString(v);
+
+  if (c == '{' || c == '[') {
+    v.type  = c == '{' ? T_OBJECT : T_ARRAY;
+    v.start = p;
+    if (!skipNested(c == '{' ? '}' : ']')) return false;
+    v.len = (size_t)(p - v.start);
+    return true;
+  }
+
+  if (end - p >= 4 && memcmp(p, "true", 4) == 0) {
+    v.type = T_BOOL;
+    v.b    = true;
+    p += 4;
+    return true;
+  }
+  if (end - p >= 5 && memcmp(p, "false", 5) == 0) {
+    v.type = T_BOOL;
+    p += 5;
+    return true;
+  }
+  if (end - p >= 4 && memcmp(p, "null", 4) == 0) {
+    v.type = T_NULL;
+    p += 4;
+    return true;
+  }
+
+  size_t used = 0;
+  if (!parseNumber(p, (size_t)(end - p), v.num, &used)) return fail();
+  v.type  = T_NUMBER;
+  v.start = p;
+  v.len   = used;
+  p += used;
+  return true;
+}
+
+bool JsonReader::readString(Value &v) {
+  if (p >= end || *p != '"') return fail();
+  p++;
+  v.type  = T_STRING;
+  v.start = p;
+  while (p < end && *p != '"') {
+    if (*p == '\\') {
+      p++;
+      if (p >= end) return fail();
+    } else if ((unsigned char)*p < 0x20) {
+      return fail();
+    }
+    p++;
+  }
+  if (p >= end) return fail();
+  v.len = (size_t)(p - v.start);
+  p++;
+  return true;
+}
+
+// Пропуск вложенного объекта/массива с учётом строк
+bool JsonReader::skipNested(char close) {
+  int depth = 0;
+  while (p < end) {
+    char c = *p;
+    if (c == '"') {
+      Value tmp;
+      if (!readString(tmp)) return false;
+      continue;
+    }
+    p++;
+    if (c == '{' || c == '[') depth++;
+    else if (c == '}' || c == ']') {
+      if (--depth == 0) return c == close ? true : fail();
+    }
+  }
+  return fail();
+}
+
+// ===== Числа =====
+// Десятичное число JSON без strtod (та использует кучу в newlib)
+bool JsonReader::parseNumber(const char *s, size_t len, double &out, size_t *used) {
+  const char *q = s;
+  const char *e = s + len;
+  bool neg = false;
+
+  if (q < e && (*q == '-' || *q == '+')) neg = (*q++ == '-');
+  if (q >= e || *q < '0' || *q > '9') {
+    if (!(q < e && *q == '.')) return false;
+  }
+
+  double v = 0.0;
+  bool   digits = false;
+  while (q < e && *q >= '0' && *q <= '9') {
+    v = v * 10.0 + (*q++ - '0');
+    digits = true;
+  }
+  if (q < e && *q == '.') {
+    q++;
+    double scale = 0.1;
+    while (q < e && *q >= '0' && *q <= '9') {
+      v += (*q++ - '0') * scale;
+      scale *= 0.1;
+      digits = true;
+    }
+  }
+  if (!digits) return false;
+
+  if (q < e && (*q == 'e' || *q == 'E')) {
+    q++;
+    bool eneg = false;
+    if (q < e && (*q == '-' || *q == '+')) eneg = (*q++ == '-');
+    if (q >= e || *q < '0' || *q > '9') return false;
+    int ex = 0;
+    while (q < e && *q >= '0' && *q <= '9' && ex < 400) ex = ex * 10 + (*q++ - '0');
+    while (ex-- > 0) v = eneg ? v / 10.0 : v * 10.0;
+  }
+
+  out = neg ? -v : v;
+  if (used) *used = (size_t)(q - s);
+  return true;
+}
+
+bool JsonReader::Value::asNumber(double &out) const {
+  if (type == T_NUMBER) {
+    out = num;
+    return true;
+  }
+  if (type != T_STRING || len == 0) return false;
+
+  // Форма отправляет значения полей строками: "22.5"
+  size_t used = 0;
+  return parseNumber(start, len, out, &used) && used == len;
+}
+
+bool JsonReader::Value::equals(const char *s) const {
+  return type == T_STRING && strlen(s) == len && memcmp(start, s, len) == 0;
+}
+
+static int hexDigit(char c) {
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  return -1;
+}
+
+bool JsonReader::Value::copyString(char *out, size_t cap) const {
+  if (type != T_STRING || cap == 0) return false;
+
+  size_t n = 0;
+  auto put = [&](char c) -> bool {
+    if (n + 1 >= cap) return false;
+    out[n++] = c;
+    return true;
+  };
+
+  for (size_t i = 0; i < len; ++i) {
+    char c = start[i];
+    if (c != '\\') {
+      if (!put(c)) return false;
+      continue;
+    }
+    if (++i >= len) return false;
+    switch (start[i]) {
+      case '"':  c = '"';  break;
+      case '\\': c = '\\'; break;
+      case '/':  c = '/';  break;
+      case 'b':  c = '\b'; break;
+      case 'f':  c = '\f'; break;
+      case 'n':  c = '\n'; break;
+      case 'r':  c = '\r'; break;
+      case 't':  c = '\t'; break;
+      case 'u': {
+        if (i + 4 >= len) return false;
+        uint32_t cp = 0;
+        for (uint8_t k = 1; k <= 4; ++k) {
+          int h = hexDigit(start[i + k]);
+          if (h < 0) return false;
+          cp = (cp << 4) | (uint32_t)h;
+        }
+        i += 4;
+        if (cp == 0) return false;   // \u0000 обрезал бы строку: "ms\u0000x" == "ms"
+        // UTF-8 (суррогатные пары не склеиваем — в настройках их не бывает)
+        if (cp < 0x80) {
+          if (!put((char)cp)) return false;
+        } else if (cp < 0x800) {
+          if (!put((char)(0xC0 | (cp >> 6))) || !put((char)(0x80 | (cp & 0x3F)))) return false;
+        } else {
+          if (!put((char)(0xE0 | (cp >> 12))) || !put((char)(0x80 | ((cp >> 6) & 0x3F))) ||
+              !put((char)(0x80 | (cp & 0x3F)))) return false;
+        }
+        continue;
+      }
+      default:
+        return false;
+    }
+    if (!put(c)) return false;
+  }
+  out[n] = '\0';
+  return true;
+}
@@ -0,0 +1,63 @@
+// JsonReader.h
+#ifndef JSON_READER_H
+#define JSON_READER_H
+
+#include <Arduino.h>
+
+// Однопроходный разбор JSON-тела запроса без кучи.
+// Читает объект по парам «ключ — значение» (nextMember) или массив
+// по элементам (nextElement). Строки и вложенные объекты/массивы
+// не копируются: Value указывает на исходный текст, вложенное значение
+// разбирается отдельным JsonReader по его диапазону.
+class JsonReader {
+public:
+  enum Type : uint8_t { T_NONE = 0, T_STRING, T_NUMBER, T_BOOL, T_NULL, T_OBJECT, T_ARRAY };
+
+  struct Value {
+    Type        type  = T_NONE;
+    const char *start = nullptr;   // строка — без кавычек; объект/массив — со скобками
+    size_t      len   = 0;
+    double      num   = 0.0;
+    bool        b     = false;
+
+    // Число: T_NUMBER или строка, целиком записанная числом ("22.5")
+    bool asNumber(double &out) const;
+    // Строка с разбором escape-последовательностей; false — не строка или не влезла
+    bool copyString(char *out, size_t cap) const;
+    // Сравнение строкового значения без копирования (без escape)
+    bool equals(const char *s) const;
+  };
+
+  JsonReader(const char *json, size_t len);
+
+  bool beginObject();
+  // false — объект закончился или ошибка (см. failed()).
+  // Ключ, не влезший в keyCap, приходит как «начало…» и ни с чем не совпадает
+  bool nextMember(char *key, size_t keyCap, Value &v);
+
+  bool beginArray();
+  bool nextElement(Value &v);
+
+  bool   failed() const    { return err; }
+  size_t errorPos() const  { return (size_t)(p - begin); }
+
+  static bool parseNumber(const char *s, size_t len, double &out, size_t *used = nullptr);
+
+private:
+  const char *begin;
+  const char *p;
+  const char *end;
+  bool        err   = false;
+  bool        first = true;
+
+  void skipWs();
+  bool expect(char c);
+  bool fail();
+  bool readValue(Value &v);
+  bool readString(Value &v);
+  static void markLongKey(const Value &k, char *key, size_t keyCap);
+  bool skipNested(char close);
+  bool separator(char close);
+};
+
+#endif // JSON_READER_H
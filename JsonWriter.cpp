@@ -0,0 +1,227 @@
+// JsonWriter.cpp
+#include "JsonWriter.h"
+#include <math.h>
+
+static const uint32_t POW10[] = {1, 10, 100, 1000, 10000, 100000, 1000000};
+
+JsonWriter::JsonWriter(char *buffer, size_t capacity) : buf(buffer), cap(capacity) {
+  if (cap > 0) buf[0] = '\0';
+}
+
+void JsonWriter::clearBuffer() {
+  len = 0;
+  if (cap > 0) buf[0] = '\0';
+}
+
+// ===== Низкий уровень =====
+void JsonWriter::put(char c) {
+  if (len + 1 >= cap) {
+    overflowed = true;
+    return;
+  }
+  buf[len++] = c;
+  buf[len]   = '\0';
+}
+
+void JsonWriter::put(const char *s, size_t n) {
+  if (len + n >= cap) {
+    overflowed = true;
+    return;
+  }
+  memcpy(buf + len, s, n);
+  len += n;
+  buf[len] = '\0';
+}
+
+void JsonWriter::putEscaped(const char *s) {
+  static const char HEX_DIGITS[] = "0123456789abcdef";
+  for (; *s; ++s) {
+    unsigned char c = (unsigned char)*s;
+    switch (c) {
+      case '"':  put("\\\"", 2); break;
+      case '\\': put("\\\\", 2); break;
+      case '\n': put("\\n", 2);  break;
+      case '\r': put("\\r", 2);  break;
+      case '\t': put("\\t", 2);  break;
+      default:
+        if (c < 0x20) {
+          char u[6] = {'\\', 'u', '0', '0', HEX_DIGITS[c >> 4], HEX_DIGITS[c & 0x0F]};
+          put(u, sizeof(u));
+        } else {
+          put((char)c);      // UTF-8 проходит как есть
+        }
+    }
+  }
+}
+
+// Запятая перед элементом, если он не первый на своём уровне
+void JsonWriter::separator() {
+  if (afterKey) {
+    afterKey = false;
+    return;
+  }
+  uint32_t bit = 1UL << depth;
+  if (firstMask & bit) firstMask &= ~bit;
+  else                 put(',');
+}
+
+void JsonWriter::open(char c) {
+  separator();
+  put(c);
+  if (depth + 1 < MAX_DEPTH) depth++;
+  else                       overflowed = true;
+  firstMask |= 1UL << depth;
+}
+
+void JsonWriter::close(char c) {
+  if (depth > 0) depth--;
+  put(c);
+}
+
+// ===== Структура =====
+JsonWriter &JsonWriter::beginObject() { open('{');  return *this; }
+JsonWriter &JsonWriter::endObject()   { close('}'); return *this; }
+JsonWriter &JsonWriter::beginArray()  { open('[');  return *this; }
+JsonWriter &JsonWriter::endArray()    { close(']'); return *this; }
+
+JsonWriter &JsonWriter::key(const char *k) {
+  separator();
+  put('"');
+  putEscaped(k);
+  put("\":", 2);
+  afterKey = true;
+  return *this;
+}
+
+// ===== Значения =====
+JsonWriter &JsonWriter::value(const char *s) {
+  separator();
+  put('"');
+  putEscaped(s ? s : "");
+  put('"');
+  return *this;
+}
+
+JsonWriter &JsonWriter::value(bool b) {
+  separator();
+  if (b) put("true", 4);
+  else   put("false", 5);
+  return *this;
+}
+
+JsonWriter &JsonWriter::value(unsigned long v) {
+  char tmp[12];
+  separator();
+  put(tmp, formatUnsigned(tmp, v));
+  return *this;
+}
+
+JsonWriter &JsonWriter::value(long v) {
+  char tmp[12];
+  separator();
+  if (v < 0) {
+    put('-');
+    put(tmp, formatUnsigned(tmp, 0UL - (unsigned long)v));
+  } else {
+    put(tmp, formatUnsigned(tmp, (unsigned long)v));
+  }
+  return *this;
+}
+
+JsonWriter &JsonWriter::value(int v)          { return value((long)v); }
+JsonWriter &JsonWriter::value(unsigned int v) { return value((unsigned long)v); }
+
+JsonWriter &JsonWriter::value(float v, uint8_t decimals) {
+  char   tmp[24];
+  size_t n = formatFloat(tmp, sizeof(tmp), v, decimals);
+  if (n == 0) return nullValue();
+  separator();
+  put(tmp, n);
+  return *this;
+}
+
+JsonWriter &JsonWriter::nullValue() {
+  separator();
+  put("null", 4);
+  return *this;
+}
+
+// ===== Строка по частям =====
+JsonWriter &JsonWriter::beginString() {
+  separator();
+  put('"');
+  return *this;
+}
+
+JsonWriter &JsonWriter::stringPart(const char *s) {
+  putEscaped(s);
+  return *this;
+}
+
+JsonWriter &JsonWriter::stringPart(float v, uint8_t decimals) {
+  char   tmp[24];
+  size_t n = formatFloat(tmp, sizeof(tmp), v, decimals);
+  if (n == 0) put("nan", 3);
+  else        put(tmp, n);
+  return *this;
+}
+
+JsonWriter &JsonWriter::stringPart(unsigned long v) {
+  char tmp[12];
+  put(tmp, formatUnsigned(tmp, v));
+  return *this;
+}
+
+JsonWriter &JsonWriter::endString() {
+  put('"');
+  return *this;
+}
+
+// ===== Форматирование чисел =====
+size_t JsonWriter::formatUnsigned(char *out, unsigned long v) {
+  char   rev[11];
+  size_t n = 0;
+  do {
+    rev[n++] = (char)('0' + v % 10);
+    v /= 10;
+  } while (v);
+  for (size_t i = 0; i < n; ++i) out[i] = rev[n - 1 - i];
+  return n;
+}
+
+size_t JsonWriter::formatFloat(char *out, size_t outCap, float v, uint8_t decimals) {
+  if (isnan(v) || isinf(v)) return 0;
+  if (decimals > 6) decimals = 6;
+
+  double a = fabs((double)v);
+  if (a >= 1e12) return 0;
+
+  uint64_t scaled = (uint64_t)(a * POW10[decimals] + 0.5);
+  uint64_t ip     = scaled / POW10[decimals];
+  uint32_t fp     = (uint32_t)(scaled % POW10[decimals]);
+
+  char   tmp[24];
+  size_t n = 0;
+  if (v < 0.0f && scaled != 0) tmp[n++] = '-';
+
+  char   rev[20];
+  size_t r = 0;
+  do {
+    rev[r++] = (char)('0' + (uint8_t)(ip % 10));
+    ip /= 10;
+  } while (ip);
+  while (r) tmp[n++] = rev[--r];
+
+  if (decimals > 0) {
+    tmp[n++] = '.';
+    for (int8_t d = decimals - 1; d >= 0; --d) {
+      tmp[n + d] = (char)('0' + fp % 10);
+      fp /= 10;
+    }
+    n += decimals;
+  }
+
+  if (n > outCap) return 0;
+  memcpy(out, tmp, n);
+  return n;
+}
@@ -0,0 +1,72 @@
+// JsonWriter.h
+#ifndef JSON_WRITER_H
+#define JSON_WRITER_H
+
+#include <Arduino.h>
+
+// Потоковый писатель JSON в буфер вызывающего (стек или статический),
+// без кучи. Запятые расставляет сам, строки экранирует, float выводит
+// с фиксированным числом знаков без printf/dtoa; NaN и ±Inf — null.
+// При нехватке места запись прекращается и выставляется overflow().
+// clearBuffer() сбрасывает накопленные байты, но не вложенность — так
+// документ уходит частями (chunked), см. jsonResponse в WebInterface.cpp.
+class JsonWriter {
+public:
+  static constexpr uint8_t MAX_DEPTH = 16;
+
+  JsonWriter(char *buffer, size_t capacity);
+
+  JsonWriter &beginObject();
+  JsonWriter &endObject();
+  JsonWriter &beginArray();
+  JsonWriter &endArray();
+  JsonWriter &key(const char *k);
+
+  JsonWriter &value(const char *s);
+  JsonWriter &value(bool b);
+  JsonWriter &value(int v);
+  JsonWriter &value(unsigned int v);
+  JsonWriter &value(long v);
+  JsonWriter &value(unsigned long v);
+  JsonWriter &value(float v, uint8_t decimals);
+  JsonWriter &nullValue();
+
+  // Длинная строка по частям (текст диагностики)
+  JsonWriter &beginString();
+  JsonWriter &stringPart(const char *s);
+  JsonWriter &stringPart(float v, uint8_t decimals);
+  JsonWriter &stringPart(unsigned long v);
+  JsonWriter &endString();
+
+  template <typename T>
+  JsonWriter &field(const char *k, T v)                        { key(k); return value(v); }
+  JsonWriter &field(const char *k, float v, uint8_t decimals)  { key(k); return value(v, decimals); }
+
+  const char *c_str() const     { return buf; }
+  size_t      length() const    { return len; }
+  size_t      remaining() const { return cap - 1 - len; }
+  bool        overflow() const  { return overflowed; }
+  void        clearBuffer();
+
+  // Число с фиксированной точкой в out (без '\0' в счёте); 0 — NaN/Inf/слишком большое
+  static size_t formatFloat(char *out, size_t outCap, float v, uint8_t decimals);
+  static size_t formatUnsigned(char *out, unsigned long v);
+
+private:
+  char    *buf;
+  size_t   cap;
+  size_t   len        = 0;
+  bool     overflowed = false;
+  bool     afterKey   = false;
+  uint8_t  depth      = 0;
+  uint32_t firstMask  = 1;   // бит d — на уровне d ещё не было элементов
+
+  void put(char c);
+  void put(const char *s, size_t n);
+  void putEscaped(const char *s);
+  void separator();
+  void open(char c);
+  void close(char c);
+};
+
+#endif // JSON_WRITER_H
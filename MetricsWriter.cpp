@@ -0,0 +1,114 @@
+// MetricsWriter.cpp
+#include "MetricsWriter.h"
+#include "JsonWriter.h"
+
+MetricsWriter::MetricsWriter(char *buffer, size_t capacity) : buf(buffer), cap(capacity) {
+  if (cap > 0) buf[0] = '\0';
+}
+
+void MetricsWriter::clearBuffer() {
+  len = 0;
+  if (cap > 0) buf[0] = '\0';
+}
+
+void MetricsWriter::put(char c) {
+  put(&c, 1);
+}
+
+void MetricsWriter::put(const char *s) {
+  put(s, strlen(s));
+}
+
+void MetricsWriter::put(const char *s, size_t n) {
+  if (len + n >= cap) {
+    overflowed = true;
+    return;
+  }
+  memcpy(buf + len, s, n);
+  len += n;
+  buf[len] = '\0';
+}
+
+MetricsWriter &MetricsWriter::family(const char *name, const char *type, const char *help) {
+  put("# HELP ");
+  put(name);
+  put(' ');
+  put(help);
+  put("\n# TYPE ");
+  put(name);
+  put(' ');
+  put(type);
+  put('\n');
+  return *this;
+}
+
+MetricsWriter &MetricsWriter::metric(const char *name, const char *suffix) {
+  put(name);
+  if (suffix) put(suffix);
+  inLabels = false;
+  return *this;
+}
+
+void MetricsWriter::labelKey(const char *key) {
+  put(inLabels ? ',' : '{');
+  inLabels = true;
+  put(key);
+  put("=\"", 2);
+}
+
+// Значения меток — имена из таблиц прошивки, экранировать нечего
+MetricsWriter &MetricsWriter::label(const char *key, const char *val) {
+  labelKey(key);
+  put(val);
+  put('"');
+  return *this;
+}
+
+MetricsWriter &MetricsWriter::label(const char *key, unsigned long val) {
+  char tmp[12];
+  labelKey(key);
+  put(tmp, JsonWriter::formatUnsigned(tmp, val));
+  put('"');
+  return *this;
+}
+
+MetricsWriter &MetricsWriter::labelInf(const char *key) {
+  labelKey(key);
+  put("+Inf\"", 5);
+  return *this;
+}
+
+void MetricsWriter::endSample() {
+  if (inLabels) put('}');
+  inLabels = false;
+  put(' ');
+}
+
+void MetricsWriter::value(float v, uint8_t decimals) {
+  char   tmp[24];
+  size_t n = JsonWriter::formatFloat(tmp, sizeof(tmp), v, decimals);
+  endSample();
+  if (n == 0) put("NaN", 3);
+  else        put(tmp, n);
+  put('\n');
+}
+
+void MetricsWriter::value(unsigned long v) {
+  char tmp[12];
+  endSample();
+  put(tmp, JsonWriter::formatUnsigned(tmp, v));
+  put('\n');
+}
+
+void MetricsWriter::value(unsigned long long v) {
+  char   rev[20];
+  size_t n = 0;
+  do {
+    rev[n++] = (char)('0' + (uint8_t)(v % 10));
+    v /= 10;
+  } while (v);
+
+  endSample();
+  while (n) put(rev[--n]);
+  put('\n');
+}
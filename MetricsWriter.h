@@ -0,0 +1,48 @@
+// MetricsWriter.h
+#ifndef METRICS_WRITER_H
+#define METRICS_WRITER_H
+
+#include <Arduino.h>
+
+// Текстовый формат Prometheus в буфер вызывающего, без кучи:
+//   w.family("greenhouse_relay_switches_total", "counter", "Переключения реле");
+//   w.metric("greenhouse_relay_switches_total").label("device", "pump").value(12UL);
+// Как и JsonWriter, при нехватке места пишет overflow(), а clearBuffer()
+// позволяет отдавать ответ порциями (chunkedResponse в WebInterface.cpp).
+class MetricsWriter {
+public:
+  MetricsWriter(char *buffer, size_t capacity);
+
+  // # HELP и # TYPE
+  MetricsWriter &family(const char *name, const char *type, const char *help);
+
+  // Имя (+ суффикс, например "_bucket"), затем метки и значение
+  MetricsWriter &metric(const char *name, const char *suffix = nullptr);
+  MetricsWriter &label(const char *key, const char *val);
+  MetricsWriter &label(const char *key, unsigned long val);
+  MetricsWriter &labelInf(const char *key);   // le="+Inf"
+
+  void value(float v, uint8_t decimals);      // NaN → NaN
+  void value(unsigned long v);
+  void value(unsigned long long v);
+
+  const char *c_str() const    { return buf; }
+  size_t      length() const   { return len; }
+  bool        overflow() const { return overflowed; }
+  void        clearBuffer();
+
+private:
+  char   *buf;
+  size_t  cap;
+  size_t  len        = 0;
+  bool    overflowed = false;
+  bool    inLabels   = false;
+
+  void put(char c);
+  void put(const char *s);
+  void put(const char *s, size_t n);
+  void labelKey(const char *key);
+  void endSample();
+};
+
+#endif // METRICS_WRITER_H
@@ -0,0 +1,67 @@
+// Perf.cpp
+#include "Perf.h"
+
+namespace Perf {
+
+static Histogram    g_hist[CHANNEL_COUNT];
+static portMUX_TYPE g_mux = portMUX_INITIALIZER_UNLOCKED;
+
+static const char* const CHANNEL_NAMES[CHANNEL_COUNT] = {
+  "sensors", "actuators", "automation", "display", "web_http", "web_sse", "web_ttfb", "telegram", "telegram_cmd"
+};
+
+void Histogram::record(uint32_t us) {
+  uint8_t b = (uint8_t)(31 - __builtin_clz(us | 1));
+  if (b >= BUCKETS) b = BUCKETS - 1;
+
+  buckets[b]++;
+  count++;
+  sumUs += us;
+  if (us > maxUs) maxUs = us;
+}
+
+uint32_t Histogram::percentileUs(uint8_t pct) const {
+  if (count == 0) return 0;
+
+  uint32_t target = (uint32_t)(((uint64_t)count * pct + 99) / 100);
+  uint32_t acc    = 0;
+  for (uint8_t b = 0; b < BUCKETS; ++b) {
+    acc += buckets[b];
+    if (acc >= target) {
+      uint32_t upper = 1UL << (b + 1);
+      return upper < maxUs ? upper : maxUs;
+    }
+  }
+  return maxUs;
+}
+
+void record(Channel ch, uint32_t us) {
+  if (ch >= CHANNEL_COUNT) return;
+  portENTER_CRITICAL(&g_mux);
+  g_hist[ch].record(us);
+  portEXIT_CRITICAL(&g_mux);
+}
+
+// Копия целиком: 64-битная сумма и корзины согласованы между собой
+Histogram snapshot(Channel ch) {
+  Histogram h;
+  if (ch >= CHANNEL_COUNT) return h;
+  portENTER_CRITICAL(&g_mux);
+  h = g_hist[ch];
+  portEXIT_CRITICAL(&g_mux);
+  return h;
+}
+
+const char *channelName(Channel ch) {
+  return ch < CHANNEL_COUNT ? CHANNEL_NAMES[ch] : "?";
+}
+
+void reset() {
+  portENTER_CRITICAL(&g_mux);
+  for (uint8_t i = 0; i < CHANNEL_COUNT; ++i) {
+    g_hist[i] = Histogram();
+  }
+  portEXIT_CRITICAL(&g_mux);
+}
+
+} // namespace Perf
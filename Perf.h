@@ -0,0 +1,63 @@
+// Perf.h
+#ifndef PERF_H
+#define PERF_H
+
+#include "Config.h"
+#include <esp_timer.h>
+
+// Постоянно включённая дешёвая инструментовка:
+// esp_timer (мкс, общий для обоих ядер) + гистограмма log2 на каждую подсистему.
+// Запись, сброс и снимок — под спинлоком: каналы пишут разные задачи на разных ядрах.
+namespace Perf {
+  enum Channel : uint8_t {
+    SENSORS = 0,   // запуск/сбор преобразований датчиков (Devices)
+    ACTUATORS,     // Devices::loop() — насос, дверь
+    AUTOMATION,
+    DISPLAY,
+    WEB_HTTP,      // обработчики маршрутов (задача async_tcp)
+    WEB_SSE,       // рассылка /api/stream (задача web)
+    WEB_TTFB,      // потоковый ответ: от создания до первых байт тела (async_tcp)
+    TELEGRAM,      // задержка getUpdates (задача tg_rx), кроме пустых long poll
+    TELEGRAM_CMD,  // выполнение принятых команд (задача telegram)
+    CHANNEL_COUNT
+  };
+
+  // Корзина k: [2^k, 2^(k+1)) мкс, последняя — всё, что дольше ~8 с
+  constexpr uint8_t BUCKETS = 24;
+
+  struct Histogram {
+    uint32_t buckets[BUCKETS] = {0};
+    uint32_t count = 0;
+    uint32_t maxUs = 0;
+    uint64_t sumUs = 0;
+
+    void     record(uint32_t us);
+    uint32_t percentileUs(uint8_t pct) const; // верхняя граница корзины
+    uint32_t avgUs() const { return count ? (uint32_t)(sumUs / count) : 0; }
+  };
+
+  void        record(Channel ch, uint32_t us);
+  Histogram   snapshot(Channel ch);
+  const char *channelName(Channel ch);
+  void        reset();
+
+  // Счётчик тактов у каждого ядра свой, а задача может переехать
+  // на другое ядро посреди замера — поэтому esp_timer
+  inline int64_t nowUs() { return esp_timer_get_time(); }
+}
+
+// RAII-замер участка кода
+class PerfScope {
+public:
+  explicit PerfScope(Perf::Channel ch) : channel(ch), start(Perf::nowUs()) {}
+  ~PerfScope() { Perf::record(channel, (uint32_t)(Perf::nowUs() - start)); }
+
+  PerfScope(const PerfScope &) = delete;
+  PerfScope &operator=(const PerfScope &) = delete;
+
+private:
+  Perf::Channel channel;
+  int64_t       start;
+};
+
+#endif // PERF_H
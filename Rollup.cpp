@@ -0,0 +1,135 @@
+// Rollup.cpp
+#include "Rollup.h"
+
+Rollup g_rollup;
+
+static const uint16_t LEVEL_CAP[Rollup::LEVEL_COUNT]    = {Rollup::CAP_1M, Rollup::CAP_15M, Rollup::CAP_1H};
+static const uint16_t LEVEL_OFFSET[Rollup::LEVEL_COUNT] = {0, Rollup::CAP_1M, Rollup::CAP_1M + Rollup::CAP_15M};
+static const uint32_t LEVEL_SEC[Rollup::LEVEL_COUNT]    = {60, 15 * 60, 60 * 60};
+
+uint16_t Rollup::capacity(Level lv) const     { return LEVEL_CAP[lv]; }
+uint32_t Rollup::resolutionSec(Level lv) const { return LEVEL_SEC[lv]; }
+
+uint16_t Rollup::filled(Level lv) const {
+  portENTER_CRITICAL(&mux);
+  uint16_t n = used[lv];
+  portEXIT_CRITICAL(&mux);
+  return n;
+}
+
+const char *Rollup::levelName(Level lv) {
+  switch (lv) {
+    case LEVEL_1M:  return "1m";
+    case LEVEL_15M: return "15m";
+    case LEVEL_1H:  return "1h";
+    default:        return "?";
+  }
+}
+
+bool Rollup::parseLevel(const String &s, Level &out) {
+  for (uint8_t i = 0; i < LEVEL_COUNT; ++i) {
+    if (s == levelName((Level)i)) {
+      out = (Level)i;
+      return true;
+    }
+  }
+  return false;
+}
+
+void Rollup::clearSlot(uint16_t slot) {
+  for (uint8_t c = 0; c < Channels::COUNT; ++c) {
+    counts[c][slot] = 0;
+    sums[c][slot]   = 0.0f;
+  }
+}
+
+// Переход к корзине id; пропущенные (пауза в данных) очищаются,
+// но не больше ёмкости кольца — поэтому O(1) в среднем
+void Rollup::advance(Level lv, uint32_t id) {
+  uint16_t cap = LEVEL_CAP[lv];
+  uint16_t off = LEVEL_OFFSET[lv];
+
+  if (used[lv] == 0) {
+    bucketId[lv] = id;
+    head[lv]     = 0;
+    used[lv]     = 1;
+    clearSlot(off);
+    return;
+  }
+
+  uint32_t steps = id - bucketId[lv];
+  if (steps == 0) return;
+  if (steps > cap) steps = cap;
+
+  for (uint32_t k = 0; k < steps; ++k) {
+    head[lv] = (uint16_t)((head[lv] + 1) % cap);
+    clearSlot(off + head[lv]);
+    if (used[lv] < cap) used[lv]++;
+  }
+  bucketId[lv] = id;
+}
+
+void Rollup::add(const SensorData &sd, uint32_t uptimeSec) {
+  portENTER_CRITICAL(&mux);
+  for (uint8_t l = 0; l < LEVEL_COUNT; ++l) {
+    Level lv = (Level)l;
+    advance(lv, uptimeSec / LEVEL_SEC[lv]);
+
+    uint16_t slot = LEVEL_OFFSET[lv] + head[lv];
+    for (uint8_t c = 0; c < Channels::COUNT; ++c) {
+      float v = Channels::value(sd, c);
+      if (isnan(v)) continue;
+
+      if (counts[c][slot] == 0) {
+        mins[c][slot] = v;
+        maxs[c][slot] = v;
+      } else {
+        if (v < mins[c][slot]) mins[c][slot] = v;
+        if (v > maxs[c][slot]) maxs[c][slot] = v;
+      }
+      sums[c][slot] += v;
+      if (counts[c][slot] < 0xFFFF) counts[c][slot]++;
+    }
+  }
+  portEXIT_CRITICAL(&mux);
+}
+
+bool Rollup::bucket(Level lv, uint8_t ch, uint16_t age, Stat &out) const {
+  out = Stat();
+  if (ch >= Channels::COUNT || lv >= LEVEL_COUNT) return false;
+
+  uint16_t cap = LEVEL_CAP[lv];
+
+  portENTER_CRITICAL(&mux);
+  bool ok = age < used[lv];
+  if (ok) {
+    uint16_t slot = LEVEL_OFFSET[lv] + (uint16_t)((head[lv] + cap - age) % cap);
+    uint16_t n    = counts[ch][slot];
+    if (n > 0) {
+      out.min   = mins[ch][slot];
+      out.max   = maxs[ch][slot];
+      out.avg   = sums[ch][slot] / n;
+      out.count = n;
+    }
+  }
+  portEXIT_CRITICAL(&mux);
+  return ok;
+}
+
+Rollup::Stat Rollup::window(Level lv, uint8_t ch, uint16_t n) const {
+  Stat  res;
+  float sum = 0.0f;
+
+  for (uint16_t age = 0; age < n; ++age) {
+    Stat b;
+    if (!bucket(lv, ch, age, b)) break;
+    if (b.count == 0) continue;
+
+    if (res.count == 0 || b.min < res.min) res.min = b.min;
+    if (res.count == 0 || b.max > res.max) res.max = b.max;
+    sum       += b.avg * b.count;
+    res.count += b.count;
+  }
+  if (res.count > 0) res.avg = sum / res.count;
+  return res;
+}
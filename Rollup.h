@@ -0,0 +1,64 @@
+// Rollup.h
+#ifndef ROLLUP_H
+#define ROLLUP_H
+
+#include "Config.h"
+
+// Сводки в RAM по всем каналам на трёх разрешениях:
+//   1 мин × 60 (последний час), 15 мин × 96 (сутки), 1 ч × 168 (неделя).
+// Хранение — структура массивов: min/max/sum/count отдельными кольцами.
+// add() — O(1) на уровень, запросы не выделяют память.
+class Rollup {
+public:
+  enum Level : uint8_t { LEVEL_1M = 0, LEVEL_15M, LEVEL_1H, LEVEL_COUNT };
+
+  static constexpr uint16_t CAP_1M  = 60;
+  static constexpr uint16_t CAP_15M = 96;
+  static constexpr uint16_t CAP_1H  = 168;
+
+  struct Stat {
+    float    min   = NAN;
+    float    max   = NAN;
+    float    avg   = NAN;
+    uint32_t count = 0;
+  };
+
+  // Задача управления: каждое завершённое измерение. uptimeSec — от
+  // esp_timer (64 бита), а не millis(): переполнение millis() через 49,7
+  // суток сбросило бы все уровни и сдвинуло границы корзин
+  void add(const SensorData &sd, uint32_t uptimeSec);
+
+  // age = 0 — текущая (незавершённая) корзина, 1 — предыдущая и т.д.
+  bool bucket(Level lv, uint8_t ch, uint16_t age, Stat &out) const;
+
+  // Сводка по последним n корзинам (включая текущую)
+  Stat window(Level lv, uint8_t ch, uint16_t n) const;
+
+  uint16_t       capacity(Level lv) const;
+  uint16_t       filled(Level lv) const;
+  uint32_t       resolutionSec(Level lv) const;
+  static const char *levelName(Level lv);
+  static bool    parseLevel(const String &s, Level &out);
+
+private:
+  static constexpr uint16_t TOTAL   = CAP_1M + CAP_15M + CAP_1H;
+
+  // Структура массивов: [канал][слот], слоты уровней идут подряд
+  float    mins[Channels::COUNT][TOTAL];
+  float    maxs[Channels::COUNT][TOTAL];
+  float    sums[Channels::COUNT][TOTAL];
+  uint16_t counts[Channels::COUNT][TOTAL];
+
+  uint16_t head[LEVEL_COUNT]     = {0};
+  uint16_t used[LEVEL_COUNT]     = {0};
+  uint32_t bucketId[LEVEL_COUNT] = {0};
+
+  mutable portMUX_TYPE mux = portMUX_INITIALIZER_UNLOCKED;
+
+  void clearSlot(uint16_t slot);
+  void advance(Level lv, uint32_t id);
+};
+
+extern Rollup g_rollup;
+
+#endif // ROLLUP_H
@@ -0,0 +1,122 @@
+// Runtime.cpp
+#include "Runtime.h"
+#include "WebInterface.h"
+#include "WifiManager.h"
+#include "TelegramBotHandler.h"
+#include "SensorStore.h"
+#include "HistoryStore.h"
+
+Runtime g_runtime;
+
+void Runtime::begin() {
+  controlMutex = xSemaphoreCreateRecursiveMutex();
+
+  xTaskCreatePinnedToCore(controlTask, "control",
+                          Tasks::CONTROL_STACK, this,
+                          Tasks::CONTROL_PRIORITY,
+                          &controlTaskHandle, Tasks::CONTROL_CORE);
+
+  xTaskCreatePinnedToCore(webTask, "web",
+                          Tasks::WEB_STACK, this,
+                          Tasks::WEB_PRIORITY,
+                          &webTaskHandle, Tasks::NET_CORE);
+
+  xTaskCreatePinnedToCore(telegramTask, "telegram",
+                          Tasks::TELEGRAM_STACK, this,
+                          Tasks::TELEGRAM_PRIORITY,
+                          &telegramTaskHandle, Tasks::NET_CORE);
+
+  xTaskCreatePinnedToCore(telegramRxTask, "tg_rx",
+                          Tasks::TELEGRAM_RX_STACK, this,
+                          Tasks::TELEGRAM_RX_PRIORITY,
+                          &telegramRxHandle, Tasks::NET_CORE);
+
+  xTaskCreatePinnedToCore(historyTask, "history",
+                          Tasks::HISTORY_STACK, this,
+                          Tasks::HISTORY_PRIORITY,
+                          &historyTaskHandle, Tasks::NET_CORE);
+
+  Serial.println(F("🧵 Задачи запущены: control@1, web@0, telegram@0, tg_rx@0, history@0"));
+}
+
+void Runtime::lockControl() {
+  if (!controlMutex) return;
+  xSemaphoreTakeRecursive(controlMutex, portMAX_DELAY);
+}
+
+void Runtime::unlockControl() {
+  if (!controlMutex) return;
+  xSemaphoreGiveRecursive(controlMutex);
+}
+
+void Runtime::resetControlStats() {
+  ctlMaxUs    = 0;
+  ctlMaxGapUs = 0;
+  g_scheduler.resetStats();
+}
+
+// ===== Задача управления =====
+void Runtime::controlTask(void *arg) {
+  Runtime *self = static_cast<Runtime*>(arg);
+  g_scheduler.attachTask(xTaskGetCurrentTaskHandle());
+  uint32_t lastStart = micros();
+
+  for (;;) {
+    uint32_t      start = micros();
+    unsigned long waitMs;
+
+    uint32_t gap = start - lastStart;
+    lastStart    = start;
+    if (self->ctlIterations > 0 && gap > self->ctlMaxGapUs) {
+      self->ctlMaxGapUs = gap;
+    }
+
+    {
+      ControlLock lock;
+      waitMs = g_scheduler.runDue();
+      // Изменения (в т.ч. от сетевых команд) — в снимок для читателей
+      g_sensorStore.publishIfChanged(g_sensorData);
+    }
+
+    uint32_t took = micros() - start;
+    self->ctlLastUs = took;
+    if (took > self->ctlMaxUs) self->ctlMaxUs = took;
+    self->ctlIterations++;
+
+    // Спим ровно до ближайшего дедлайна (или до wake())
+    g_scheduler.sleep(waitMs);
+  }
+}
+
+// ===== Сетевые задачи =====
+void Runtime::webTask(void *arg) {
+  (void)arg;
+  for (;;) {
+    g_wifi.loop();
+    g_web.loop();
+    vTaskDelay(pdMS_TO_TICKS(Tasks::WEB_PERIOD_MS));
+  }
+}
+
+void Runtime::telegramTask(void *arg) {
+  Runtime *self = static_cast<Runtime*>(arg);
+  Scheduler &jobs = self->telegramJobs;
+  jobs.attachTask(xTaskGetCurrentTaskHandle());
+
+  for (;;) {
+    jobs.sleep(jobs.runDue());
+  }
+}
+
+// Приём Telegram: long polling блокируется на десятки секунд, поэтому —
+// отдельная задача, которая только передаёт сообщения в очередь
+void Runtime::telegramRxTask(void *arg) {
+  (void)arg;
+  g_telegram.receiveLoop();
+}
+
+// Запись журнала: задача управления только ставит снимок в очередь
+void Runtime::historyTask(void *arg) {
+  (void)arg;
+  g_history.writerLoop();
+}
@@ -0,0 +1,72 @@
+// Runtime.h
+#ifndef RUNTIME_H
+#define RUNTIME_H
+
+#include "Config.h"
+#include "Scheduler.h"
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+
+// Многозадачная среда выполнения:
+//  - задача управления (ядро 1, высокий приоритет) выполняет задачи
+//    g_scheduler и спит до ближайшего дедлайна;
+//  - задачи Web и Telegram (ядро 0, низкий приоритет) не мешают насосу и двери;
+//  - журнал пишет во флеш своя задача history (ядро 0), а не задача управления.
+class Runtime {
+public:
+  void begin();
+
+  // Мьютекс управления: всё, что трогает g_devices / g_settings из сетевых
+  // задач, должно выполняться под ним (см. ControlLock).
+  void lockControl();
+  void unlockControl();
+
+  // Статистика задачи управления (мкс)
+  uint32_t controlLastUs()  const { return ctlLastUs; }
+  uint32_t controlMaxUs()   const { return ctlMaxUs; }
+  // Худший интервал между началами итераций — столько насос и дверь
+  // оставались без присмотра (при исправной работе — не больше периода
+  // задачи actuators)
+  uint32_t controlMaxGapUs() const { return ctlMaxGapUs; }
+  uint32_t controlIterations() const { return ctlIterations; }
+  void     resetControlStats();
+
+  // Планировщик сетевой задачи Telegram (опрос, проверка аварий)
+  Scheduler &telegramScheduler() { return telegramJobs; }
+
+private:
+  SemaphoreHandle_t controlMutex = nullptr;
+  Scheduler         telegramJobs;
+
+  TaskHandle_t controlTaskHandle  = nullptr;
+  TaskHandle_t webTaskHandle      = nullptr;
+  TaskHandle_t telegramTaskHandle = nullptr;
+  TaskHandle_t telegramRxHandle   = nullptr;
+  TaskHandle_t historyTaskHandle  = nullptr;
+
+  volatile uint32_t ctlLastUs     = 0;
+  volatile uint32_t ctlMaxUs      = 0;
+  volatile uint32_t ctlMaxGapUs   = 0;
+  volatile uint32_t ctlIterations = 0;
+
+  static void controlTask(void *arg);
+  static void webTask(void *arg);
+  static void telegramTask(void *arg);
+  static void telegramRxTask(void *arg);
+  static void historyTask(void *arg);
+};
+
+extern Runtime g_runtime;
+
+// RAII-обёртка над мьютексом управления
+class ControlLock {
+public:
+  ControlLock()  { g_runtime.lockControl(); }
+  ~ControlLock() { g_runtime.unlockControl(); }
+
+  ControlLock(const ControlLock &) = delete;
+  ControlLock &operator=(const ControlLock &) = delete;
+};
+
+#endif // RUNTIME_H
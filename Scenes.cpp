@@ -0,0 +1,46 @@
+// Scenes.cpp
+#include "Scenes.h"
+#include "EEPROMManager.h"
+
+SceneStore g_scenes;
+
+void SceneStore::begin() {
+  g_eeprom.loadScenes(table);
+  Serial.printf("🎬 Сцены: %u\n", (unsigned)table.count);
+}
+
+const Scene *SceneStore::find(const char *name) const {
+  for (uint8_t i = 0; i < table.count; ++i) {
+    if (strcmp(table.scenes[i].name, name) == 0) return &table.scenes[i];
+  }
+  return nullptr;
+}
+
+bool SceneStore::put(const Scene &scene) {
+  Scene *slot = const_cast<Scene*>(find(scene.name));
+  if (!slot) {
+    if (table.count >= SceneTable::MAX_SCENES) return false;
+    slot = &table.scenes[table.count++];
+  }
+  *slot = scene;
+  save();
+  return true;
+}
+
+bool SceneStore::remove(const char *name) {
+  const Scene *s = find(name);
+  if (!s) return false;
+
+  uint8_t idx = (uint8_t)(s - table.scenes);
+  for (uint8_t i = idx; i + 1 < table.count; ++i) {
+    table.scenes[i] = table.scenes[i + 1];
+  }
+  table.count--;
+  table.scenes[table.count] = Scene();
+  save();
+  return true;
+}
+
+void SceneStore::save() {
+  g_eeprom.saveScenes(table);
+}
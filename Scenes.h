@@ -0,0 +1,48 @@
+// Scenes.h
+#ifndef SCENES_H
+#define SCENES_H
+
+#include "Config.h"
+#include "Commands.h"
+
+// Именованные сцены — наборы команд исполнителям, хранятся в EEPROM
+// после SystemSettings (см. EEPROMManager::loadScenes/saveScenes).
+// Вызывать под ControlLock: таблицу читают Web и Telegram.
+struct Scene {
+  static constexpr uint8_t NAME_LEN     = 16;
+  static constexpr uint8_t MAX_COMMANDS = 6;
+
+  char              name[NAME_LEN] = "";
+  uint8_t           count          = 0;
+  Commands::Command cmds[MAX_COMMANDS];
+};
+
+struct SceneTable {
+  static constexpr uint8_t MAX_SCENES = 8;
+
+  uint8_t version = SCENES_VERSION;
+  uint8_t count   = 0;
+  Scene   scenes[MAX_SCENES];
+};
+
+class SceneStore {
+public:
+  void begin();
+
+  const Scene *find(const char *name) const;
+  // Добавить или заменить; false — таблица заполнена
+  bool put(const Scene &scene);
+  bool remove(const char *name);
+
+  uint8_t      count() const        { return table.count; }
+  const Scene &at(uint8_t i) const  { return table.scenes[i]; }
+
+private:
+  SceneTable table;
+
+  void save();
+};
+
+extern SceneStore g_scenes;
+
+#endif // SCENES_H
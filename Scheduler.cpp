@@ -0,0 +1,145 @@
+// Scheduler.cpp
+#include "Scheduler.h"
+
+Scheduler g_scheduler;
+
+int8_t Scheduler::add(const char *name, unsigned long periodMs, JobFn fn,
+                      unsigned long delayMs) {
+  // Сначала ищем освободившийся слот (отработавшая одноразовая задача)
+  uint8_t slot = count;
+  for (uint8_t i = 0; i < count; ++i) {
+    if (!jobs[i].active && jobs[i].periodMs == 0 && jobs[i].fn == fn) {
+      slot = i;
+      break;
+    }
+  }
+  if (slot == count) {
+    if (count >= MAX_JOBS) {
+      Serial.printf("⚠️ Scheduler: нет места для задачи %s\n", name);
+      return -1;
+    }
+    count++;
+  }
+
+  Job &j       = jobs[slot];
+  portENTER_CRITICAL(&mux);
+  j            = Job();
+  j.name       = name;
+  j.fn         = fn;
+  j.periodMs   = periodMs;
+  j.deadlineMs = millis() + delayMs;
+  j.active     = true;
+  portEXIT_CRITICAL(&mux);
+
+  wake();
+  return (int8_t)slot;
+}
+
+int8_t Scheduler::addPeriodic(const char *name, unsigned long periodMs, JobFn fn,
+                              unsigned long firstDelayMs) {
+  if (periodMs == 0) periodMs = 1;
+  return add(name, periodMs, fn, firstDelayMs);
+}
+
+int8_t Scheduler::addOneShot(const char *name, unsigned long delayMs, JobFn fn) {
+  return add(name, 0, fn, delayMs);
+}
+
+void Scheduler::reschedule(int8_t id, unsigned long delayMs) {
+  if (id < 0 || id >= count) return;
+  portENTER_CRITICAL(&mux);
+  jobs[id].deadlineMs = millis() + delayMs;
+  jobs[id].active     = true;
+  portEXIT_CRITICAL(&mux);
+  wake();
+}
+
+void Scheduler::cancel(int8_t id) {
+  if (id < 0 || id >= count) return;
+  portENTER_CRITICAL(&mux);
+  jobs[id].active = false;
+  portEXIT_CRITICAL(&mux);
+}
+
+unsigned long Scheduler::runDue() {
+  for (uint8_t i = 0; i < count; ++i) {
+    Job &j = jobs[i];
+
+    // Решение о запуске и следующий дедлайн — атомарно относительно
+    // reschedule() из других задач: перенос, сделанный до этого места,
+    // учитывается, после — сохраняется (в т.ч. во время j.fn())
+    unsigned long now     = millis();
+    long          late    = 0;
+    bool          due     = false;
+    bool          skipped = false;
+    portENTER_CRITICAL(&mux);
+    if (j.active) {
+      late = (long)(now - j.deadlineMs);
+      due  = late >= 0;
+    }
+    if (due) {
+      if (j.periodMs == 0) {
+        j.active = false;
+      } else {
+        j.deadlineMs += j.periodMs;
+        // Пропустили целый период — не догоняем пачкой, а сдвигаем фазу
+        if ((long)(now - j.deadlineMs) >= 0) {
+          skipped      = true;
+          j.deadlineMs = now + j.periodMs;
+        }
+      }
+    }
+    portEXIT_CRITICAL(&mux);
+    if (!due) continue;
+
+    if ((uint32_t)late > j.maxLateMs) j.maxLateMs = late;
+    if (skipped) j.overruns++;
+
+    uint32_t start = micros();
+    j.fn();
+    uint32_t took = micros() - start;
+
+    j.runs++;
+    j.lastRunUs = took;
+    if (took > j.maxRunUs) j.maxRunUs = took;
+    if (j.periodMs > 0 && took > j.periodMs * 1000UL) j.overruns++;
+  }
+
+  // Ближайший дедлайн; перенос после этого места разбудит sleep() через wake()
+  unsigned long now  = millis();
+  unsigned long wait = MAX_SLEEP_MS;
+  portENTER_CRITICAL(&mux);
+  for (uint8_t i = 0; i < count; ++i) {
+    const Job &j = jobs[i];
+    if (!j.active) continue;
+    long left = (long)(j.deadlineMs - now);
+    if (left <= 0) {
+      wait = 0;
+      break;
+    }
+    if ((unsigned long)left < wait) wait = left;
+  }
+  portEXIT_CRITICAL(&mux);
+  return wait;
+}
+
+void Scheduler::sleep(unsigned long ms) {
+  if (ms == 0) return;
+  // Сон прерывается wake() из другой задачи (новая/перенесённая задача)
+  ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(ms));
+}
+
+void Scheduler::wake() {
+  if (owner && owner != xTaskGetCurrentTaskHandle()) {
+    xTaskNotifyGive(owner);
+  }
+}
+
+void Scheduler::resetStats() {
+  for (uint8_t i = 0; i < count; ++i) {
+    jobs[i].runs      = 0;
+    jobs[i].maxRunUs  = 0;
+    jobs[i].maxLateMs = 0;
+    jobs[i].overruns  = 0;
+  }
+}
@@ -0,0 +1,73 @@
+// Scheduler.h
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include "Config.h"
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+// Кооперативный планировщик по дедлайнам.
+// Таблица периодических и одноразовых задач; runDue() выполняет всё, что
+// «созрело», и возвращает, сколько можно спать до ближайшего дедлайна.
+//
+// Из любой задачи и с любого ядра: reschedule(), cancel(), wake() —
+// дедлайн и признак active меняются под спинлоком, и runDue() их не затирает.
+// Только задача-владелец (или setup() до её запуска): add*, runDue(),
+// sleep(), attachTask(); job()/resetStats() — статистика, читается без
+// блокировки и может быть несогласованной между полями.
+class Scheduler {
+public:
+  typedef void (*JobFn)();
+
+  static constexpr uint8_t       MAX_JOBS     = 12;
+  static constexpr unsigned long MAX_SLEEP_MS = 1000;
+
+  struct Job {
+    const char*   name       = nullptr;
+    JobFn         fn         = nullptr;
+    unsigned long periodMs   = 0;     // 0 — одноразовая
+    unsigned long deadlineMs = 0;
+    bool          active     = false;
+
+    // Статистика
+    uint32_t runs      = 0;
+    uint32_t lastRunUs = 0;
+    uint32_t maxRunUs  = 0;
+    uint32_t maxLateMs = 0;
+    uint32_t overruns  = 0;   // пропущен период или выполнение дольше периода
+  };
+
+  // Возвращают id задачи или -1, если таблица заполнена
+  int8_t addPeriodic(const char *name, unsigned long periodMs, JobFn fn,
+                     unsigned long firstDelayMs = 0);
+  int8_t addOneShot(const char *name, unsigned long delayMs, JobFn fn);
+
+  void reschedule(int8_t id, unsigned long delayMs);
+  void cancel(int8_t id);
+
+  // Выполнить созревшие задачи; вернуть мс до следующего дедлайна
+  unsigned long runDue();
+
+  // Сон до дедлайна с возможностью досрочного пробуждения через wake()
+  void attachTask(TaskHandle_t task) { owner = task; }
+  void sleep(unsigned long ms);
+  void wake();
+
+  uint8_t    jobCount() const        { return count; }
+  const Job &job(uint8_t i) const    { return jobs[i]; }
+  void       resetStats();
+
+private:
+  Job          jobs[MAX_JOBS];
+  uint8_t      count = 0;
+  TaskHandle_t owner = nullptr;
+
+  mutable portMUX_TYPE mux = portMUX_INITIALIZER_UNLOCKED;   // deadlineMs, active
+
+  int8_t add(const char *name, unsigned long periodMs, JobFn fn,
+             unsigned long delayMs);
+};
+
+extern Scheduler g_scheduler;
+
+#endif // SCHEDULER_H
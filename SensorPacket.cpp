@@ -0,0 +1,35 @@
+// SensorPacket.cpp
+#include "SensorPacket.h"
+#include <time.h>
+
+static constexpr time_t MIN_VALID_TIME = 1700000000;   // раньше — NTP ещё не пришёл
+
+SensorPacket SensorPacket::from(const SensorData &sd, uint32_t version, bool automation) {
+  SensorPacket p;
+  p.magic       = MAGIC;
+  p.format      = FORMAT;
+  p.flags       = (sd.sensorsHealthy ? 0x01 : 0) | (automation ? 0x02 : 0);
+  p.seq         = version / 2;    // версия seqlock растёт на 2 за публикацию
+  p.timestampMs = sd.timestampMs;
+
+  time_t now  = time(nullptr);
+  p.unixTime  = now >= MIN_VALID_TIME ? (uint32_t)now : 0;
+
+  p.values[AIR_TEMP]          = sd.airTemperature;
+  p.values[AIR_HUM]           = sd.airHumidity;
+  p.values[AIR_PRESSURE]      = sd.airPressure;
+  p.values[SOIL_TEMP]         = sd.soilTemperature;
+  p.values[SOIL_MOISTURE]     = sd.soilMoisture;
+  p.values[SOIL_MOISTURE_VAR] = sd.soilMoistureVar;
+  p.values[LIGHT_LUX]         = sd.lightLevelLux;
+
+  p.valid = 0;
+  for (uint8_t i = 0; i < VALUE_COUNT; ++i) {
+    if (!isnan(p.values[i])) p.valid |= (uint16_t)(1u << i);
+  }
+
+  p.actuators = (sd.pumpOn  ? 0x01 : 0) | (sd.fanOn    ? 0x02 : 0) |
+                (sd.lightOn ? 0x04 : 0) | (sd.doorOpen ? 0x08 : 0);
+  p.reserved  = 0;
+  return p;
+}
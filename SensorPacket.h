@@ -0,0 +1,47 @@
+// SensorPacket.h
+#ifndef SENSOR_PACKET_H
+#define SENSOR_PACKET_H
+
+#include "Config.h"
+
+// Двоичный снимок датчиков для /api/sensors.bin — 48 байт, little-endian,
+// без выравнивания. Формат (смещение: тип поле):
+//    0: u16   magic      0x4759 ('Y','G' в памяти)
+//    2: u8    format     SensorPacket::FORMAT (меняется при несовместимых правках)
+//    3: u8    flags      бит 0 — sensorsHealthy, бит 1 — automationEnabled
+//    4: u32   seq        номер снимка SensorStore (монотонно растёт с загрузки)
+//    8: u32   timestampMs millis() опроса датчиков
+//   12: u32   unixTime   секунды UTC на момент ответа, 0 — NTP ещё нет
+//   16: u16   valid      бит i — values[i] валиден (не NaN)
+//   18: u8    actuators  бит 0 насос, 1 вентилятор, 2 свет, 3 дверь открыта
+//   19: u8    reserved   0
+//   20: f32[7] values    airTemperature, airHumidity, airPressure,
+//                        soilTemperature, soilMoisture, soilMoistureVar,
+//                        lightLevelLux (невалидные — NaN)
+struct __attribute__((packed)) SensorPacket {
+  static constexpr uint16_t MAGIC  = 0x4759;
+  static constexpr uint8_t  FORMAT = 1;
+
+  enum Value : uint8_t {
+    AIR_TEMP = 0, AIR_HUM, AIR_PRESSURE, SOIL_TEMP, SOIL_MOISTURE, SOIL_MOISTURE_VAR, LIGHT_LUX,
+    VALUE_COUNT
+  };
+
+  uint16_t magic;
+  uint8_t  format;
+  uint8_t  flags;
+  uint32_t seq;
+  uint32_t timestampMs;
+  uint32_t unixTime;
+  uint16_t valid;
+  uint8_t  actuators;
+  uint8_t  reserved;
+  float    values[VALUE_COUNT];
+
+  // version — версия снимка из SensorStore::read()
+  static SensorPacket from(const SensorData &sd, uint32_t version, bool automation);
+};
+
+static_assert(sizeof(SensorPacket) == 48, "SensorPacket: формат на проводе — ровно 48 байт");
+
+#endif // SENSOR_PACKET_H
@@ -0,0 +1,43 @@
+// SensorStore.cpp
+#include "SensorStore.h"
+#include <string.h>
+
+SensorStore g_sensorStore;
+
+void SensorStore::publish(const SensorData &d) {
+  uint32_t s = seq;
+
+  seq = s + 1;                                  // нечётное — идёт запись
+  __atomic_thread_fence(__ATOMIC_RELEASE);
+
+  memcpy((void *)&data, &d, sizeof(SensorData));
+
+  __atomic_thread_fence(__ATOMIC_RELEASE);
+  seq = s + 2;
+}
+
+bool SensorStore::publishIfChanged(const SensorData &d) {
+  // data меняет только писатель, поэтому сравнивать можно без seqlock
+  if (memcmp((const void *)&data, &d, sizeof(SensorData)) == 0) return false;
+  publish(d);
+  return true;
+}
+
+uint32_t SensorStore::read(SensorData &out) const {
+  for (;;) {
+    uint32_t s1 = seq;
+    if (s1 & 1U) continue;                      // писатель посередине
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+    memcpy(&out, (const void *)&data, sizeof(SensorData));
+
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    if (seq == s1) return s1;
+  }
+}
+
+uint32_t SensorStore::version() const {
+  uint32_t s = seq;
+  __atomic_thread_fence(__ATOMIC_ACQUIRE);
+  return s & ~1U;
+}
@@ -0,0 +1,35 @@
+// SensorStore.h
+#ifndef SENSOR_STORE_H
+#define SENSOR_STORE_H
+
+#include "Config.h"
+
+// Версионированные снимки SensorData (seqlock).
+// Писатель один — задача управления: рабочую копию g_sensorData она
+// публикует через publish(). Читатели на любом ядре получают целостную
+// копию без мьютекса: при конкурентной записи чтение просто повторяется.
+class SensorStore {
+public:
+  // Только из задачи управления
+  void publish(const SensorData &d);
+  bool publishIfChanged(const SensorData &d);
+
+  // Возвращает версию снимка (чётное число, 0 — ещё ничего не публиковали)
+  uint32_t read(SensorData &out) const;
+
+  SensorData snapshot() const {
+    SensorData d;
+    read(d);
+    return d;
+  }
+
+  uint32_t version() const;
+
+private:
+  volatile uint32_t seq = 0;
+  SensorData        data;
+};
+
+extern SensorStore g_sensorStore;
+
+#endif // SENSOR_STORE_H
@@ -0,0 +1,94 @@
+// SettingsFields.cpp
+#include "SettingsFields.h"
+#include <stddef.h>
+
+namespace SettingsFields {
+
+#define SF_FLOAT(name, lo, hi, dec) { #name, KIND_FLOAT, (uint16_t)offsetof(SystemSettings, name), lo, hi, dec }
+#define SF_U8(name, lo, hi)         { #name, KIND_U8,    (uint16_t)offsetof(SystemSettings, name), lo, hi, 0 }
+
+static constexpr Field FIELDS[] = {
+  SF_FLOAT(comfortTempMin,         -10.0f, 50.0f,     1),
+  SF_FLOAT(comfortTempMax,         -10.0f, 50.0f,     1),
+  SF_FLOAT(comfortHumMin,            0.0f, 100.0f,    1),
+  SF_FLOAT(comfortHumMax,            0.0f, 100.0f,    1),
+  SF_FLOAT(soilMoistureSetpoint,     0.0f, 100.0f,    1),
+  SF_FLOAT(soilMoistureHysteresis,   0.0f, 50.0f,     1),
+  SF_FLOAT(lightLuxMin,              0.0f, 100000.0f, 1),
+  SF_U8   (wateringStartHour,        0,    23),
+  SF_U8   (wateringEndHour,          0,    23),
+  SF_U8   (lightCutoffHour,          0,    23),
+  SF_U8   (climateMode,              0,    2),
+  SF_U8   (soilBurstLen,             1,    31),
+  SF_FLOAT(soilEmaAlpha,             0.01f, 1.0f,     2),
+  SF_U8   (soilSlopeMode,            0,    1),
+  SF_U8   (soilSlopeSpanMin,         4,    60),
+};
+
+#undef SF_FLOAT
+#undef SF_U8
+
+static constexpr uint8_t FIELD_COUNT = sizeof(FIELDS) / sizeof(FIELDS[0]);
+static_assert(FIELD_COUNT <= MAX_FIELDS, "SettingsFields::MAX_FIELDS is too small");
+
+uint8_t      count()           { return FIELD_COUNT; }
+const Field &field(uint8_t i)  { return FIELDS[i < FIELD_COUNT ? i : 0]; }
+
+const Field *find(const char *key) {
+  for (const Field &f : FIELDS) {
+    if (strcmp(f.key, key) == 0) return &f;
+  }
+  return nullptr;
+}
+
+Result apply(SystemSettings &s, const Field &f, const JsonReader::Value &v) {
+  double x;
+  if (!v.asNumber(x)) return BAD_TYPE;
+  return applyNumber(s, f, x);
+}
+
+Result applyNumber(SystemSettings &s, const Field &f, double x) {
+  if (isnan(x)) return BAD_TYPE;
+  if (x < f.min || x > f.max) return OUT_OF_RANGE;
+
+  uint8_t *base = reinterpret_cast<uint8_t*>(&s) + f.offset;
+  switch (f.kind) {
+    case KIND_FLOAT:
+      *reinterpret_cast<float*>(base) = (float)x;
+      break;
+    case KIND_U8:
+      if (x != (double)(long)x) return BAD_TYPE;   // только целые
+      *base = (uint8_t)x;
+      break;
+  }
+  return OK;
+}
+
+double read(const SystemSettings &s, const Field &f) {
+  const uint8_t *base = reinterpret_cast<const uint8_t*>(&s) + f.offset;
+  switch (f.kind) {
+    case KIND_FLOAT: return *reinterpret_cast<const float*>(base);
+    case KIND_U8:    return *base;
+  }
+  return NAN;
+}
+
+void write(JsonWriter &w, const SystemSettings &s, const Field &f) {
+  const uint8_t *base = reinterpret_cast<const uint8_t*>(&s) + f.offset;
+  switch (f.kind) {
+    case KIND_FLOAT: w.field(f.key, *reinterpret_cast<const float*>(base), f.decimals); break;
+    case KIND_U8:    w.field(f.key, *base);                                              break;
+  }
+}
+
+const char *resultName(Result r) {
+  switch (r) {
+    case OK:           return "ok";
+    case UNKNOWN:      return "unknown";
+    case BAD_TYPE:     return "type";
+    case OUT_OF_RANGE: return "range";
+  }
+  return "?";
+}
+
+}
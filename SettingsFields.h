@@ -0,0 +1,42 @@
+// SettingsFields.h
+#ifndef SETTINGS_FIELDS_H
+#define SETTINGS_FIELDS_H
+
+#include "Config.h"
+#include "JsonReader.h"
+#include "JsonWriter.h"
+
+// Таблица редактируемых полей SystemSettings: имя в JSON, тип, смещение
+// в структуре и допустимый диапазон. По ней работают GET/POST /api/settings
+// и команды /set_… в Telegram.
+namespace SettingsFields {
+  static constexpr uint8_t MAX_FIELDS = 20;
+
+  enum Kind : uint8_t { KIND_FLOAT = 0, KIND_U8 };
+
+  struct Field {
+    const char *key;
+    Kind        kind;
+    uint16_t    offset;
+    float       min;
+    float       max;
+    uint8_t     decimals;   // для вывода float
+  };
+
+  enum Result : uint8_t { OK = 0, UNKNOWN, BAD_TYPE, OUT_OF_RANGE };
+
+  uint8_t      count();
+  const Field &field(uint8_t i);
+  const Field *find(const char *key);
+
+  // Проверка и запись значения в s; при ошибке s не меняется
+  Result apply(SystemSettings &s, const Field &f, const JsonReader::Value &v);
+  Result applyNumber(SystemSettings &s, const Field &f, double x);
+  double read(const SystemSettings &s, const Field &f);
+  // "key":value
+  void   write(JsonWriter &w, const SystemSettings &s, const Field &f);
+
+  const char *resultName(Result r);
+}
+
+#endif // SETTINGS_FIELDS_H
@@ -0,0 +1,122 @@
+// SlopeEstimator.cpp
+#include "SlopeEstimator.h"
+#include <math.h>
+
+static constexpr double MS_PER_HOUR = 3600000.0;
+
+void SlopeEstimator::configure(Mode mode, unsigned long span) {
+  if (span < 60000UL) span = 60000UL;
+  if (mode == curMode && span == spanMs) return;
+  curMode = mode;
+  spanMs  = span;
+  reset();
+}
+
+void SlopeEstimator::reset() {
+  sw = sww = st = sy = stt = sty = syy = swwt = swwtt = 0.0;
+  empty     = true;
+  ringHead  = 0;
+  ringCount = 0;
+}
+
+// Перенос начала отсчёта на dtH часов вперёд: t' = t - dtH
+void SlopeEstimator::shiftOrigin(double dtH) {
+  stt   += -2.0 * dtH * st + dtH * dtH * sw;
+  sty   += -dtH * sy;
+  st    += -dtH * sw;
+  swwtt += -2.0 * dtH * swwt + dtH * dtH * sww;
+  swwt  += -dtH * sww;
+}
+
+void SlopeEstimator::scale(double k) {
+  sw    *= k;
+  sww   *= k * k;
+  st    *= k;
+  sy    *= k;
+  stt   *= k;
+  sty   *= k;
+  syy   *= k;
+  swwt  *= k * k;
+  swwtt *= k * k;
+}
+
+void SlopeEstimator::accumulate(double t, double y, double w, double sign) {
+  sw  += sign * w;
+  sww += sign * w * w;
+  st  += sign * w * t;
+  sy  += sign * w * y;
+  stt += sign * w * t * t;
+  sty += sign * w * t * y;
+  syy += sign * w * y * y;
+  swwt  += sign * w * w * t;
+  swwtt += sign * w * w * t * t;
+}
+
+void SlopeEstimator::evictOlderThan(unsigned long tMs) {
+  while (ringCount > 0 && (long)(ringT[ringHead] - tMs) < 0) {
+    double t = -(double)(lastMs - ringT[ringHead]) / MS_PER_HOUR;
+    accumulate(t, ringY[ringHead], 1.0, -1.0);
+    ringHead = (ringHead + 1) % CAPACITY;
+    ringCount--;
+  }
+  if (ringCount == 0) reset();   // обнуляем накопленную погрешность вычитаний
+}
+
+void SlopeEstimator::add(unsigned long tMs, float y) {
+  if (isnan(y)) return;
+
+  if (!empty) {
+    double dtH = (double)(tMs - lastMs) / MS_PER_HOUR;
+    shiftOrigin(dtH);
+    if (curMode == EXPONENTIAL) {
+      scale(exp(-(double)(tMs - lastMs) / (double)spanMs));
+    }
+  }
+  lastMs = tMs;
+  empty  = false;
+
+  if (curMode == WINDOW) {
+    if (ringCount == CAPACITY) evictOlderThan(ringT[ringHead] + 1);
+    uint8_t idx  = (ringHead + ringCount) % CAPACITY;
+    ringT[idx]   = tMs;
+    ringY[idx]   = y;
+    ringCount++;
+    accumulate(0.0, y, 1.0, 1.0);
+    evictOlderThan(tMs - spanMs);
+  } else {
+    accumulate(0.0, y, 1.0, 1.0);
+  }
+}
+
+SlopeEstimator::Fit SlopeEstimator::fit() const {
+  Fit f;
+  if (empty || sw <= 0.0 || sww <= 0.0) return f;
+
+  f.nEff = (float)(sw * sw / sww);
+  if (f.nEff < 4.0f) return f;
+
+  // Центрированные суммы
+  double ctt = stt - st * st / sw;
+  double cty = sty - st * sy / sw;
+  double cyy = syy - sy * sy / sw;
+  if (ctt < 1e-9) return f;
+
+  double b     = cty / ctt;
+  double resid = cyy - b * cty;
+  if (resid < 0.0) resid = 0.0;
+
+  // Дисперсия остатков на одну точку, пересчитанная на nEff - 2 степеней свободы
+  double s2 = resid / sw * (double)f.nEff / ((double)f.nEff - 2.0);
+  // Дисперсия взвешенного наклона b = Σw(t-t̄)y / ctt:
+  // s2 · Σw²(t-t̄)² / ctt²; при равных весах — привычное s2 / ctt
+  double tm   = st / sw;
+  double cwwt = swwtt - 2.0 * tm * swwt + tm * tm * sww;
+  if (cwwt < 0.0) cwwt = 0.0;
+  double varB = s2 * cwwt / (ctt * ctt);
+
+  f.slope  = (float)b;
+  f.stdErr = (float)sqrt(varB);
+  f.r2     = cyy > 0.0 ? (float)(1.0 - resid / cyy) : 0.0f;
+  f.valid  = true;
+  return f;
+}
@@ -0,0 +1,62 @@
+// SlopeEstimator.h
+#ifndef SLOPE_ESTIMATOR_H
+#define SLOPE_ESTIMATOR_H
+
+#include "Config.h"
+
+// Инкрементальная линейная регрессия y(t) по бегущим суммам.
+// Добавление и удаление точки — O(1), запрос наклона — O(1).
+//
+// Два режима:
+//  - WINDOW: скользящее окно spanMs, старые точки вычитаются из сумм;
+//  - EXPONENTIAL: все веса затухают как exp(-dt / spanMs), кольцо не нужно.
+//
+// Начало отсчёта времени всегда совпадает с последней точкой: при каждом
+// добавлении суммы сдвигаются на dt, поэтому числа не растут со временем.
+class SlopeEstimator {
+public:
+  enum Mode : uint8_t { WINDOW = 0, EXPONENTIAL = 1 };
+
+  static constexpr uint8_t CAPACITY = 64;   // точек в кольце режима WINDOW
+
+  struct Fit {
+    float    slope  = 0.0f;   // ед./час
+    float    stdErr = 0.0f;   // стандартная ошибка наклона, ед./час
+    float    r2     = 0.0f;   // доля дисперсии, объяснённая трендом
+    float    nEff   = 0.0f;   // эффективное число точек (Kish)
+    bool     valid  = false;  // хватает точек и разброса по времени
+  };
+
+  void configure(Mode mode, unsigned long spanMs);
+  void reset();
+  void add(unsigned long tMs, float y);
+
+  Fit   fit() const;
+  Mode  mode() const     { return curMode; }
+  uint8_t count() const  { return ringCount; }
+
+private:
+  Mode          curMode = WINDOW;
+  unsigned long spanMs  = 32UL * 60UL * 1000UL;
+
+  // Суммы относительно времени последней точки (часы)
+  double sw = 0.0, sww = 0.0;
+  double st = 0.0, sy = 0.0;
+  double stt = 0.0, sty = 0.0, syy = 0.0;
+  double swwt = 0.0, swwtt = 0.0;   // Σw²t, Σw²t² — для дисперсии наклона
+  unsigned long lastMs = 0;
+  bool          empty  = true;
+
+  // Кольцо для вычитания в режиме WINDOW
+  unsigned long ringT[CAPACITY];
+  float         ringY[CAPACITY];
+  uint8_t       ringHead  = 0;   // самая старая точка
+  uint8_t       ringCount = 0;
+
+  void shiftOrigin(double dtH);
+  void scale(double k);
+  void accumulate(double t, double y, double w, double sign);
+  void evictOlderThan(unsigned long tMs);
+};
+
+#endif // SLOPE_ESTIMATOR_H
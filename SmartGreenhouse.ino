@@ -1,7 +1,7 @@
 #include <Arduino.h>
 #include <WiFi.h>
-#include <WiFiClientSecure.h>
 #include <time.h>
+#include <esp_timer.h>
 #include "Config.h"
 #include "Devices.h"
 #include "DisplayManager.h"
@@ -10,6 +10,13 @@
 #include "EEPROMManager.h"
 #include "WebInterface.h"
 #include "TelegramBotHandler.h"
+#include "Scheduler.h"
+#include "Runtime.h"
+#include "Perf.h"
+#include "HistoryStore.h"
+#include "Rollup.h"
+#include "Scenes.h"
+#include "WifiManager.h"
 
 extern Automation         g_automation;
 extern WebInterface       g_web;
@@ -17,7 +24,7 @@ extern EEPROMManager      g_eeprom;
 extern DisplayManager     g_display;
 extern TelegramBotHandler g_telegram;
 
-unsigned long lastSensorRead = 0;
+void sensorsIoJob();
 
 void printGreenhouseTime() {
   struct tm timeinfo;
@@ -40,56 +47,76 @@ void setup() {
 
   g_eeprom.begin();
   g_eeprom.loadSettings(g_settings);
+  g_scenes.begin();
 
   applyCropProfile(g_settings.cropProfile, g_settings);
 
+  g_history.begin();
   g_devices.begin();
   g_display.begin();
   g_automation.begin();
+  g_wifi.begin();   // не ждёт подключения: дальше — WifiManager::loop()
   g_web.begin();
 
   // Московский часовой пояс
   configTzTime("MSK-3", "pool.ntp.org", "time.nist.gov");
 
-  // 🟢 Инициализируем Telegram только если мы в STA и подключены к роутеру
-  if (WiFi.getMode() == WIFI_STA && WiFi.status() == WL_CONNECTED) {
-    g_telegram.begin();
-  } else {
-    Serial.println(F("Telegram: пропускаем инициализацию (нет STA-соединения)"));
-  }
-
-  lastSensorRead = millis();
+  // Telegram опрашивает сервер, только пока есть STA-соединение;
+  // при его восстановлении WifiManager сообщает боту
+  g_telegram.begin();
+  g_wifi.onConnected([]() { g_telegram.onNetworkUp(); });
+
+  // Все периодические работы — задачи планировщика вместо опроса millis()
+  g_scheduler.addPeriodic("sensors",    Constants::SENSOR_READ_INTERVAL_MS,
+                          []() { g_devices.startSensorCycle(); },
+                          Constants::SENSOR_READ_INTERVAL_MS);
+  g_scheduler.addPeriodic("sensor_io",  Constants::SENSOR_POLL_MS, sensorsIoJob);
+  g_scheduler.addPeriodic("actuators",  Constants::ACTUATOR_UPDATE_MS,
+                          []() { PerfScope p(Perf::ACTUATORS); g_devices.loop(); });
+  g_scheduler.addPeriodic("automation", Constants::AUTOMATION_INTERVAL_MS,
+                          []() { PerfScope p(Perf::AUTOMATION); g_automation.run(); },
+                          Constants::AUTOMATION_INTERVAL_MS);
+  g_scheduler.addPeriodic("display",    Constants::DISPLAY_UPDATE_MS,
+                          []() { PerfScope p(Perf::DISPLAY); g_display.update(); },
+                          Constants::DISPLAY_UPDATE_MS);
+  g_scheduler.addPeriodic("history",    Constants::HISTORY_INTERVAL_MS,
+                          []() { g_history.record(g_sensorData); },
+                          Constants::HISTORY_INTERVAL_MS);
+  g_scheduler.addPeriodic("time",       Constants::TIME_PRINT_INTERVAL_MS, printGreenhouseTime,
+                          Constants::TIME_PRINT_INTERVAL_MS);
+
+  Scheduler &tg = g_runtime.telegramScheduler();
+  g_telegram.attachInboxJob(
+    tg.addPeriodic("tg_inbox",  TelegramBotHandler::INBOX_CHECK_MS,
+                   []() { PerfScope p(Perf::TELEGRAM_CMD); g_telegram.processInbox(); }));
+  g_telegram.attachOutboxJob(
+    tg.addPeriodic("tg_outbox", TelegramBotHandler::OUTBOX_CHECK_MS,
+                   []() { g_telegram.flushOutbox(); }));
+  tg.addPeriodic("tg_alerts", TelegramBotHandler::ALERT_CHECK_MS,
+                 []() { g_telegram.checkAlerts(); },
+                 TelegramBotHandler::ALERT_CHECK_MS);
+
+  // Управление — отдельной задачей на ядре 1, Web и Telegram — на ядре 0
+  g_runtime.begin();
 }
 
-void loop() {
-  static unsigned long lastTimePrint = 0;
-
-  unsigned long now = millis();
-
-  if ((long)(now - lastSensorRead) >= (long)Constants::SENSOR_READ_INTERVAL_MS) {
-    lastSensorRead = now;
-    g_devices.readSensors();
-
-    Serial.println(F("\n--- Текущее состояние ---"));
-    Serial.printf("Воздух:  T=%.1f°C H=%.1f%% P=%.1f hPa\n",
-                  g_sensorData.airTemperature,
-                  g_sensorData.airHumidity,
-                  g_sensorData.airPressure);
-    Serial.printf("Почва:   W=%.1f%%\n",
-                  g_sensorData.soilMoisture);
-    Serial.printf("Свет:    L=%.1f lux\n", g_sensorData.lightLevelLux);
-  }
+// Сбор готовых преобразований; по завершении цикла — вывод в Serial
+void sensorsIoJob() {
+  if (!g_devices.serviceSensors()) return;
 
-  if (now - lastTimePrint > 60000UL) {
-    lastTimePrint = now;
-    printGreenhouseTime();
-  }
+  g_rollup.add(g_sensorData, (uint32_t)(esp_timer_get_time() / 1000000));
 
-  g_devices.loop();
-  g_automation.loop();
-  g_display.update();
-  g_web.loop();
-  g_telegram.loop();
+  Serial.println(F("\n--- Текущее состояние ---"));
+  Serial.printf("Воздух:  T=%.1f°C H=%.1f%% P=%.1f hPa\n",
+                g_sensorData.airTemperature,
+                g_sensorData.airHumidity,
+                g_sensorData.airPressure);
+  Serial.printf("Почва:   W=%.1f%%\n",
+                g_sensorData.soilMoisture);
+  Serial.printf("Свет:    L=%.1f lux\n", g_sensorData.lightLevelLux);
+}
 
-  delay(5);
-}
\ No newline at end of file
+void loop() {
+  // Всё работает в задачах Runtime, стандартная loopTask не нужна
+  vTaskDelete(nullptr);
+}
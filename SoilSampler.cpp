@@ -0,0 +1,68 @@
+// SoilSampler.cpp
+#include "SoilSampler.h"
+
+SoilSampler g_soilSampler;
+
+void SoilSampler::begin() {
+  esp_timer_create_args_t args = {};
+  args.callback        = &SoilSampler::onTimer;
+  args.arg             = this;
+  args.dispatch_method = ESP_TIMER_TASK;
+  args.name            = "soil";
+
+  if (esp_timer_create(&args, &timer) != ESP_OK) {
+    Serial.println(F("⚠️ SoilSampler: не удалось создать таймер"));
+    return;
+  }
+  esp_timer_start_periodic(timer, Constants::SOIL_SAMPLE_PERIOD_MS * 1000ULL);
+}
+
+void SoilSampler::onTimer(void *arg) {
+  static_cast<SoilSampler*>(arg)->sampleBurst();
+}
+
+void SoilSampler::sampleBurst() {
+  uint8_t n = g_settings.soilBurstLen;
+  if (n < 1)         n = 1;
+  if (n > MAX_BURST) n = MAX_BURST;
+
+  float alpha = g_settings.soilEmaAlpha;
+  if (!(alpha > 0.0f) || alpha > 1.0f) alpha = 1.0f;
+
+  // Пачка отсчётов, медиана вставками (n ≤ 31)
+  uint16_t s[MAX_BURST];
+  for (uint8_t i = 0; i < n; ++i) {
+    uint16_t v = analogRead(Pins::SOIL_ADC_PIN);
+    uint8_t  k = i;
+    while (k > 0 && s[k - 1] > v) {
+      s[k] = s[k - 1];
+      --k;
+    }
+    s[k] = v;
+  }
+  float median = (n & 1) ? s[n / 2] : 0.5f * (s[n / 2 - 1] + s[n / 2]);
+
+  portENTER_CRITICAL(&mux);
+  if (!primed) {
+    ema    = median;
+    var    = 0.0f;
+    primed = true;
+  } else {
+    // Экспоненциально взвешенные среднее и дисперсия
+    float diff = median - ema;
+    float incr = alpha * diff;
+    ema += incr;
+    var  = (1.0f - alpha) * (var + diff * incr);
+  }
+  burstCount++;
+  portEXIT_CRITICAL(&mux);
+}
+
+bool SoilSampler::read(float &raw, float &variance) const {
+  portENTER_CRITICAL(&mux);
+  bool ok  = primed;
+  raw      = ema;
+  variance = var;
+  portEXIT_CRITICAL(&mux);
+  return ok;
+}
@@ -0,0 +1,40 @@
+// SoilSampler.h
+#ifndef SOIL_SAMPLER_H
+#define SOIL_SAMPLER_H
+
+#include "Config.h"
+#include <esp_timer.h>
+
+// Фоновая выборка АЦП датчика почвы.
+// Таймер esp_timer каждые SOIL_SAMPLE_PERIOD_MS снимает пачку из
+// soilBurstLen отсчётов, берёт медиану (убирает выбросы АЦП ESP32) и
+// пропускает её через EMA с коэффициентом soilEmaAlpha. Параллельно
+// считается экспоненциальная дисперсия — по ней видно, насколько шумит датчик.
+class SoilSampler {
+public:
+  static constexpr uint8_t MAX_BURST = 31;
+
+  void begin();
+
+  // Отфильтрованное значение АЦП и его дисперсия (в единицах АЦП²).
+  // false — ещё не было ни одной пачки.
+  bool read(float &raw, float &variance) const;
+
+  uint32_t bursts() const { return burstCount; }
+
+private:
+  esp_timer_handle_t timer = nullptr;
+
+  mutable portMUX_TYPE mux = portMUX_INITIALIZER_UNLOCKED;
+  float    ema        = 0.0f;
+  float    var        = 0.0f;
+  bool     primed     = false;
+  uint32_t burstCount = 0;
+
+  static void onTimer(void *arg);
+  void        sampleBurst();
+};
+
+extern SoilSampler g_soilSampler;
+
+#endif // SOIL_SAMPLER_H
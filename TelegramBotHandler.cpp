@@ -1,5 +1,12 @@
 // TelegramBotHandler.cpp
 #include "TelegramBotHandler.h"
+#include "Runtime.h"
+#include "Perf.h"
+#include "SensorStore.h"
+#include "Rollup.h"
+#include "Scenes.h"
+#include "Fnv1a.h"
+#include "WifiManager.h"
 
 extern Automation     g_automation;
 extern Devices        g_devices;
@@ -13,9 +20,22 @@ void TelegramBotHandler::begin() {
     return;
   }
 
-  client.setInsecure(); // если хочешь жёсткий TLS — можно настроить fingerprint
+  // Проверка цепочки до одного корня во флеше — без полного набора CA в RAM
+  const char *root = testServer() ? TelegramConfig::TEST_ROOT_CA : TELEGRAM_CERTIFICATE_ROOT;
+  client.setCACert(root);
+  rxClient.setCACert(root);
+  if (!client.setFingerprint(TelegramConfig::CERT_SHA256) ||
+      !rxClient.setFingerprint(TelegramConfig::CERT_SHA256)) {
+    Serial.println(F("⚠️ Telegram: CERT_SHA256 не разобран (нужно 32 байта в hex), соединения будут отклонены"));
+  }
   bot = new UniversalTelegramBot(TelegramConfig::BOT_TOKEN, client);
 
+  rxBot = new UniversalTelegramBot(TelegramConfig::BOT_TOKEN, rxClient);
+  rxBot->longPoll = LONG_POLL_S;
+
+  inbox = xQueueCreate(INBOX_DEPTH, sizeof(Inbound));
+  buildCommandIndex();
+
   if (strlen(TelegramConfig::CHAT_ID) > 0) {
     primaryChatId = TelegramConfig::CHAT_ID;
   }
@@ -36,199 +56,434 @@ String TelegramBotHandler::mainKeyboardJson() {
   return k;
 }
 
-void TelegramBotHandler::loop() {
-  if (!bot) return;
+// inline-кнопки под статусом: нажатие правит это же сообщение.
+// Кнопка автоматики — по текущему состоянию
+String TelegramBotHandler::statusKeyboardJson() {
+  String k = "["
+             "[{\"text\":\"🔄 Обновить\",\"callback_data\":\"s:/status\"},"
+             "{\"text\":\"💧 Полив\",\"callback_data\":\"s:/water_now\"}],";
+  k += g_settings.automationEnabled
+         ? "[{\"text\":\"⏸ Авто ВЫКЛ\",\"callback_data\":\"s:/auto_off\"}]"
+         : "[{\"text\":\"⚙ Авто ВКЛ\",\"callback_data\":\"s:/auto_on\"}]";
+  k += "]";
+  return k;
+}
 
-  unsigned long now = millis();
+// inline-меню профилей: выбор заменяет меню ответом
+String TelegramBotHandler::profileKeyboardJson() {
+  String k = "["
+             "[{\"text\":\"🍅 Помидоры\",\"callback_data\":\"m:/profile 1\"},"
+             "{\"text\":\"🥒 Огурцы\",\"callback_data\":\"m:/profile 2\"}],"
+             "[{\"text\":\"🌿 Зелень\",\"callback_data\":\"m:/profile 3\"},"
+             "{\"text\":\"🌺 Гибискус\",\"callback_data\":\"m:/profile 4\"}]"
+             "]";
+  return k;
+}
 
-  if (now - lastPollMs >= POLL_INTERVAL_MS) {
-    lastPollMs = now;
-    int n = bot->getUpdates(bot->last_message_received + 1);
-    if (n > 0) {
-      handleNewMessages(n);
+// ===== Приём (задача tg_rx) =====
+// getUpdates с timeout=LONG_POLL_S: сервер держит запрос, пока не придёт
+// сообщение, — команда доходит сразу, а соединение не простаивает и не
+// закрывается. Быстрый возврат без сообщений — ошибка: пауза растёт вдвое.
+void TelegramBotHandler::receiveLoop() {
+  unsigned long retryMs = RX_RETRY_MIN_MS;
+
+  for (;;) {
+    if (!rxBot || !inbox || !g_wifi.connected()) {
+      vTaskDelay(pdMS_TO_TICKS(1000));
+      continue;
     }
+    if (rxReset) {
+      rxReset = false;
+      rxClient.stop();
+    }
+
+    unsigned long start = millis();
+    int           n     = -1;
+    if (connectTls(rxClient)) {
+      int64_t pollStart = Perf::nowUs();
+      n = rxBot->getUpdates(rxBot->last_message_received + 1);
+      st.polls++;
+      // Пустой long poll — это LONG_POLL_S ожидания, а не задержка;
+      // в гистограмму — ответы с сообщениями и ошибки
+      if (n != 0) Perf::record(Perf::TELEGRAM, (uint32_t)(Perf::nowUs() - pollStart));
+    }
+
+    if (n <= 0) {
+      if (n < 0 || millis() - start < 1000) {
+        st.pollErrors++;
+        rxClient.stop();
+        vTaskDelay(pdMS_TO_TICKS(retryMs));
+        retryMs = min(retryMs * 2, RX_RETRY_MAX_MS);
+      }
+      continue;
+    }
+    retryMs = RX_RETRY_MIN_MS;
+
+    for (int i = 0; i < n; ++i) {
+      const telegramMessage &msg = rxBot->messages[i];
+      Inbound in;
+      strlcpy(in.chatId, msg.chat_id.c_str(), sizeof(in.chatId));
+      strlcpy(in.text,   msg.text.c_str(),    sizeof(in.text));
+      strlcpy(in.queryId, msg.type == "callback_query" ? msg.query_id.c_str() : "", sizeof(in.queryId));
+      in.messageId  = msg.message_id;
+      in.receivedMs = millis();
+
+      st.received++;
+      if (xQueueSend(inbox, &in, 0) != pdTRUE) st.dropped++;
+    }
+    g_runtime.telegramScheduler().reschedule(inboxJob, 0);
   }
+}
 
-  if (notificationsEnabled && now - lastSensorAlertMs >= ALERT_CHECK_MS) {
-    checkAndSendAlerts();
+// ===== TLS =====
+// Соединение с api.telegram.org открывается здесь, а не внутри
+// UniversalTelegramBot (та переиспользует уже открытое): так видно, полным
+// ли было рукопожатие или сессия возобновилась, сколько оно стоило по
+// времени, процессору и куче. Отпечаток CERT_SHA256 сверяет TlsClient.
+bool TelegramBotHandler::connectTls(TlsClient &c) {
+  if (c.connected()) return true;
+
+  bool ok = testServer()
+    ? c.connect(TelegramConfig::TEST_API_HOST, TelegramConfig::TEST_API_PORT, TELEGRAM_HOST)
+    : c.connect(TELEGRAM_HOST, TELEGRAM_SSL_PORT);
+  if (!ok) {
+    if (c.lastError() == TlsClient::ERR_PIN) {
+      st.pinFailures++;
+      Serial.println(F("⚠️ Telegram: отпечаток сертификата не совпал, соединение закрыто"));
+    } else {
+      st.tlsFailures++;
+    }
+    return false;
   }
+
+  const TlsClient::Handshake &h = c.lastHandshake();
+  Stats::Handshakes          &s = st.tls[h.resumed ? 1 : 0];
+  s.count++;
+  s.lastMs       = h.wallMs;
+  s.lastCpuUs    = h.cpuUs;
+  s.lastHeapPeak = h.heapPeak;
+  s.cpuUsTotal  += h.cpuUs;
+  if (h.wallMs   > s.maxMs)       s.maxMs       = h.wallMs;
+  if (h.cpuUs    > s.maxCpuUs)    s.maxCpuUs    = h.cpuUs;
+  if (h.heapPeak > s.maxHeapPeak) s.maxHeapPeak = h.heapPeak;
+  st.sessionHeapBytes = h.heapHeld;
+  return true;
 }
 
-void TelegramBotHandler::handleNewMessages(int n) {
-  for (int i = 0; i < n; ++i) {
-    const telegramMessage &msg = bot->messages[i];
-    String chat_id = msg.chat_id;
-    String text    = msg.text;
+// ===== Выполнение команд (задача telegram) =====
+void TelegramBotHandler::processInbox() {
+  if (!bot || !inbox) return;
 
+  if (networkUp && g_wifi.connected()) {
+    networkUp = false;
+    client.stop();   // старое TLS-соединение после обрыва уже мёртвое
+    if (wasOnline) notify("📶 Связь с Wi-Fi восстановлена");
+    wasOnline = true;
+  }
+
+  Inbound in;
+  while (xQueueReceive(inbox, &in, 0) == pdTRUE) {
     if (primaryChatId.length() == 0) {
-      primaryChatId = chat_id;
+      primaryChatId = in.chatId;
     }
 
-    handleCommand(chat_id, text);
+    if (in.queryId[0]) handleCallback(in);
+    else               handleCommand(in.chatId, in.text);
+
+    uint32_t latency = millis() - in.receivedMs;
+    st.lastLatencyMs = latency;
+    if (latency > st.maxLatencyMs) st.maxLatencyMs = latency;
   }
 }
 
-void TelegramBotHandler::handleCommand(const String &chat_id, const String &text) {
-  String t = text;
-  t.trim();
+void TelegramBotHandler::checkAlerts() {
+  if (!bot || !g_wifi.connected()) return;
+  if (!notificationsEnabled) return;
+  checkAndSendAlerts();
+}
 
-  if (t == "/start") {
-    sendMainMenu(chat_id);
-    return;
-  }
+// ===== Команды =====
+// Команда и кнопка — одна строка таблицы; кнопка без ввода передаёт fixed.
+// Порядок строк — номер в индексе и в счётчиках /metrics.
+const TelegramBotHandler::CommandSpec TelegramBotHandler::COMMANDS[] = {
+  // name            label                 arg         min  max fixed fn
+  { "/start",        "⬅ Назад",            ARG_NONE,   0,   0,   0, &TelegramBotHandler::cmdStart      },
+  { "/help",         nullptr,              ARG_NONE,   0,   0,   0, &TelegramBotHandler::cmdHelp       },
+  { "/status",       "📊 Статус",          ARG_NONE,   0,   0,   0, &TelegramBotHandler::cmdStatus     },
+  { "/perf",         nullptr,              ARG_NONE,   0,   0,   0, &TelegramBotHandler::cmdPerf       },
+  { "/trends",       nullptr,              ARG_NONE,   0,   0,   0, &TelegramBotHandler::cmdTrends     },
+  { "/auto_on",      "⚙ Авто ВКЛ",         ARG_NONE,   0,   0,   1, &TelegramBotHandler::cmdAuto       },
+  { "/auto_off",     "⏸ Авто ВЫКЛ",        ARG_NONE,   0,   0,   0, &TelegramBotHandler::cmdAuto       },
+  { "/water_now",    "💧 Полив",           ARG_NONE,   0,   0,   0, &TelegramBotHandler::cmdWater      },
+  { "/notify_on",    nullptr,              ARG_NONE,   0,   0,   1, &TelegramBotHandler::cmdNotify     },
+  { "/notify_off",   nullptr,              ARG_NONE,   0,   0,   0, &TelegramBotHandler::cmdNotify     },
+  { nullptr,         "🔔 Увед. ВКЛ/ВЫКЛ",  ARG_NONE,   0,   0,  -1, &TelegramBotHandler::cmdNotify     },
+  { "/profiles",     "🌡 Профили",         ARG_NONE,   0,   0,   0, &TelegramBotHandler::cmdProfiles   },
+  { "/profile",      nullptr,              ARG_INT,    1,   4,   0, &TelegramBotHandler::cmdProfile    },
+  { nullptr,         "🍅 Помидоры",        ARG_NONE,   0,   0,   1, &TelegramBotHandler::cmdProfile    },
+  { nullptr,         "🥒 Огурцы",          ARG_NONE,   0,   0,   2, &TelegramBotHandler::cmdProfile    },
+  { nullptr,         "🌿 Зелень",          ARG_NONE,   0,   0,   3, &TelegramBotHandler::cmdProfile    },
+  { nullptr,         "🌺 Гибискус",        ARG_NONE,   0,   0,   4, &TelegramBotHandler::cmdProfile    },
+  { "/scenes",       nullptr,              ARG_NONE,   0,   0,   0, &TelegramBotHandler::cmdScenes     },
+  { "/scene",        nullptr,              ARG_WORD,   0,   0,   0, &TelegramBotHandler::cmdScene      },
+  { "/set_soil_target", nullptr,           ARG_INT,   20,  90,   0, &TelegramBotHandler::cmdSoilTarget },
+  { "/settings",     nullptr,              ARG_NONE,   0,   0,   0, &TelegramBotHandler::cmdSettings   },
+};
+const uint8_t TelegramBotHandler::COMMAND_COUNT = sizeof(COMMANDS) / sizeof(COMMANDS[0]);
+
+// Копия с обрезкой по границе символа UTF-8 (подсказка кнопки короткая)
+static void utf8Copy(char *out, size_t cap, const char *s) {
+  if (strlcpy(out, s, cap) < cap) return;
+  size_t n = cap - 1;   // первый отброшенный байт; продолжение символа — режем раньше
+  while (n > 0 && ((uint8_t)s[n] & 0xC0) == 0x80) --n;
+  out[n] = '\0';
+}
 
-  if (t == "/help") {
-    sendHelp(chat_id);
-    return;
-  }
+static const char *const PROFILE_NAMES[] = { "custom", "помидоры", "огурцы", "зелень", "гибискус" };
 
-  if (t == "/status" || t == "📊 Статус") {
-    sendStatus(chat_id);
-    return;
+// Индекс имён и надписей кнопок; настройки — /set_<поле_в_snake_case>,
+// номер = COMMAND_COUNT + номер поля
+void TelegramBotHandler::buildCommandIndex() {
+  static_assert(sizeof(COMMANDS) / sizeof(COMMANDS[0]) <= MAX_COMMANDS, "MAX_COMMANDS is too small");
+
+  for (uint8_t i = 0; i < COMMAND_COUNT; ++i) {
+    if (COMMANDS[i].name)  commandIndex.add(COMMANDS[i].name, i);
+    if (COMMANDS[i].label) commandIndex.add(COMMANDS[i].label, i);
   }
 
-  if (t == "/auto_on" || t == "⚙ Авто ВКЛ") {
-    g_settings.automationEnabled = true;
-    g_eeprom.saveSettings(g_settings);
-    bot->sendMessageWithReplyKeyboard(chat_id,
-                                      "✅ Автоматика включена",
-                                      "HTML",
-                                      mainKeyboardJson(),
-                                      true);
-    return;
+  for (uint8_t f = 0; f < SettingsFields::count(); ++f) {
+    char  *out = settingNames[f];
+    size_t n   = strlcpy(out, "/set_", SETTING_NAME_MAX);
+    for (const char *k = SettingsFields::field(f).key; *k && n + 2 < SETTING_NAME_MAX; ++k) {
+      if (isupper((unsigned char)*k)) {
+        out[n++] = '_';
+        out[n++] = (char)tolower((unsigned char)*k);
+      } else {
+        out[n++] = *k;
+      }
+    }
+    out[n] = '\0';
+    commandIndex.add(out, COMMAND_COUNT + f);
   }
+}
 
-  if (t == "/auto_off" || t == "⏸ Авто ВЫКЛ") {
-    g_settings.automationEnabled = false;
-    g_eeprom.saveSettings(g_settings);
-    bot->sendMessageWithReplyKeyboard(chat_id,
-                                      "⏸ Автоматика выключена",
-                                      "HTML",
-                                      mainKeyboardJson(),
-                                      true);
-    return;
+uint8_t TelegramBotHandler::commandCount() const {
+  return COMMAND_COUNT + SettingsFields::count();
+}
+
+const char *TelegramBotHandler::commandName(uint8_t i) const {
+  if (i >= COMMAND_COUNT) return settingNames[i - COMMAND_COUNT];
+  return COMMANDS[i].name ? COMMANDS[i].name : COMMANDS[i].label;
+}
+
+// Разбор без String: сначала весь текст как надпись кнопки, затем первое
+// слово как команда (/status@bot — без суффикса), остаток — аргумент
+void TelegramBotHandler::handleCommand(const char *chatId, const char *text) {
+  char line[sizeof(Inbound::text)];
+  while (isspace((unsigned char)*text)) ++text;
+  size_t len = strlcpy(line, text, sizeof(line));
+  if (len >= sizeof(line)) len = sizeof(line) - 1;
+  while (len > 0 && isspace((unsigned char)line[len - 1])) line[--len] = '\0';
+
+  // Весь текст считается кнопкой, только если он совпал именно с надписью:
+  // голое «/scene» или «/profile» совпадает с именем в том же индексе и
+  // должно пройти разбор аргумента (и получить подсказку формата)
+  const char *args  = line + len;
+  uint8_t     id    = commandIndex.find(line, len);
+  bool        label = id < COMMAND_COUNT && COMMANDS[id].label &&
+                      strcmp(line, COMMANDS[id].label) == 0;
+
+  if (!label) {
+    size_t word = 0;
+    while (word < len && line[word] != ' ') ++word;
+    const char *at   = (const char *)memchr(line, '@', word);
+    size_t      name = at ? (size_t)(at - line) : word;
+
+    id   = commandIndex.find(line, name);
+    args = line + word;
+    while (*args == ' ') ++args;
   }
 
-  if (t == "/water_now" || t == "💧 Полив") {
-    g_devices.setPump(true, 1200);
-    bot->sendMessageWithReplyKeyboard(chat_id,
-                                      "💧 Запущен импульсный полив",
-                                      "HTML",
-                                      mainKeyboardJson(),
-                                      true);
+  if (id == CommandIndex::NONE) {
+    st.unknownCommands++;
+    reply(chatId, "Неизвестная команда. Нажми кнопку или /help");
     return;
   }
-
-  if (t == "/notify_on") {
-    notificationsEnabled = true;
-    bot->sendMessageWithReplyKeyboard(chat_id,
-                                      "🔔 Уведомления включены",
-                                      "HTML",
-                                      mainKeyboardJson(),
-                                      true);
+  calls[id]++;
+
+  // Настройка из таблицы SettingsFields
+  if (id >= COMMAND_COUNT) {
+    const SettingsFields::Field &f = SettingsFields::field(id - COMMAND_COUNT);
+    CommandArg arg;
+    if (!parseArg(f.kind == SettingsFields::KIND_U8 ? ARG_INT : ARG_NUMBER, f.min, f.max, args, arg)) {
+      st.badArguments++;
+      reply(chatId, String("⚠️ Формат: ") + settingNames[id - COMMAND_COUNT] + " " +
+                    String(f.min, f.decimals) + "…" + String(f.max, f.decimals));
+      return;
+    }
+    applySetting(chatId, f, arg.num);
     return;
   }
 
-  if (t == "/notify_off") {
-    notificationsEnabled = false;
-    bot->sendMessageWithReplyKeyboard(chat_id,
-                                      "🔕 Уведомления выключены",
-                                      "HTML",
-                                      mainKeyboardJson(),
-                                      true);
+  const CommandSpec &c = COMMANDS[id];
+  CommandArg arg;
+  arg.num = c.fixed;
+  if (!label && !parseArg(c.arg, c.min, c.max, args, arg)) {
+    st.badArguments++;
+    String usage = String("⚠️ Формат: ") + c.name;
+    if (c.arg == ARG_WORD) usage += " имя";
+    else                   usage += " " + String(c.min) + "…" + String(c.max);
+    reply(chatId, usage);
     return;
   }
+  (this->*c.fn)(chatId, arg);
+}
 
-  if (t == "🔔 Увед. ВКЛ/ВЫКЛ") {
-    notificationsEnabled = !notificationsEnabled;
-    bot->sendMessageWithReplyKeyboard(chat_id,
-                                      notificationsEnabled ? "🔔 Уведомления включены"
-                                                           : "🔕 Уведомления выключены",
-                                      "HTML",
-                                      mainKeyboardJson(),
-                                      true);
-    return;
+// Строгий разбор: число целиком и в диапазоне, целое — без дробной части
+bool TelegramBotHandler::parseArg(ArgKind kind, float min, float max, const char *s, CommandArg &out) {
+  size_t len = strlen(s);
+  double x;
+  size_t used = 0;
+
+  switch (kind) {
+    case ARG_NONE:
+      return true;
+    case ARG_WORD:
+      out.word = s;
+      return len > 0;
+    case ARG_INT:
+    case ARG_NUMBER:
+      if (!JsonReader::parseNumber(s, len, x, &used) || used != len) return false;
+      // Сначала диапазон: приведение к целому вне его — неопределённое поведение
+      if (!(x >= min && x <= max)) return false;
+      if (kind == ARG_INT && floor(x) != x) return false;
+      out.num = x;
+      return true;
   }
+  return false;
+}
 
-  if (t == "🌡 Профили" || t == "/profiles") {
-    sendProfileMenu(chat_id);
-    return;
+// Как POST /api/settings: проверка на копии, запись в EEPROM только при успехе
+void TelegramBotHandler::applySetting(const char *chatId, const SettingsFields::Field &f, double value,
+                                      const char *okText) {
+  SettingsFields::Result res;
+  double                 now;
+  {
+    ControlLock    lock;
+    SystemSettings next = g_settings;
+    res = SettingsFields::applyNumber(next, f, value);
+    if (res == SettingsFields::OK) {
+      g_settings = next;
+      g_eeprom.saveSettings(g_settings);
+    }
+    now = SettingsFields::read(g_settings, f);
   }
 
-  // Быстрая смена профиля кнопками
-  if (t == "🍅 Помидоры") {
-    applyCropProfile(1, g_settings);
-    g_eeprom.saveSettings(g_settings);
-    bot->sendMessageWithReplyKeyboard(chat_id,
-        "✅ Профиль: помидоры", "HTML", mainKeyboardJson(), true);
-    return;
+  if (res != SettingsFields::OK) {
+    reply(chatId, String("⚠️ ") + f.key + ": " + SettingsFields::resultName(res));
+  } else if (okText) {
+    reply(chatId, String(okText) + String(now, f.decimals));
+  } else {
+    reply(chatId, String("✅ ") + f.key + " = " + String(now, f.decimals));
   }
-  if (t == "🥒 Огурцы") {
-    applyCropProfile(2, g_settings);
+}
+
+void TelegramBotHandler::cmdStart(const char *chatId, const CommandArg &) {
+  String msg = "Привет! Это умная теплица ЙоТик M2.\n"
+               "Нажимай кнопки или введи /help для списка команд.";
+  reply(chatId, msg, TelegramOutbox::KEYBOARD_MAIN);
+}
+
+void TelegramBotHandler::cmdAuto(const char *chatId, const CommandArg &arg) {
+  bool on = arg.num != 0;
+  {
+    ControlLock lock;
+    g_settings.automationEnabled = on;
     g_eeprom.saveSettings(g_settings);
-    bot->sendMessageWithReplyKeyboard(chat_id,
-        "✅ Профиль: огурцы", "HTML", mainKeyboardJson(), true);
-    return;
   }
-  if (t == "🌿 Зелень") {
-    applyCropProfile(3, g_settings);
-    g_eeprom.saveSettings(g_settings);
-    bot->sendMessageWithReplyKeyboard(chat_id,
-        "✅ Профиль: зелень", "HTML", mainKeyboardJson(), true);
-    return;
+  reply(chatId, on ? "✅ Автоматика включена" : "⏸ Автоматика выключена");
+}
+
+void TelegramBotHandler::cmdWater(const char *chatId, const CommandArg &) {
+  {
+    ControlLock lock;
+    g_devices.setPump(true, 1200);
   }
-  if (t == "🌺 Гибискус") {
-    applyCropProfile(4, g_settings);
+  reply(chatId, "💧 Запущен импульсный полив");
+}
+
+// 1 / 0 — включить / выключить, -1 — переключить (кнопка)
+void TelegramBotHandler::cmdNotify(const char *chatId, const CommandArg &arg) {
+  notificationsEnabled = arg.num < 0 ? !notificationsEnabled : arg.num != 0;
+  reply(chatId, notificationsEnabled ? "🔔 Уведомления включены"
+                                     : "🔕 Уведомления выключены");
+}
+
+void TelegramBotHandler::cmdProfiles(const char *chatId, const CommandArg &) {
+  reply(chatId, "Выбери профиль культуры:", TelegramOutbox::KEYBOARD_PROFILES);
+}
+
+void TelegramBotHandler::cmdProfile(const char *chatId, const CommandArg &arg) {
+  uint8_t id = (uint8_t)arg.num;
+  {
+    ControlLock lock;
+    applyCropProfile(id, g_settings);
     g_eeprom.saveSettings(g_settings);
-    bot->sendMessageWithReplyKeyboard(chat_id,
-        "✅ Профиль: гибискус", "HTML", mainKeyboardJson(), true);
-    return;
   }
+  reply(chatId, String("✅ Профиль: ") + PROFILE_NAMES[id]);
+}
 
-  // Команды типа /set_soil_target 60
-  if (t.startsWith("/set_soil_target")) {
-    int val = t.substring(String("/set_soil_target").length()).toInt();
-    if (val >= 20 && val <= 90) {
-      g_settings.soilMoistureSetpoint = (float)val;
-      g_eeprom.saveSettings(g_settings);
-      bot->sendMessageWithReplyKeyboard(chat_id,
-        "✅ Целевая влажность почвы: " + String(val) + "%",
-        "HTML",
-        mainKeyboardJson(),
-        true);
-    } else {
-      bot->sendMessage(chat_id,
-        "⚠️ Значение должно быть от 20 до 90",
-        "HTML");
-    }
-    return;
+void TelegramBotHandler::cmdSoilTarget(const char *chatId, const CommandArg &arg) {
+  applySetting(chatId, *SettingsFields::find("soilMoistureSetpoint"), arg.num,
+               "✅ Целевая влажность почвы, %: ");
+}
+
+// Текущие значения всех настроек с командами для их изменения
+void TelegramBotHandler::cmdSettings(const char *chatId, const CommandArg &) {
+  SystemSettings s;
+  {
+    ControlLock lock;
+    s = g_settings;
   }
 
-  // Если ничего не узнали
-  bot->sendMessageWithReplyKeyboard(chat_id,
-    "Неизвестная команда. Нажми кнопку или /help",
-    "HTML",
-    mainKeyboardJson(),
-    true);
+  String msg;
+  msg.reserve(768);
+  msg = "🛠 <b>Настройки</b>\n\n";
+  for (uint8_t i = 0; i < SettingsFields::count(); ++i) {
+    const SettingsFields::Field &f = SettingsFields::field(i);
+    msg += settingNames[i];
+    msg += " ";
+    msg += String(SettingsFields::read(s, f), f.decimals);
+    msg += "\n";
+  }
+  reply(chatId, msg);
 }
 
-void TelegramBotHandler::sendStatus(const String &chat_id) {
+void TelegramBotHandler::cmdStatus(const char *chatId, const CommandArg &) {
+  // «Обновить» под статусом: сообщение перерисует handleCallback
+  if (cb.active && cb.view == VIEW_STATUS) return;
+
   String msg;
+  renderStatus(msg, g_sensorStore.snapshot());
+  reply(chatId, msg, TelegramOutbox::KEYBOARD_STATUS);
+}
+
+void TelegramBotHandler::renderStatus(String &msg, const SensorData &sd) {
   msg.reserve(512);
 
   msg  = "🌱 <b>Состояние теплицы</b>\n\n";
   msg += "🌡 Воздух: ";
-  msg += String(g_sensorData.airTemperature,1);
+  msg += String(sd.airTemperature,1);
   msg += "°C, ";
-  msg += String(g_sensorData.airHumidity,1);
+  msg += String(sd.airHumidity,1);
   msg += "%\n";
 
   msg += "🌱 Почва: ";
-  msg += String(g_sensorData.soilMoisture,1);
+  msg += String(sd.soilMoisture,1);
   msg += "%\n";
 
   msg += "💡 Свет: ";
-  msg += String(g_sensorData.lightLevelLux,1);
+  msg += String(sd.lightLevelLux,1);
   msg += " lux\n\n";
 
   msg += "⚙️ Автоматика: ";
@@ -236,59 +491,138 @@ void TelegramBotHandler::sendStatus(const String &chat_id) {
   msg += "\n";
 
   msg += "🚿 Насос: ";
-  msg += (g_sensorData.pumpOn ? "ВКЛ" : "ВЫКЛ");
+  msg += (sd.pumpOn ? "ВКЛ" : "ВЫКЛ");
   msg += "\n";
 
   msg += "🌀 Вентиляция: ";
-  msg += (g_sensorData.fanOn ? "ВКЛ" : "ВЫКЛ");
+  msg += (sd.fanOn ? "ВКЛ" : "ВЫКЛ");
   msg += "\n";
 
   msg += "🚪 Дверь: ";
-  msg += (g_sensorData.doorOpen ? "ОТКРЫТА" : "ЗАКРЫТА");
+  msg += (sd.doorOpen ? "ОТКРЫТА" : "ЗАКРЫТА");
   msg += "\n";
 
   msg += "🥗 Профиль: ";
-  switch (g_settings.cropProfile) {
-    case 1: msg += "помидоры"; break;
-    case 2: msg += "огурцы";   break;
-    case 3: msg += "зелень";   break;
-    case 4: msg += "гибискус"; break;
-    default: msg += "custom";  break;
+  msg += PROFILE_NAMES[g_settings.cropProfile <= 4 ? g_settings.cropProfile : 0];
+}
+
+void TelegramBotHandler::cmdPerf(const char *chatId, const CommandArg &) {
+  String msg;
+  msg.reserve(512);
+
+  msg  = "⏱ <b>Время подсистем</b> (мкс: avg / p99 / max)\n\n";
+  for (uint8_t c = 0; c < Perf::CHANNEL_COUNT; ++c) {
+    Perf::Channel   ch = (Perf::Channel)c;
+    Perf::Histogram h  = Perf::snapshot(ch);
+    msg += "<code>";
+    msg += Perf::channelName(ch);
+    msg += "</code>: ";
+    msg += String(h.avgUs());
+    msg += " / ";
+    msg += String(h.percentileUs(99));
+    msg += " / ";
+    msg += String(h.maxUs);
+    msg += " (n=";
+    msg += String(h.count);
+    msg += ")\n";
   }
 
-  bot->sendMessageWithReplyKeyboard(chat_id,
-                                    msg,
-                                    "HTML",
-                                    mainKeyboardJson(),
-                                    true);
+  reply(chatId, msg);
 }
 
-void TelegramBotHandler::sendMainMenu(const String &chat_id) {
-  String msg = "Привет! Это умная теплица ЙоТик M2.\n"
-               "Нажимай кнопки или введи /help для списка команд.";
-  bot->sendMessageWithReplyKeyboard(chat_id,
-                                    msg,
-                                    "HTML",
-                                    mainKeyboardJson(),
-                                    true);
+void TelegramBotHandler::cmdTrends(const char *chatId, const CommandArg &) {
+  static const char *const LABELS[Channels::COUNT] = {
+    "🌡 Воздух, °C", "💦 Влажность, %", "🧭 Давление, гПа", "🌱 Почва, %", "💡 Свет, lux"
+  };
+
+  String msg;
+  msg.reserve(640);
+  msg = "📈 <b>Тренды</b> (min / avg / max)\n\n";
+
+  for (uint8_t c = 0; c < Channels::COUNT; ++c) {
+    Rollup::Stat day  = g_rollup.window(Rollup::LEVEL_15M, c, Rollup::CAP_15M);
+    Rollup::Stat week = g_rollup.window(Rollup::LEVEL_1H,  c, Rollup::CAP_1H);
+
+    msg += LABELS[c];
+    msg += "\n  24 ч: ";
+    if (day.count) {
+      msg += String(day.min, 1) + " / " + String(day.avg, 1) + " / " + String(day.max, 1);
+    } else {
+      msg += "нет данных";
+    }
+    msg += "\n  7 д: ";
+    if (week.count) {
+      msg += String(week.min, 1) + " / " + String(week.avg, 1) + " / " + String(week.max, 1);
+    } else {
+      msg += "нет данных";
+    }
+    msg += "\n";
+  }
+
+  reply(chatId, msg);
 }
 
-void TelegramBotHandler::sendProfileMenu(const String &chat_id) {
-  // Отдельная клавиатура для выбора профиля
-  String k = "["
-             "[\"🍅 Помидоры\",\"🥒 Огурцы\"],"
-             "[\"🌿 Зелень\",\"🌺 Гибискус\"],"
-             "[\"⬅ Назад\"]"
-             "]";
-  String msg = "Выбери профиль культуры:";
-  bot->sendMessageWithReplyKeyboard(chat_id,
-                                    msg,
-                                    "HTML",
-                                    k,
-                                    true);
+void TelegramBotHandler::cmdScenes(const char *chatId, const CommandArg &) {
+  String msg = "🎬 <b>Сцены</b>\n\n";
+  {
+    ControlLock lock;
+    if (g_scenes.count() == 0) {
+      msg += "Сцен нет. Создаются через POST /api/scenes.";
+    }
+    for (uint8_t i = 0; i < g_scenes.count(); ++i) {
+      const Scene &s = g_scenes.at(i);
+      msg += "<code>/scene ";
+      msg += s.name;
+      msg += "</code>:";
+      for (uint8_t c = 0; c < s.count; ++c) {
+        msg += " ";
+        msg += Commands::deviceName(s.cmds[c].device);
+        msg += "=";
+        msg += Commands::actionName(s.cmds[c].action);
+      }
+      msg += "\n";
+    }
+  }
+
+  reply(chatId, msg);
+}
+
+void TelegramBotHandler::cmdScene(const char *chatId, const CommandArg &arg) {
+  if (!arg.word || !*arg.word) {
+    reply(chatId, "⚠️ Формат: /scene имя");
+    return;
+  }
+
+  Scene scene;
+  bool  found;
+  {
+    ControlLock lock;
+    const Scene *s = g_scenes.find(arg.word);
+    found = s != nullptr;
+    if (found) scene = *s;
+  }
+  if (!found) {
+    reply(chatId, "⚠️ Сцена не найдена. Список: /scenes");
+    return;
+  }
+
+  uint32_t atMs[Scene::MAX_COMMANDS];
+  Commands::applyAll(scene.cmds, scene.count, atMs);
+
+  String msg = String("🎬 Сцена <b>") + arg.word + "</b> выполнена\n";
+  for (uint8_t c = 0; c < scene.count; ++c) {
+    msg += "• ";
+    msg += Commands::deviceName(scene.cmds[c].device);
+    msg += " → ";
+    msg += Commands::actionName(scene.cmds[c].action);
+    msg += " (t=";
+    msg += String(atMs[c]);
+    msg += " мс)\n";
+  }
+  reply(chatId, msg);
 }
 
-void TelegramBotHandler::sendHelp(const String &chat_id) {
+void TelegramBotHandler::cmdHelp(const char *chatId, const CommandArg &) {
   String msg;
   msg  = "🌱 <b>Умная теплица ЙоТик M2</b>\n\n";
   msg += "<b>Основные команды:</b>\n";
@@ -302,44 +636,215 @@ void TelegramBotHandler::sendHelp(const String &chat_id) {
   msg += "<code>/notify_on</code>, <code>/notify_off</code>\n";
   msg += "<code>/water_now</code>\n";
   msg += "<code>/set_soil_target 60</code> — целевая влажность почвы\n";
-  msg += "<code>/profiles</code> — меню профилей\n";
-  bot->sendMessageWithReplyKeyboard(chat_id,
-                                    msg,
-                                    "HTML",
-                                    mainKeyboardJson(),
-                                    true);
+  msg += "<code>/settings</code> — все настройки; <code>/set_поле значение</code> — изменить\n";
+  msg += "<code>/profiles</code> — меню профилей, <code>/profile 1..4</code> — выбор\n";
+  msg += "<code>/trends</code> — тренды за 24 ч и 7 дней\n";
+  msg += "<code>/perf</code> — время работы подсистем\n";
+  msg += "<code>/scenes</code>, <code>/scene имя</code> — сцены\n";
+  reply(chatId, msg);
 }
 
 void TelegramBotHandler::checkAndSendAlerts() {
-  unsigned long now = millis();
+  SensorData sd = g_sensorStore.snapshot();
 
   bool sensorProblem = false;
   String sensorMsg;
 
-  if (isnan(g_sensorData.airTemperature) || isnan(g_sensorData.airHumidity)) {
+  if (isnan(sd.airTemperature) || isnan(sd.airHumidity)) {
     sensorProblem = true;
     sensorMsg += "Датчик климата (BME280) не отвечает.\n";
   }
-  if (isnan(g_sensorData.soilMoisture)) {
+  if (isnan(sd.soilMoisture)) {
     sensorProblem = true;
     sensorMsg += "Датчик влажности почвы не отвечает.\n";
   }
-  if (isnan(g_sensorData.lightLevelLux)) {
+  if (isnan(sd.lightLevelLux)) {
     sensorProblem = true;
     sensorMsg += "Датчик освещённости (BH1750) не отвечает.\n";
   }
 
-  if (sensorProblem && (now - lastSensorAlertMs > ALERT_INTERVAL_MS)) {
-    String msg = "⚙️ Проблемы с датчиками:\n" + sensorMsg;
-    if (primaryChatId.length() > 0) {
-      bot->sendMessage(primaryChatId, msg, "HTML");
-    }
-    lastSensorAlertMs = now;
-  }
+  // Каждые ALERT_CHECK_MS; повторы склеивает очередь исходящих
+  if (sensorProblem) alert("⚙️ Проблемы с датчиками:\n" + sensorMsg);
 }
 
+// ===== Исходящие =====
+// Постановка не блокирует и не ходит в сеть: отправит flushOutbox()
 void TelegramBotHandler::notify(const String &msg) {
   if (!bot) return;
   if (primaryChatId.length() == 0) return;
-  bot->sendMessage(primaryChatId, msg, "HTML");
+  enqueued(outbox.push(primaryChatId.c_str(), msg.c_str()));
+}
+
+void TelegramBotHandler::alert(const String &msg) {
+  if (!bot) return;
+  if (primaryChatId.length() == 0) return;
+  enqueued(outbox.pushAlert(primaryChatId.c_str(), msg.c_str(), ALERT_INTERVAL_MS));
+}
+
+void TelegramBotHandler::reply(const char *chatId, const String &text,
+                               TelegramOutbox::Keyboard keyboard) {
+  if (cb.active) {
+    if (cb.view == VIEW_STATUS) {
+      utf8Copy(cb.toast, sizeof(cb.toast), text.c_str());
+    } else {
+      enqueued(outbox.push(chatId, text.c_str(), keyboard, cb.messageId));
+    }
+    return;
+  }
+  enqueued(outbox.push(chatId, text.c_str(), keyboard));
+}
+
+// ===== Inline-кнопки =====
+// Нажатие — та же команда из таблицы, но ответ не новым сообщением:
+// под статусом — подсказка и перерисовка статуса, в меню — правка меню.
+// answerCallbackQuery нужен всегда, иначе у кнопки висит индикатор.
+void TelegramBotHandler::handleCallback(const Inbound &in) {
+  st.callbacks++;
+
+  const char *data = in.text;
+  char        view = 0;
+  if (data[0] && data[1] == ':') {
+    view  = data[0];
+    data += 2;
+  }
+
+  cb.active    = true;
+  cb.view      = view;
+  cb.messageId = in.messageId;
+  cb.toast[0]  = '\0';
+
+  handleCommand(in.chatId, data);
+  if (view == VIEW_STATUS) refreshStatus(in.chatId, in.messageId);
+
+  cb.active = false;
+
+  if (answerCount < INBOX_DEPTH) {
+    Answer &a = answers[answerCount++];
+    strlcpy(a.queryId, in.queryId, sizeof(a.queryId));
+    strlcpy(a.text,    cb.toast,   sizeof(a.text));
+    g_runtime.telegramScheduler().reschedule(outboxJob, 0);
+  }
+}
+
+// Статус по рабочей копии: команда кнопки только что применена, а снимок
+// задача управления опубликует лишь на следующем проходе. Совпал с тем,
+// что уже показано, — запроса к API нет (Telegram всё равно ответил бы
+// «message is not modified»).
+void TelegramBotHandler::refreshStatus(const char *chatId, int32_t messageId) {
+  SensorData sd;
+  {
+    ControlLock lock;
+    sd = g_sensorData;
+  }
+  String msg;
+  renderStatus(msg, sd);
+
+  StatusView *v = findView(fnv1a(chatId), messageId);
+  if (v && v->textHash == fnv1a(msg.c_str(), msg.length())) {
+    st.statusUnchanged++;
+    if (!cb.toast[0]) strlcpy(cb.toast, "Без изменений", sizeof(cb.toast));
+    return;
+  }
+  enqueued(outbox.push(chatId, msg.c_str(), TelegramOutbox::KEYBOARD_STATUS, messageId));
+}
+
+TelegramBotHandler::StatusView *TelegramBotHandler::findView(uint32_t chatHash, int32_t messageId) {
+  for (StatusView &v : views) {
+    if (v.chatHash == chatHash && v.messageId == messageId) return &v;
+  }
+  return nullptr;
+}
+
+void TelegramBotHandler::sendAnswers() {
+  for (uint8_t i = 0; i < answerCount; ++i) {
+    st.apiAnswers++;
+    st.payloadBytes += strlen(answers[i].text);
+    if (!bot->answerCallbackQuery(answers[i].queryId, answers[i].text)) client.stop();
+  }
+  answerCount = 0;
+}
+
+void TelegramBotHandler::enqueued(bool ok) {
+  if (ok) g_runtime.telegramScheduler().reschedule(outboxJob, 0);
+  else    Serial.println(F("⚠️ Telegram: очередь исходящих полна, сообщение отброшено"));
+}
+
+// Отправка по одному сообщению, пока есть готовые; ошибку отправки очередь
+// повторит позже. Если что-то созреет раньше страховочного периода —
+// задача перепланируется на этот момент.
+void TelegramBotHandler::flushOutbox() {
+  if (!bot || !g_wifi.connected()) return;
+
+  if (answerCount > 0 && connectTls(client)) sendAnswers();
+
+  unsigned long waitMs;
+  int8_t        slot;
+  while ((slot = outbox.take(millis(), waitMs)) >= 0) {
+    const TelegramOutbox::Message &m = outbox.message(slot);
+
+    String text(m.text);
+    if (m.repeats > 0) {
+      text += "\n🔁 Повторялось ещё ";
+      text += String(m.repeats);
+      text += " раз(а)";
+    }
+
+    // Статус: что показано в сообщении — после отправки; правка, которую
+    // уже опередила такая же, не отправляется
+    bool        status   = m.keyboard == TelegramOutbox::KEYBOARD_STATUS;
+    uint32_t    chatHash = status ? fnv1a(m.chatId) : 0;
+    uint32_t    textHash = status ? fnv1a(m.text) : 0;
+    StatusView *v        = status && m.editId ? findView(chatHash, m.editId) : nullptr;
+    if (v && v->textHash == textHash) {
+      st.statusUnchanged++;
+      outbox.complete(slot, true, millis());
+      continue;
+    }
+
+    bool ok = connectTls(client);
+    if (ok) {
+      String keyboard;
+      switch (m.keyboard) {
+        case TelegramOutbox::KEYBOARD_MAIN:
+          keyboard = mainKeyboardJson();
+          ok = bot->sendMessageWithReplyKeyboard(m.chatId, text, "HTML", keyboard, true);
+          break;
+        case TelegramOutbox::KEYBOARD_STATUS:
+          keyboard = statusKeyboardJson();
+          ok = bot->sendMessageWithInlineKeyboard(m.chatId, text, "HTML", keyboard, m.editId);
+          break;
+        case TelegramOutbox::KEYBOARD_PROFILES:
+          keyboard = profileKeyboardJson();
+          ok = bot->sendMessageWithInlineKeyboard(m.chatId, text, "HTML", keyboard, m.editId);
+          break;
+        default:
+          ok = bot->sendMessage(m.chatId, text, "HTML", m.editId);
+          break;
+      }
+      if (m.editId) st.apiEdits++;
+      else          st.apiSends++;
+      uint32_t bytes = text.length() + keyboard.length();
+      st.payloadBytes += bytes;
+      if (status) st.statusPayloadBytes += bytes;
+      if (!ok) client.stop();   // после ошибки соединение могло остаться в непонятном состоянии
+    }
+    // complete() возвращает слот в очередь — после него m может занять
+    // другая задача, поэтому номер правки берём до
+    int32_t editId = m.editId;
+    outbox.complete(slot, ok, millis());
+
+    if (ok && status) {
+      if (editId) st.statusEdits++;
+      else        st.statusSends++;
+      if (!v) {
+        v = &views[nextView];
+        nextView = (nextView + 1) % STATUS_VIEWS;
+      }
+      v->chatHash  = chatHash;
+      v->messageId = editId ? editId : bot->last_sent_message_id;
+      v->textHash  = textHash;
+    }
+  }
+
+  if (waitMs < OUTBOX_CHECK_MS) g_runtime.telegramScheduler().reschedule(outboxJob, waitMs);
 }
\ No newline at end of file
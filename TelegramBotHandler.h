@@ -7,41 +7,225 @@
 #include "Devices.h"
 #include "Automation.h"
 #include "EEPROMManager.h"
+#include "TelegramOutbox.h"
+#include "CommandIndex.h"
+#include "SettingsFields.h"
+#include "TlsClient.h"
 
 #include <WiFi.h>
-#include <WiFiClientSecure.h>
 #include <UniversalTelegramBot.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
 
 class TelegramBotHandler {
 public:
   void begin();
-  void loop();
 
+  // Приём: long polling getUpdates в собственной задаче tg_rx (бесконечный
+  // цикл, см. Runtime). Сообщения кладутся в ограниченную очередь inbox.
+  void receiveLoop();
+
+  // Задачи планировщика сетевой задачи Telegram
+  void processInbox();  // выполнение принятых команд; будится приёмом
+  void flushOutbox();   // отправка из очереди исходящих; будится постановкой
+  void checkAlerts();   // проверка датчиков, период ALERT_CHECK_MS
+
+  // id задач в планировщике Telegram — для пробуждения
+  void attachInboxJob(int8_t id)  { inboxJob = id; }
+  void attachOutboxJob(int8_t id) { outboxJob = id; }
+
+  // Сообщение в основной чат. Из любой задачи: только ставит в очередь
   void notify(const String &msg);
+  // То же для аварий: повторы в окне ALERT_INTERVAL_MS склеиваются
+  void alert(const String &msg);
+
+  const TelegramOutbox::Stats &outboxStats() const { return outbox.stats(); }
+  uint8_t outboxPending() const { return outbox.pending(); }
+
+  // Вызывается WifiManager при (пере)подключении к Wi-Fi, из задачи web
+  void onNetworkUp() { networkUp = true; rxReset = true; }
+
+  static constexpr unsigned long INBOX_CHECK_MS    = 1000;   // страховка, обычно будит приём
+  static constexpr unsigned long OUTBOX_CHECK_MS   = 1000;   // страховка, обычно будит постановка
+  static constexpr unsigned long ALERT_CHECK_MS    = 10000;
+
+  // Счётчики приёма (пишет tg_rx и обработчик, читают /metrics и диагностика)
+  struct Stats {
+    // TLS-рукопожатия (приём и отправка): [0] — полные, [1] — возобновлённые
+    struct Handshakes {
+      uint32_t count        = 0;
+      uint32_t lastMs       = 0;   // с DNS, TCP и ожиданием сети
+      uint32_t maxMs        = 0;
+      uint32_t lastCpuUs    = 0;   // только шаги mbedtls
+      uint32_t maxCpuUs     = 0;
+      uint64_t cpuUsTotal   = 0;
+      uint32_t lastHeapPeak = 0;   // наибольший расход кучи в ходе рукопожатия
+      uint32_t maxHeapPeak  = 0;
+    };
+    Handshakes tls[2];
+    uint32_t tlsFailures      = 0;   // не удалось соединиться / проверить цепочку
+    uint32_t pinFailures      = 0;   // не совпал отпечаток CERT_SHA256
+    uint32_t sessionHeapBytes = 0;   // куча, занятая одним TLS-соединением
+    uint32_t polls            = 0;
+    uint32_t pollErrors       = 0;
+    uint32_t received         = 0;
+    uint32_t dropped          = 0;   // очередь команд была полна
+    uint32_t lastLatencyMs    = 0;   // приём → команда выполнена
+    uint32_t maxLatencyMs     = 0;
+    uint32_t unknownCommands  = 0;
+    uint32_t badArguments     = 0;
+    uint32_t callbacks        = 0;   // нажатия inline-кнопок
+    uint32_t statusSends      = 0;   // статус новым сообщением
+    uint32_t statusEdits      = 0;   // статус обновлён на месте
+    uint32_t statusUnchanged  = 0;   // «Обновить» без изменений — запроса к API нет
+    // Исходящие запросы к Bot API (задача telegram), включая неудачные
+    uint32_t apiSends         = 0;   // sendMessage
+    uint32_t apiEdits         = 0;   // editMessageText
+    uint32_t apiAnswers       = 0;   // answerCallbackQuery
+    // Полезная нагрузка: текст + разметка кнопок, без обёртки JSON и HTTP
+    uint32_t payloadBytes       = 0;
+    uint32_t statusPayloadBytes = 0;
+  };
+  const Stats &stats() const { return st; }
+
+  // Команды: таблица COMMANDS и /set_… по SettingsFields; счётчик на каждую
+  static constexpr uint8_t MAX_COMMANDS = 24;
+  static constexpr uint8_t MAX_ROUTES   = MAX_COMMANDS + SettingsFields::MAX_FIELDS;
+
+  uint8_t     commandCount() const;
+  const char *commandName(uint8_t i) const;
+  uint32_t    commandCalls(uint8_t i) const { return calls[i]; }
 
 private:
-  WiFiClientSecure      client;
+  // Два соединения: rx держит long poll, tx отправляет ответы и уведомления.
+  // У каждого своя сохранённая TLS-сессия
+  TlsClient             client;
   UniversalTelegramBot* bot = nullptr;
+  TlsClient             rxClient;
+  UniversalTelegramBot* rxBot = nullptr;
+
+  // Сообщение или нажатие inline-кнопки (queryId не пуст, text — её data)
+  struct Inbound {
+    char     chatId[24];
+    char     text[128];
+    char     queryId[24];
+    int32_t  messageId;    // сообщение с нажатой кнопкой
+    uint32_t receivedMs;
+  };
+  static constexpr uint8_t       INBOX_DEPTH     = 8;
+  static constexpr int           LONG_POLL_S     = 25;      // timeout= в getUpdates
+  static constexpr unsigned long RX_RETRY_MIN_MS = 2000;    // пауза после ошибки приёма,
+  static constexpr unsigned long RX_RETRY_MAX_MS = 60000;   // удваивается до максимума
+
+  QueueHandle_t  inbox     = nullptr;
+  int8_t         inboxJob  = -1;
+  TelegramOutbox outbox;
+  int8_t         outboxJob = -1;
+  Stats          st;
 
   String primaryChatId;
   bool   notificationsEnabled = true;
 
-  unsigned long lastPollMs        = 0;
-  unsigned long lastSensorAlertMs = 0;
+  volatile bool networkUp  = false;   // см. onNetworkUp()
+  volatile bool rxReset    = false;
+  bool          wasOnline  = false;   // связь уже была — сообщаем о восстановлении
 
-  static constexpr unsigned long POLL_INTERVAL_MS  = 3000;
-  static constexpr unsigned long ALERT_CHECK_MS    = 10000;
   static constexpr unsigned long ALERT_INTERVAL_MS = 15UL*60UL*1000UL;
 
-  void handleNewMessages(int n);
-  void handleCommand(const String &chat_id, const String &text);
-  void sendStatus(const String &chat_id);
-  void sendHelp(const String &chat_id);
-  void sendMainMenu(const String &chat_id);
-  void sendProfileMenu(const String &chat_id);
+  // data inline-кнопки — «вид:команда». Под статусом ответ команды — всплывающая
+  // подсказка, а сам статус перерисовывается; в меню ответ заменяет меню.
+  static constexpr char VIEW_STATUS = 's';
+  static constexpr char VIEW_MENU   = 'm';
+
+  struct Callback {
+    bool    active = false;
+    char    view   = 0;
+    int32_t messageId = 0;
+    char    toast[64] = "";
+  };
+  Callback cb;   // только задача telegram — на время handleCallback
+
+  // answerCallbackQuery ждут отправки в flushOutbox (та же задача)
+  struct Answer {
+    char queryId[24];
+    char text[64];
+  };
+  Answer  answers[INBOX_DEPTH];
+  uint8_t answerCount = 0;
+
+  // Что показывает сообщение со статусом — чтобы не править его без изменений
+  struct StatusView {
+    uint32_t chatHash  = 0;
+    int32_t  messageId = 0;
+    uint32_t textHash  = 0;
+  };
+  static constexpr uint8_t STATUS_VIEWS = 4;
+  StatusView views[STATUS_VIEWS];
+  uint8_t    nextView = 0;
+
+  // Аргумент после разбора по ArgKind; word указывает в текст сообщения
+  struct CommandArg {
+    double      num  = 0;
+    const char *word = nullptr;
+  };
+  typedef void (TelegramBotHandler::*CommandFn)(const char *chatId, const CommandArg &arg);
+
+  enum ArgKind : uint8_t { ARG_NONE, ARG_INT, ARG_NUMBER, ARG_WORD };
+
+  struct CommandSpec {
+    const char *name;     // "/status"; nullptr — только кнопка
+    const char *label;    // текст кнопки; nullptr — нет
+    ArgKind     arg;
+    int16_t     min;      // диапазон ARG_INT / ARG_NUMBER
+    int16_t     max;
+    int8_t      fixed;    // аргумент команды без ввода (кнопки профилей и т.п.)
+    CommandFn   fn;
+  };
+  static const CommandSpec COMMANDS[];
+  static const uint8_t     COMMAND_COUNT;
+
+  static constexpr uint8_t SETTING_NAME_MAX = 40;
+
+  CommandIndex commandIndex;
+  char         settingNames[SettingsFields::MAX_FIELDS][SETTING_NAME_MAX];
+  uint32_t     calls[MAX_ROUTES] = {};
+
+  void buildCommandIndex();
+  void handleCommand(const char *chatId, const char *text);
+  void handleCallback(const Inbound &in);
+  void renderStatus(String &msg, const SensorData &sd);
+  void refreshStatus(const char *chatId, int32_t messageId);
+  StatusView *findView(uint32_t chatHash, int32_t messageId);
+  void sendAnswers();
+  bool parseArg(ArgKind kind, float min, float max, const char *s, CommandArg &out);
+  void applySetting(const char *chatId, const SettingsFields::Field &f, double value,
+                    const char *okText = nullptr);
+
+  void cmdStart(const char *chatId, const CommandArg &arg);
+  void cmdHelp(const char *chatId, const CommandArg &arg);
+  void cmdStatus(const char *chatId, const CommandArg &arg);
+  void cmdPerf(const char *chatId, const CommandArg &arg);
+  void cmdTrends(const char *chatId, const CommandArg &arg);
+  void cmdAuto(const char *chatId, const CommandArg &arg);
+  void cmdWater(const char *chatId, const CommandArg &arg);
+  void cmdNotify(const char *chatId, const CommandArg &arg);
+  void cmdProfiles(const char *chatId, const CommandArg &arg);
+  void cmdProfile(const char *chatId, const CommandArg &arg);
+  void cmdScenes(const char *chatId, const CommandArg &arg);
+  void cmdScene(const char *chatId, const CommandArg &arg);
+  void cmdSoilTarget(const char *chatId, const CommandArg &arg);
+  void cmdSettings(const char *chatId, const CommandArg &arg);
+
+  void reply(const char *chatId, const String &text,
+             TelegramOutbox::Keyboard keyboard = TelegramOutbox::KEYBOARD_NONE);
+  void enqueued(bool ok);
   void checkAndSendAlerts();
+  bool connectTls(TlsClient &c);
+  static bool testServer() { return TelegramConfig::TEST_API_HOST[0] != '\0'; }
 
   String mainKeyboardJson();
+  String statusKeyboardJson();
+  String profileKeyboardJson();
 };
 
 extern TelegramBotHandler g_telegram;
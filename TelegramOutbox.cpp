@@ -0,0 +1,202 @@
+// TelegramOutbox.cpp
+#include "TelegramOutbox.h"
+#include "Fnv1a.h"
+
+// Ключ чата и аварии; 0 зарезервирован под «не авария»
+static uint32_t hashText(const char *s) {
+  uint32_t h = fnv1a(s);
+  return h ? h : 1;
+}
+
+// Сравнение порядковых номеров с учётом переполнения
+static bool seqBefore(uint32_t a, uint32_t b) {
+  return (int32_t)(a - b) < 0;
+}
+
+// ===== Постановка (любая задача) =====
+bool TelegramOutbox::push(const char *chatId, const char *text, Keyboard keyboard, int32_t editId) {
+  int8_t slot = claim(hashText(chatId), 0, millis());
+  if (slot < 0) return false;
+  fill(slot, chatId, text, keyboard, editId);
+  return true;
+}
+
+bool TelegramOutbox::pushAlert(const char *chatId, const char *text, unsigned long windowMs) {
+  uint32_t      chatHash  = hashText(chatId);
+  uint32_t      key       = hashText(text);
+  unsigned long now       = millis();
+  unsigned long notBefore = now;
+
+  portENTER_CRITICAL(&mux);
+  for (uint8_t i = 0; i < DEPTH; ++i) {
+    Slot &s = slots[i];
+    if ((s.state == FILLING || s.state == READY) && s.alertKey == key && s.chatHash == chatHash) {
+      if (s.msg.repeats < UINT16_MAX) s.msg.repeats++;
+      st.coalesced++;
+      portEXIT_CRITICAL(&mux);
+      return true;
+    }
+  }
+  // Такая же авария недавно ушла — копим повторы до конца окна
+  for (uint8_t i = 0; i < RECENT; ++i) {
+    if (recent[i].key == key && now - recent[i].sentMs < windowMs) {
+      notBefore = recent[i].sentMs + windowMs;
+    }
+  }
+  portEXIT_CRITICAL(&mux);
+
+  int8_t slot = claim(chatHash, key, notBefore);
+  if (slot < 0) return false;
+  fill(slot, chatId, text, KEYBOARD_NONE, 0);
+  return true;
+}
+
+// Снять слот со стека свободных; поля, которые видит pushAlert, —
+// под спинлоком, текст заполняет fill() уже без него
+int8_t TelegramOutbox::claim(uint32_t chatHash, uint32_t alertKey, unsigned long notBefore) {
+  int8_t slot = -1;
+
+  portENTER_CRITICAL(&mux);
+  if (freeTop > 0) {
+    slot = freeStack[--freeTop];
+    Slot &s = slots[slot];
+    s.state       = FILLING;
+    s.seq         = nextSeq++;
+    s.chatHash    = chatHash;
+    s.alertKey    = alertKey;
+    s.notBefore   = notBefore;
+    s.attempts    = 0;
+    s.msg.repeats = 0;
+    st.queued++;
+  } else {
+    st.dropped++;
+  }
+  portEXIT_CRITICAL(&mux);
+
+  return slot;
+}
+
+void TelegramOutbox::fill(int8_t slot, const char *chatId, const char *text, Keyboard keyboard,
+                          int32_t editId) {
+  Slot &s = slots[slot];
+  strlcpy(s.msg.chatId, chatId, sizeof(s.msg.chatId));
+  if (strlcpy(s.msg.text, text, sizeof(s.msg.text)) >= sizeof(s.msg.text)) {
+    Serial.println(F("⚠️ Telegram: сообщение длиннее TEXT_MAX обрезано"));
+  }
+  s.msg.keyboard = keyboard;
+  s.msg.editId   = editId;
+
+  portENTER_CRITICAL(&mux);
+  s.state = READY;
+  portEXIT_CRITICAL(&mux);
+}
+
+// Вызывается под спинлоком
+void TelegramOutbox::release(int8_t slot) {
+  slots[slot].state    = FREE;
+  freeStack[freeTop++] = slot;
+}
+
+// ===== Отправка (задача telegram) =====
+// Ведро чата с пополнением на текущий момент. Нет ведра — заводим полное
+// на месте самого давно пополнявшегося. Вызывается под спинлоком.
+TelegramOutbox::Bucket *TelegramOutbox::bucketFor(uint32_t chatHash, unsigned long now) {
+  Bucket *b = nullptr;
+  for (uint8_t i = 0; i < BUCKETS && !b; ++i) {
+    if (buckets[i].chatHash == chatHash) b = &buckets[i];
+  }
+  if (!b) {
+    b = &buckets[0];
+    for (uint8_t i = 1; i < BUCKETS; ++i) {
+      if (b->chatHash == 0) break;
+      if (buckets[i].chatHash == 0 || now - buckets[i].refillMs > now - b->refillMs) b = &buckets[i];
+    }
+    b->chatHash = chatHash;
+    b->tokens   = BUCKET_BURST;
+    b->refillMs = now;
+    return b;
+  }
+
+  unsigned long add = (now - b->refillMs) / BUCKET_REFILL_MS;
+  if (add > 0) {
+    b->tokens    = (uint8_t)min<unsigned long>(BUCKET_BURST, b->tokens + add);
+    b->refillMs += add * BUCKET_REFILL_MS;
+  }
+  if (b->tokens == BUCKET_BURST) b->refillMs = now;
+  return b;
+}
+
+// Ответ не обгоняет более ранний ответ тому же чату, который ждёт повтора.
+// Аварии идут вне очерёдности. Вызывается под спинлоком.
+bool TelegramOutbox::blockedByEarlier(const Slot &s) const {
+  if (s.alertKey != 0) return false;
+  for (uint8_t i = 0; i < DEPTH; ++i) {
+    const Slot &o = slots[i];
+    if (o.state == READY && o.alertKey == 0 && o.chatHash == s.chatHash && seqBefore(o.seq, s.seq)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+int8_t TelegramOutbox::take(unsigned long now, unsigned long &waitMs) {
+  int8_t best = -1;
+  waitMs = RETRY_MAX_MS;
+
+  portENTER_CRITICAL(&mux);
+  for (uint8_t i = 0; i < DEPTH; ++i) {
+    Slot &s = slots[i];
+    if (s.state != READY) continue;
+
+    long early = (long)(s.notBefore - now);
+    if (early > 0) {
+      waitMs = min(waitMs, (unsigned long)early);
+      continue;
+    }
+    if (blockedByEarlier(s)) continue;
+
+    Bucket *b = bucketFor(s.chatHash, now);
+    if (b->tokens == 0) {
+      waitMs = min(waitMs, BUCKET_REFILL_MS - (now - b->refillMs));
+      continue;
+    }
+    if (best < 0 || seqBefore(s.seq, slots[best].seq)) best = i;
+  }
+
+  if (best >= 0) {
+    Slot &s = slots[best];
+    s.state = SENDING;
+    bucketFor(s.chatHash, now)->tokens--;
+
+    // Окно склейки аварии отсчитывается от отправки
+    if (s.alertKey != 0) {
+      RecentAlert *r = &recent[0];
+      for (uint8_t i = 0; i < RECENT; ++i) {
+        if (recent[i].key == s.alertKey) { r = &recent[i]; break; }
+        if (now - recent[i].sentMs > now - r->sentMs) r = &recent[i];
+      }
+      r->key    = s.alertKey;
+      r->sentMs = now;
+    }
+  }
+  portEXIT_CRITICAL(&mux);
+
+  return best;
+}
+
+void TelegramOutbox::complete(int8_t slot, bool ok, unsigned long now) {
+  portENTER_CRITICAL(&mux);
+  Slot &s = slots[slot];
+  if (ok) {
+    st.sent++;
+    release(slot);
+  } else if (++s.attempts >= MAX_ATTEMPTS) {
+    st.failed++;
+    release(slot);
+  } else {
+    st.retries++;
+    s.notBefore = now + min(RETRY_MIN_MS << (s.attempts - 1), RETRY_MAX_MS);
+    s.state     = READY;
+  }
+  portEXIT_CRITICAL(&mux);
+}
@@ -0,0 +1,115 @@
+// TelegramOutbox.h
+#ifndef TELEGRAM_OUTBOX_H
+#define TELEGRAM_OUTBOX_H
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+
+// Очередь исходящих сообщений Telegram.
+// Поставить сообщение можно из любой задачи за O(1) и без ожидания: слот
+// снимается со стека свободных под спинлоком, текст копируется уже вне его.
+// Отправляет только задача telegram (TelegramBotHandler::flushOutbox):
+//  - не чаще лимита Telegram — ведро токенов на каждый чат;
+//  - при ошибке — повтор с удвоением паузы, порядок ответов в чате сохраняется;
+//  - одинаковые аварии в окне склеиваются в одно сообщение со счётчиком.
+class TelegramOutbox {
+public:
+  // MAIN — reply-клавиатура (шлётся с /start и остаётся у клиента),
+  // STATUS и PROFILES — inline-кнопки под сообщением
+  enum Keyboard : uint8_t { KEYBOARD_NONE, KEYBOARD_MAIN, KEYBOARD_STATUS, KEYBOARD_PROFILES };
+
+  static constexpr uint8_t DEPTH    = 8;
+  static constexpr size_t  TEXT_MAX = 1280;   // самое длинное — /help, ~1,1 КБ
+  static constexpr size_t  CHAT_MAX = 24;
+
+  static constexpr uint8_t       BUCKET_BURST     = 3;       // сообщений подряд в один чат
+  static constexpr unsigned long BUCKET_REFILL_MS = 1000;    // +1 токен: Telegram ~1 сообщение/с на чат
+  static constexpr unsigned long RETRY_MIN_MS     = 2000;
+  static constexpr unsigned long RETRY_MAX_MS     = 60000;
+  static constexpr uint8_t       MAX_ATTEMPTS     = 5;
+
+  struct Message {
+    char     chatId[CHAT_MAX];
+    char     text[TEXT_MAX];
+    Keyboard keyboard;
+    int32_t  editId;       // ≠0 — editMessageText этого сообщения вместо нового
+    uint16_t repeats;      // авария повторилась ещё столько раз
+  };
+
+  struct Stats {
+    uint32_t queued    = 0;
+    uint32_t coalesced = 0;   // повтор аварии влит в уже стоящее сообщение
+    uint32_t dropped   = 0;   // очередь была полна
+    uint32_t sent      = 0;
+    uint32_t retries   = 0;
+    uint32_t failed    = 0;   // исчерпаны MAX_ATTEMPTS
+  };
+
+  // false — очередь полна, сообщение отброшено
+  bool push(const char *chatId, const char *text, Keyboard keyboard = KEYBOARD_NONE,
+            int32_t editId = 0);
+
+  // Авария: тот же текст, пока прежний ждёт отправки или в течение windowMs
+  // после неё, не порождает нового сообщения — растёт счётчик повторов;
+  // накопленное уходит одним сообщением по истечении окна
+  bool pushAlert(const char *chatId, const char *text, unsigned long windowMs);
+
+  // Для задачи-отправителя. take() возвращает слот, который можно отправить
+  // сейчас, или -1; waitMs — через сколько созреет ближайший.
+  // После отправки — обязательно complete().
+  int8_t         take(unsigned long now, unsigned long &waitMs);
+  const Message &message(int8_t slot) const { return slots[slot].msg; }
+  void           complete(int8_t slot, bool ok, unsigned long now);
+
+  uint8_t      pending() const { return DEPTH - freeTop; }
+  const Stats &stats() const   { return st; }
+
+private:
+  enum State : uint8_t { FREE, FILLING, READY, SENDING };
+
+  struct Slot {
+    Message       msg;
+    State         state = FREE;
+    uint32_t      seq;
+    uint32_t      chatHash;
+    uint32_t      alertKey;    // 0 — обычное сообщение
+    unsigned long notBefore;
+    uint8_t       attempts;
+  };
+
+  // Ведро токенов на чат; чатов у теплицы немного, лишние вытесняются
+  struct Bucket {
+    uint32_t      chatHash = 0;
+    uint8_t       tokens   = 0;
+    unsigned long refillMs = 0;
+  };
+
+  // Когда последний раз уходила авария с данным ключом
+  struct RecentAlert {
+    uint32_t      key    = 0;
+    unsigned long sentMs = 0;
+  };
+
+  static constexpr uint8_t BUCKETS = 4;
+  static constexpr uint8_t RECENT  = 4;
+
+  Slot        slots[DEPTH];
+  uint8_t     freeStack[DEPTH] = {0, 1, 2, 3, 4, 5, 6, 7};
+  uint8_t     freeTop          = DEPTH;
+  uint32_t    nextSeq          = 0;
+  Bucket      buckets[BUCKETS];
+  RecentAlert recent[RECENT];
+  Stats       st;
+
+  portMUX_TYPE mux = portMUX_INITIALIZER_UNLOCKED;
+
+  static_assert(DEPTH == 8, "freeStack initializer lists DEPTH indices");
+
+  int8_t  claim(uint32_t chatHash, uint32_t alertKey, unsigned long notBefore);
+  void    fill(int8_t slot, const char *chatId, const char *text, Keyboard keyboard, int32_t editId);
+  void    release(int8_t slot);
+  Bucket *bucketFor(uint32_t chatHash, unsigned long now);
+  bool    blockedByEarlier(const Slot &s) const;
+};
+
+#endif // TELEGRAM_OUTBOX_H
@@ -0,0 +1,329 @@
+// TlsClient.cpp
+#include "TlsClient.h"
+#include <esp_timer.h>
+#include <mbedtls/sha256.h>
+#include <mbedtls/version.h>
+#include <lwip/sockets.h>
+
+static bool handshakeOver(const mbedtls_ssl_context &ssl) {
+#if MBEDTLS_VERSION_NUMBER >= 0x03020000
+  return mbedtls_ssl_is_handshake_over(&ssl);
+#else
+  return ssl.state == MBEDTLS_SSL_HANDSHAKE_OVER;
+#endif
+}
+
+static bool tlsWouldBlock(int ret) {
+  return ret == MBEDTLS_ERR_SSL_WANT_READ || ret == MBEDTLS_ERR_SSL_WANT_WRITE;
+}
+
+static int hexValue(char c) {
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  return -1;
+}
+
+TlsClient::TlsClient() {
+  mbedtls_net_init(&net);
+  mbedtls_ssl_init(&ssl);
+  mbedtls_ssl_config_init(&conf);
+  mbedtls_ctr_drbg_init(&drbg);
+  mbedtls_entropy_init(&entropy);
+  mbedtls_x509_crt_init(&ca);
+  mbedtls_ssl_session_init(&session);
+}
+
+TlsClient::~TlsClient() {
+  stop();
+  mbedtls_ssl_session_free(&session);
+  mbedtls_x509_crt_free(&ca);
+  mbedtls_ssl_config_free(&conf);
+  mbedtls_ctr_drbg_free(&drbg);
+  mbedtls_entropy_free(&entropy);
+}
+
+bool TlsClient::setFingerprint(const char *sha256Hex) {
+  memset(pin, 0, sizeof(pin));
+  pinned = sha256Hex && sha256Hex[0];
+  if (!pinned) return true;
+
+  size_t n  = 0;
+  int    hi = -1;
+  for (const char *p = sha256Hex; *p; ++p) {
+    if (*p == ' ' || *p == ':') continue;
+    int v = hexValue(*p);
+    if (v < 0 || n >= sizeof(pin)) return false;
+    if (hi < 0) {
+      hi = v;
+    } else {
+      pin[n++] = (uint8_t)(hi << 4 | v);
+      hi = -1;
+    }
+  }
+  return n == sizeof(pin) && hi < 0;
+}
+
+// Общая для всех соединений часть: ГПСЧ, корень CA, параметры клиента
+bool TlsClient::setup() {
+  if (ready) return true;
+
+  static const char PERS[] = "greenhouse_tls";
+  int ret = mbedtls_ctr_drbg_seed(&drbg, mbedtls_entropy_func, &entropy,
+                                  (const unsigned char *)PERS, sizeof(PERS) - 1);
+  if (ret == 0 && caPem) {
+    ret = mbedtls_x509_crt_parse(&ca, (const unsigned char *)caPem, strlen(caPem) + 1);
+  }
+  if (ret == 0) {
+    ret = mbedtls_ssl_config_defaults(&conf, MBEDTLS_SSL_IS_CLIENT, MBEDTLS_SSL_TRANSPORT_STREAM,
+                                      MBEDTLS_SSL_PRESET_DEFAULT);
+  }
+  if (ret != 0) {
+    tlsError = ret;
+    mbedtls_x509_crt_free(&ca);
+    mbedtls_x509_crt_init(&ca);
+    return false;
+  }
+
+  mbedtls_ssl_conf_authmode(&conf, MBEDTLS_SSL_VERIFY_REQUIRED);
+  mbedtls_ssl_conf_ca_chain(&conf, &ca, nullptr);
+  mbedtls_ssl_conf_verify(&conf, verifyCert, this);
+  mbedtls_ssl_conf_rng(&conf, mbedtls_ctr_drbg_random, &drbg);
+#if defined(MBEDTLS_SSL_SESSION_TICKETS)
+  mbedtls_ssl_conf_session_tickets(&conf, MBEDTLS_SSL_SESSION_TICKETS_ENABLED);
+#endif
+  ready = true;
+  return true;
+}
+
+// Вызывается на каждый сертификат цепочки, только в полном рукопожатии —
+// по этому и видно, что сессия не возобновилась. Лист (depth 0) сверяется
+// с закреплённым отпечатком
+int TlsClient::verifyCert(void *ctx, mbedtls_x509_crt *crt, int depth, uint32_t *flags) {
+  TlsClient *self = (TlsClient *)ctx;
+  self->sawCert = true;
+  if (depth != 0 || !self->pinned) return 0;
+
+  uint8_t digest[32];
+#if MBEDTLS_VERSION_NUMBER >= 0x03000000
+  mbedtls_sha256(crt->raw.p, crt->raw.len, digest, 0);
+#else
+  mbedtls_sha256_ret(crt->raw.p, crt->raw.len, digest, 0);
+#endif
+  if (memcmp(digest, self->pin, sizeof(digest)) != 0) {
+    self->pinMismatch = true;
+    *flags |= MBEDTLS_X509_BADCERT_OTHER;
+  }
+  return 0;
+}
+
+int TlsClient::connect(IPAddress ip, uint16_t port) {
+  // Имя для SNI и проверки сертификата — сам адрес
+  return connect(ip.toString().c_str(), port);
+}
+
+int TlsClient::connect(const char *host, uint16_t port) {
+  return connect(host, port, host);
+}
+
+int TlsClient::connect(const char *host, uint16_t port, const char *serverName) {
+  stop();
+  error       = OK;
+  tlsError    = 0;
+  hs          = Handshake();
+  sawCert     = false;
+  pinMismatch = false;
+
+  if (!setup()) {
+    error = ERR_SETUP;
+    return 0;
+  }
+
+  unsigned long start = millis();
+  char          portStr[6];
+  snprintf(portStr, sizeof(portStr), "%u", (unsigned)port);
+
+  int ret = mbedtls_net_connect(&net, host, portStr, MBEDTLS_NET_PROTO_TCP);
+  if (ret != 0) {
+    tlsError = ret;
+    error    = ERR_CONNECT;
+    stop();
+    return 0;
+  }
+  ret = mbedtls_ssl_setup(&ssl, &conf);
+  if (ret == 0) ret = mbedtls_ssl_set_hostname(&ssl, serverName);
+  if (ret != 0) {
+    tlsError = ret;
+    error    = ERR_SETUP;
+    stop();
+    return 0;
+  }
+  // Неблокирующий сокет: шаг рукопожатия без данных сразу возвращает
+  // WANT_READ, и время внутри шагов — это работа процессора
+  mbedtls_net_set_nonblock(&net);
+  mbedtls_ssl_set_bio(&ssl, &net, mbedtls_net_send, mbedtls_net_recv, nullptr);
+  if (haveSession) mbedtls_ssl_set_session(&ssl, &session);
+
+  if (!handshake(start)) {
+    // Сохранённая сессия могла стать причиной — следующая попытка без неё
+    forgetSession();
+    stop();
+    return 0;
+  }
+
+  open       = true;
+  hs.resumed = !sawCert;
+  hs.wallMs  = millis() - start;
+  saveSession();
+  return 1;
+}
+
+bool TlsClient::handshake(unsigned long start) {
+  uint32_t heapStart = ESP.getFreeHeap();
+  uint32_t heapMin   = heapStart;
+  int64_t  cpuUs     = 0;
+
+  while (!handshakeOver(ssl)) {
+    int64_t t0  = esp_timer_get_time();
+    int     ret = mbedtls_ssl_handshake_step(&ssl);
+    cpuUs += esp_timer_get_time() - t0;
+
+    uint32_t heapNow = ESP.getFreeHeap();
+    if (heapNow < heapMin) heapMin = heapNow;
+
+    if (ret == 0) continue;
+    if (!tlsWouldBlock(ret)) {
+      tlsError = ret;
+      if (ret == MBEDTLS_ERR_X509_CERT_VERIFY_FAILED) error = pinMismatch ? ERR_PIN : ERR_VERIFY;
+      else                                            error = ERR_HANDSHAKE;
+      return false;
+    }
+    if (millis() - start > HANDSHAKE_TIMEOUT_MS) {
+      error = ERR_HANDSHAKE;
+      return false;
+    }
+    vTaskDelay(pdMS_TO_TICKS(2));
+  }
+
+  uint32_t heapEnd = ESP.getFreeHeap();
+  hs.cpuUs    = (uint32_t)cpuUs;
+  hs.heapPeak = heapStart - heapMin;
+  hs.heapHeld = heapStart > heapEnd ? heapStart - heapEnd : 0;
+  return true;
+}
+
+// После возобновления тоже: сервер мог выдать новый тикет
+void TlsClient::saveSession() {
+  mbedtls_ssl_session_free(&session);
+  mbedtls_ssl_session_init(&session);
+  haveSession = mbedtls_ssl_get_session(&ssl, &session) == 0;
+}
+
+void TlsClient::forgetSession() {
+  mbedtls_ssl_session_free(&session);
+  mbedtls_ssl_session_init(&session);
+  haveSession = false;
+}
+
+void TlsClient::stop() {
+  if (open) mbedtls_ssl_close_notify(&ssl);
+  mbedtls_ssl_free(&ssl);
+  mbedtls_ssl_init(&ssl);
+  mbedtls_net_free(&net);
+  open   = false;
+  peeked = -1;
+}
+
+uint8_t TlsClient::connected() {
+  if (open) pending();   // заметить закрытие соединения сервером
+  return open;
+}
+
+size_t TlsClient::write(uint8_t b) {
+  return write(&b, 1);
+}
+
+size_t TlsClient::write(const uint8_t *buf, size_t size) {
+  if (!open) return 0;
+
+  size_t        sent  = 0;
+  unsigned long start = millis();
+  while (sent < size) {
+    int ret = mbedtls_ssl_write(&ssl, buf + sent, size - sent);
+    if (ret > 0) {
+      sent += (size_t)ret;
+      start = millis();
+      continue;
+    }
+    if (!tlsWouldBlock(ret) || millis() - start > WRITE_TIMEOUT_MS) {
+      tlsError = ret;
+      stop();
+      break;
+    }
+    vTaskDelay(pdMS_TO_TICKS(1));
+  }
+  return sent;
+}
+
+// Байт готово к чтению; не ждёт
+int TlsClient::pending() {
+  if (!open) return 0;
+
+  // Чтение нуля байт подтягивает запись из сокета, не блокируясь
+  int ret = mbedtls_ssl_read(&ssl, nullptr, 0);
+  int n   = (int)mbedtls_ssl_get_bytes_avail(&ssl) + (peeked >= 0 ? 1 : 0);
+  if (ret < 0 && !tlsWouldBlock(ret) && n == 0) {
+    if (ret != MBEDTLS_ERR_SSL_PEER_CLOSE_NOTIFY) tlsError = ret;
+    stop();
+  }
+  return n;
+}
+
+// Пусто — ждём сокет в select() до AVAILABLE_WAIT_MS: задача спит, пока
+// сервер держит long poll, и просыпается сразу с приходом данных
+int TlsClient::available() {
+  int n = pending();
+  if (n > 0 || !open) return n;
+
+  fd_set rd;
+  FD_ZERO(&rd);
+  FD_SET(net.fd, &rd);
+  timeval tv = { 0, (long)AVAILABLE_WAIT_MS * 1000L };
+  int ready = select(net.fd + 1, &rd, nullptr, nullptr, &tv);
+  if (ready > 0)      n = pending();
+  else if (ready < 0) vTaskDelay(pdMS_TO_TICKS(AVAILABLE_WAIT_MS));   // всё равно уступить ядро
+  return n;
+}
+
+int TlsClient::read() {
+  uint8_t b;
+  return read(&b, 1) == 1 ? b : -1;
+}
+
+int TlsClient::read(uint8_t *buf, size_t size) {
+  if (size == 0) return 0;
+
+  size_t n = 0;
+  if (peeked >= 0) {
+    buf[n++] = (uint8_t)peeked;
+    peeked   = -1;
+  }
+  if (n < size && open) {
+    int ret = mbedtls_ssl_read(&ssl, buf + n, size - n);
+    if (ret > 0) {
+      n += (size_t)ret;
+    } else if (!tlsWouldBlock(ret) && n == 0) {
+      if (ret != 0 && ret != MBEDTLS_ERR_SSL_PEER_CLOSE_NOTIFY) tlsError = ret;
+      stop();
+    }
+  }
+  return n > 0 ? (int)n : -1;
+}
+
+int TlsClient::peek() {
+  if (peeked < 0) {
+    uint8_t b;
+    if (read(&b, 1) == 1) peeked = b;
+  }
+  return peeked;
+}
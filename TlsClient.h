@@ -0,0 +1,107 @@
+// TlsClient.h
+#ifndef TLS_CLIENT_H
+#define TLS_CLIENT_H
+
+#include <Arduino.h>
+#include <Client.h>
+#include <mbedtls/ssl.h>
+#include <mbedtls/net_sockets.h>
+#include <mbedtls/ctr_drbg.h>
+#include <mbedtls/entropy.h>
+#include <mbedtls/x509_crt.h>
+
+// TLS-клиент на mbedtls для UniversalTelegramBot (подходит любой Client).
+// В отличие от WiFiClientSecure:
+//  - сессия возобновляется: после рукопожатия она (ID и тикет RFC 5077)
+//    сохраняется и предлагается при следующем connect(). Приняв её, сервер
+//    не присылает сертификаты и не делает обмен ключами;
+//  - корень CA разбирается один раз, а не при каждом соединении;
+//  - отпечаток листового сертификата сверяется внутри рукопожатия, до
+//    отправки данных; сессия сохраняется только после всех проверок;
+//  - каждое рукопожатие замеряется: полное или возобновлённое, время,
+//    время процессора внутри mbedtls и занятая куча.
+// Методы одного объекта — из одной задачи.
+class TlsClient : public Client {
+public:
+  enum Error : uint8_t { OK = 0, ERR_SETUP, ERR_CONNECT, ERR_HANDSHAKE, ERR_VERIFY, ERR_PIN };
+
+  struct Handshake {
+    bool     resumed  = false;
+    uint32_t wallMs   = 0;   // от connect() до готовности: DNS, TCP, сеть
+    uint32_t cpuUs    = 0;   // сумма шагов mbedtls_ssl_handshake_step — без ожидания сети
+    uint32_t heapPeak = 0;   // наибольший расход кучи между шагами рукопожатия
+    uint32_t heapHeld = 0;   // куча, оставшаяся за соединением
+  };
+
+  TlsClient();
+  ~TlsClient();
+
+  // До первого connect(): корень цепочки (PEM) и SHA-256 листового
+  // сертификата ("AB CD …", "AB:CD…" или слитно; "" — без закрепления).
+  // Неразборчивый отпечаток — false, и ни одно соединение его не пройдёт
+  void setCACert(const char *rootPem) { caPem = rootPem; }
+  bool setFingerprint(const char *sha256Hex);
+
+  int     connect(IPAddress ip, uint16_t port) override;
+  int     connect(const char *host, uint16_t port) override;
+  // Соединиться с host, но для SNI и проверки сертификата назваться
+  // serverName — стенд с поддельным api.telegram.org по адресу ПК
+  int     connect(const char *host, uint16_t port, const char *serverName);
+  size_t  write(uint8_t b) override;
+  size_t  write(const uint8_t *buf, size_t size) override;
+  int     available() override;
+  int     read() override;
+  int     read(uint8_t *buf, size_t size) override;
+  int     peek() override;
+  void    flush() override {}
+  void    stop() override;
+  uint8_t connected() override;
+  operator bool() override { return connected(); }
+
+  // Итог последнего connect()
+  Error            lastError() const     { return error; }
+  int              lastTlsError() const  { return tlsError; }   // код mbedtls
+  const Handshake &lastHandshake() const { return hs; }
+
+  // Следующее соединение — с полным рукопожатием
+  void forgetSession();
+
+  TlsClient(const TlsClient &) = delete;
+  TlsClient &operator=(const TlsClient &) = delete;
+
+private:
+  static constexpr uint32_t HANDSHAKE_TIMEOUT_MS = 15000;
+  static constexpr uint32_t WRITE_TIMEOUT_MS     = 10000;
+  // available() без данных ждёт сокет не дольше этого: библиотека крутит
+  // available() весь long poll, и без ожидания задача занимала бы ядро
+  static constexpr uint32_t AVAILABLE_WAIT_MS    = 10;
+
+  mbedtls_net_context      net;
+  mbedtls_ssl_context      ssl;
+  mbedtls_ssl_config       conf;
+  mbedtls_ctr_drbg_context drbg;
+  mbedtls_entropy_context  entropy;
+  mbedtls_x509_crt         ca;
+  mbedtls_ssl_session      session;
+
+  const char *caPem        = nullptr;
+  uint8_t     pin[32]      = {};
+  bool        pinned       = false;
+  bool        ready        = false;   // conf, ГПСЧ и CA готовы
+  bool        open         = false;
+  bool        haveSession  = false;
+  bool        sawCert      = false;   // в рукопожатии была проверка цепочки
+  bool        pinMismatch  = false;
+  int         peeked       = -1;
+  Error       error        = OK;
+  int         tlsError     = 0;
+  Handshake   hs;
+
+  int  pending();
+  bool setup();
+  bool handshake(unsigned long start);
+  void saveSession();
+  static int verifyCert(void *ctx, mbedtls_x509_crt *crt, int depth, uint32_t *flags);
+};
+
+#endif // TLS_CLIENT_H
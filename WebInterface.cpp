@@ -1,879 +1,1570 @@
 // WebInterface.cpp
 #include "WebInterface.h"
+#include "Runtime.h"
+#include "Perf.h"
+#include "SensorStore.h"
+#include "HistoryStore.h"
+#include "Rollup.h"
+#include "IndexHtml.h"
+#include "JsonWriter.h"
+#include "MetricsWriter.h"
+#include "JsonReader.h"
+#include "SettingsFields.h"
+#include "Commands.h"
+#include "Scenes.h"
+#include "WifiManager.h"
+#include "SensorPacket.h"
+#include "TelegramBotHandler.h"
+#include <esp_wifi.h>
+#include <esp_timer.h>
+#include <functional>
+#include <memory>
 
 WebInterface g_web;
 
 void WebInterface::begin() {
-  setupWiFi();
-
-  server.on("/",             HTTP_GET,  [this]() { if (!ensureAuth()) return; handleRoot(); });
-  server.on("/api/sensors",  HTTP_GET,  [this]() { if (!ensureAuth()) return; handleSensors(); });
-  server.on("/api/settings", HTTP_GET,  [this]() { if (!ensureAuth()) return; handleSettingsGet(); });
-  server.on("/api/settings", HTTP_POST, [this]() { if (!ensureAuth()) return; handleSettingsPost(); });
-  server.on("/api/control",  HTTP_POST, [this]() { if (!ensureAuth()) return; handleControl(); });
-  server.on("/api/diagnostics", HTTP_GET, [this]() { if (!ensureAuth()) return; handleDiagnosticsApi(); });
-  server.on("/api/wifi_scan",   HTTP_GET,  [this]() { if (!ensureAuth()) return; handleWifiScan(); });
-  server.on("/api/wifi_set",    HTTP_POST, [this]() { if (!ensureAuth()) return; handleWifiSet(); });
+  route("/",                HTTP_GET,  &WebInterface::handleRoot);
+  route("/api/sensors",     HTTP_GET,  &WebInterface::handleSensors);
+  route("/api/sensors.bin", HTTP_GET,  &WebInterface::handleSensorsBin);
+  route("/api/settings",    HTTP_GET,  &WebInterface::handleSettingsGet);
+  routeBody("/api/settings",           &WebInterface::handleSettingsPost);
+  routeBody("/api/control",            &WebInterface::handleControl);
+  route("/api/scenes",      HTTP_GET,  &WebInterface::handleScenesGet);
+  routeBody("/api/scenes",             &WebInterface::handleScenesPost);
+  route("/api/diagnostics", HTTP_GET,  &WebInterface::handleDiagnosticsApi);
+  route("/api/wifi_scan",   HTTP_GET,  &WebInterface::handleWifiScan);
+  routeBody("/api/wifi_set",           &WebInterface::handleWifiSet);
+  route("/api/history",     HTTP_GET,  &WebInterface::handleHistory);
+  route("/api/rollup",      HTTP_GET,  &WebInterface::handleRollup);
+  route("/api/perf",        HTTP_GET,  &WebInterface::handlePerf);
+  route("/metrics",         HTTP_GET,  &WebInterface::handleMetrics);
+
+  // Поток событий: новому клиенту — полное состояние (из loop(), см. streamLoop)
+  events.setAuthentication(WEB_USER, WEB_PASS);
+  events.onConnect([this](AsyncEventSourceClient *client) {
+    (void)client;
+    stream.resync = true;
+  });
+  server.addHandler(&events);
 
-  server.onNotFound([this]() { handleNotFound(); });
+  server.onNotFound([this](AsyncWebServerRequest *req) { handleNotFound(req); });
 
   server.begin();
-  Serial.println(F("🌐 Web сервер запущен на порту 80"));
+  Serial.println(F("🌐 Web сервер (async) запущен на порту 80"));
+}
+
+uint8_t WebInterface::addRouteStat(const char *uri, const char *method) {
+  if (routeCount >= MAX_ROUTES) return MAX_ROUTES;
+  routeStats[routeCount] = { uri, method, 0 };
+  return routeCount++;
+}
+
+void WebInterface::route(const char *uri, WebRequestMethodComposite method, Handler h) {
+  uint8_t stat = addRouteStat(uri, method == HTTP_GET ? "GET" : "POST");
+  server.on(uri, method, [this, h, stat](AsyncWebServerRequest *req) {
+    if (stat < MAX_ROUTES) routeStats[stat].requests++;
+    if (!ensureAuth(req)) return;
+    PerfScope perf(Perf::WEB_HTTP);
+    (this->*h)(req);
+  });
+}
+
+// Тело приходит кусками в задаче async_tcp; копим его в _tempObject
+// (буфер malloc — библиотека освобождает его вместе с запросом).
+// Тело длиннее MAX_BODY не копится — ответ 413, без тела — 400.
+void WebInterface::routeBody(const char *uri, BodyHandler h) {
+  uint8_t stat = addRouteStat(uri, "POST");
+  server.on(uri, HTTP_POST,
+    [this, h, stat](AsyncWebServerRequest *req) {
+      if (stat < MAX_ROUTES) routeStats[stat].requests++;
+      if (!ensureAuth(req)) return;
+      if (req->contentLength() > MAX_BODY) {
+        req->send(413, "text/plain", "Body too large");
+        return;
+      }
+      if (!req->_tempObject) {
+        req->send(400, "text/plain", "Expected JSON body");
+        return;
+      }
+      PerfScope perf(Perf::WEB_HTTP);
+      const char *body = static_cast<const char*>(req->_tempObject);
+      (this->*h)(req, body, strlen(body));
+    },
+    nullptr,
+    [](AsyncWebServerRequest *req, uint8_t *data, size_t len, size_t index, size_t total) {
+      if (total == 0 || total > MAX_BODY) return;
+      if (index == 0 && !req->_tempObject) {
+        req->_tempObject = calloc(total + 1, 1);
+      }
+      char *buf = static_cast<char*>(req->_tempObject);
+      if (buf && index + len <= total) memcpy(buf + index, data, len);
+    });
 }
 
 void WebInterface::loop() {
-  server.handleClient();
+  streamLoop();
+  scanLoop();
 }
 
-void WebInterface::setupWiFi() {
-  // Пытаемся подключиться как STA по сохранённым настройкам
-  WiFi.mode(WIFI_STA);
-  WiFi.begin(g_settings.wifiSSID, g_settings.wifiPassword);
+// ===== Поток /api/stream (Server-Sent Events) =====
+// event: state — полный объект (при подключении клиента),
+// event: delta — только изменившиеся поля, как только сменилась версия снимка,
+// event: ping  — раз в STREAM_HEARTBEAT_MS, чтобы прокси и браузер не рвали соединение.
+void WebInterface::streamLoop() {
+  unsigned long now = millis();
+
+  SensorData sd;
+  uint32_t   version    = g_sensorStore.read(sd);
+  bool       automation = g_settings.automationEnabled;
+
+  bool resync = stream.resync;
+  bool fresh  = !stream.primed || version != stream.version || automation != stream.automation;
 
-  Serial.printf("📶 Подключаемся к Wi-Fi \"%s\"...\n", g_settings.wifiSSID);
+  char       buf[384];
+  JsonWriter w(buf, sizeof(buf));
 
-  unsigned long start = millis();
-  while (WiFi.status() != WL_CONNECTED && millis() - start < 15000) {
-    delay(500);
-    Serial.print(".");
+  if (!resync && !fresh) {
+    if (events.count() > 0 && now - stream.lastBeatMs >= Constants::STREAM_HEARTBEAT_MS) {
+      stream.lastBeatMs = now;
+      w.beginObject().field("uptimeMs", now).endObject();
+      events.send(w.c_str(), "ping", version);
+    }
+    return;
   }
-  Serial.println();
 
-  if (WiFi.status() == WL_CONNECTED) {
-    Serial.print(F("✅ Wi-Fi STA IP: "));
-    Serial.println(WiFi.localIP());
-  } else {
-    // Переходим в режим точки доступа для первичной настройки
-    Serial.println(F("⚠️ Не удалось подключиться, поднимаем точку доступа..."));
-    WiFi.mode(WIFI_AP);
-    WiFi.softAP("YotikM2-Setup", "YotikM2pass");
-    Serial.print(F("📡 AP IP: "));
-    Serial.println(WiFi.softAPIP());
+  if (events.count() > 0) {
+    PerfScope perf(Perf::WEB_SSE);
+    if (resync || !stream.primed) {
+      stream.resync = false;
+      writeSensors(w, sd, version, automation, nullptr);
+      events.send(w.c_str(), "state", version);
+      stream.lastBeatMs = now;
+    } else if (writeSensors(w, sd, version, automation, &stream)) {
+      events.send(w.c_str(), "delta", version);
+      stream.lastBeatMs = now;
+    }
   }
+
+  stream.data       = sd;
+  stream.version    = version;
+  stream.automation = automation;
+  stream.primed     = true;
 }
 
-bool WebInterface::ensureAuth() {
-  if (!server.authenticate(WEB_USER, WEB_PASS)) {
-    server.requestAuthentication();
+bool WebInterface::ensureAuth(AsyncWebServerRequest *req) {
+  if (!req->authenticate(WEB_USER, WEB_PASS)) {
+    req->requestAuthentication();
     return false;
   }
   return true;
 }
 
 // ===== HTML (современный интерфейс) =====
+// Исходник — web/index.html; во флеше лежит gzip-копия (tools/embed_index.py).
+// Браузер кэширует страницу, но при каждой загрузке переспрашивает по ETag
+// (no-cache) — ответ 304 без тела. Адрес «/» без версии: с max-age после
+// обновления прошивки старый JS работал бы с новым API до истечения срока.
+
+void WebInterface::handleRoot(AsyncWebServerRequest *req) {
+  const AsyncWebHeader *inm = req->getHeader("If-None-Match");
+  bool notModified = inm && inm->value() == INDEX_HTML_ETAG;
+
+  AsyncWebServerResponse *res;
+  if (notModified) {
+    res = req->beginResponse(304);
+  } else {
+    res = req->beginResponse_P(200, "text/html", INDEX_HTML_GZ, INDEX_HTML_GZ_LEN);
+    res->addHeader("Content-Encoding", "gzip");
+  }
+  res->addHeader("ETag", INDEX_HTML_ETAG);
+  res->addHeader("Cache-Control", "private, no-cache");
+  res->addHeader("Vary", "Accept-Encoding");
+  req->send(res);
+}
+
+void WebInterface::handleNotFound(AsyncWebServerRequest *req) {
+  req->send(404, "text/plain", "Not found");
+}
 
-static const char INDEX_HTML[] PROGMEM = R"rawliteral(
-<!DOCTYPE html>
-<html lang="ru">
-<head>
-<meta charset="UTF-8">
-<title>ЙоТик M2 — Умная теплица</title>
-<meta name="viewport" content="width=device-width, initial-scale=1.0">
-<style>
-  :root {
-    font-family: system-ui, -apple-system, BlinkMacSystemFont, "Segoe UI", sans-serif;
-    color-scheme: dark;
-  }
-  body {
-    margin: 0;
-    padding: 0;
-    min-height: 100vh;
-    background: radial-gradient(circle at top, #2c3e50, #0b1020);
-    color: #f5f5f5;
-    display: flex;
-    justify-content: center;
-    align-items: flex-start;
-  }
-  .container {
-    width: 100%;
-    max-width: 1080px;
-    padding: 24px 16px 40px;
-  }
-  .header {
-    display: flex;
-    justify-content: space-between;
-    align-items: center;
-    margin-bottom: 16px;
-    gap: 12px;
-  }
-  .title {
-    font-size: 1.6rem;
-    font-weight: 700;
-    display: flex;
-    align-items: center;
-    gap: 8px;
-  }
-  .title span.logo {
-    display: inline-flex;
-    width: 32px;
-    height: 32px;
-    border-radius: 12px;
-    background: linear-gradient(135deg, #27ae60, #8e44ad);
-    align-items: center;
-    justify-content: center;
-    font-size: 1.1rem;
-  }
-  .badge {
-    padding: 4px 10px;
-    border-radius: 999px;
-    background: rgba(255,255,255,0.05);
-    font-size: 0.75rem;
-    border: 1px solid rgba(255,255,255,0.08);
-  }
-  .grid {
-    display: grid;
-    grid-template-columns: repeat(auto-fit, minmax(260px, 1fr));
-    gap: 16px;
-  }
-  .card {
-    background: rgba(17,24,39,0.9);
-    border-radius: 18px;
-    padding: 16px 18px;
-    box-shadow: 0 18px 45px rgba(0,0,0,0.45);
-    border: 1px solid rgba(255,255,255,0.04);
-    backdrop-filter: blur(18px);
-  }
-  .card h3 {
-    margin: 0 0 10px;
-    font-size: 1.05rem;
-    font-weight: 600;
-  }
-  .metrics {
-    display: grid;
-    grid-template-columns: repeat(2, minmax(0,1fr));
-    gap: 10px;
-  }
-  .metric {
-    padding: 8px 10px;
-    border-radius: 12px;
-    background: rgba(255,255,255,0.02);
-    border: 1px solid rgba(255,255,255,0.06);
-    font-size: 0.88rem;
-  }
-  .metric .label {
-    opacity: 0.75;
-    font-size: 0.78rem;
-  }
-  .metric .value {
-    font-size: 1rem;
-    font-weight: 600;
-  }
-  .metric .value small {
-    opacity: 0.7;
-    font-weight: 400;
-    margin-left: 4px;
-  }
-  .metric.ok    { border-color: rgba(52, 211, 153,0.7); }
-  .metric.warn  { border-color: rgba(250, 204, 21,0.7); }
-  .metric.alarm { border-color: rgba(248, 113, 113,0.8); }
-
-  .control-group {
-    display: flex;
-    flex-wrap: wrap;
-    gap: 8px;
-    margin-bottom: 10px;
-    align-items: center;
-  }
-  .control-group span {
-    font-size: 0.85rem;
-    opacity: 0.75;
-    min-width: 80px;
-  }
-  button {
-    border-radius: 999px;
-    border: none;
-    padding: 7px 14px;
-    font-size: 0.85rem;
-    font-weight: 500;
-    cursor: pointer;
-    background: rgba(255,255,255,0.06);
-    color: #f5f5f5;
-    transition: transform 0.08s ease, box-shadow 0.12s ease, background 0.12s ease;
-  }
-  button.primary {
-    background: linear-gradient(135deg,#22c55e,#16a34a);
-  }
-  button.danger {
-    background: linear-gradient(135deg,#ef4444,#b91c1c);
-  }
-  button.outline {
-    background: transparent;
-    border: 1px solid rgba(255,255,255,0.12);
-  }
-  button:hover {
-    transform: translateY(-1px);
-    box-shadow: 0 10px 25px rgba(0,0,0,0.25);
-  }
-  button:active {
-    transform: translateY(0);
-    box-shadow: none;
-  }
-
-  form.settings-form {
-    display: grid;
-    grid-template-columns: repeat(2,minmax(0,1fr));
-    gap: 10px;
-    margin-bottom: 10px;
-  }
-  .field {
-    display: flex;
-    flex-direction: column;
-    gap: 2px;
-  }
-  .field label {
-    font-size: 0.76rem;
-    opacity: 0.8;
-  }
-  .field input, .field select {
-    border-radius: 10px;
-    border: 1px solid rgba(255,255,255,0.08);
-    background: rgba(15,23,42,0.9);
-    color: #f5f5f5;
-    font-size: 0.86rem;
-    padding: 6px 9px;
-  }
-  .footer {
-    margin-top: 18px;
-    font-size: 0.75rem;
-    opacity: 0.6;
-    display: flex;
-    justify-content: space-between;
-    gap: 8px;
-    flex-wrap: wrap;
-  }
-  .chip {
-    padding: 3px 8px;
-    border-radius: 999px;
-    border: 1px solid rgba(148,163,184,0.7);
-    font-size: 0.7rem;
-  }
-  .status-dot {
-    width: 10px;
-    height: 10px;
-    border-radius: 999px;
-    background: #22c55e;
-    margin-right: 6px;
-  }
-  .status-row {
-    display: flex;
-    align-items: center;
-    gap: 6px;
-    font-size: 0.8rem;
-  }
-  .wifi-note {
-    font-size: 0.75rem;
-    opacity: 0.75;
-    margin-top: 4px;
-  }
-</style>
-</head>
-<body>
-<div class="container">
-  <div class="header">
-    <div class="title">
-      <span class="logo">🌱</span>
-      <span>ЙоТик M2 — Умная теплица</span>
-    </div>
-    <div class="badge">Веб-панель · v2.1</div>
-  </div>
-
-  <div class="grid">
-    <!-- Состояние -->
-    <div class="card">
-      <h3>Текущее состояние</h3>
-      <div class="metrics" id="metrics">
-        <div class="metric" id="m-airT">
-          <div class="label">Температура воздуха</div>
-          <div class="value">--<small>°C</small></div>
-        </div>
-        <div class="metric" id="m-airH">
-          <div class="label">Влажность воздуха</div>
-          <div class="value">--<small>%</small></div>
-        </div>
-        <div class="metric" id="m-soilW">
-          <div class="label">Влажность почвы</div>
-          <div class="value">--<small>%</small></div>
-        </div>
-        <div class="metric" id="m-lux">
-          <div class="label">Освещённость</div>
-          <div class="value">--<small>lux</small></div>
-        </div>
-      </div>
-    </div>
-
-    <!-- Управление -->
-    <div class="card">
-      <h3>Ручное управление</h3>
-      <div class="control-group">
-        <span>Насос</span>
-        <button class="primary" onclick="ctrl('pump','pulse')">Импульс</button>
-        <button class="outline" onclick="ctrl('pump','on')">ВКЛ</button>
-        <button class="outline" onclick="ctrl('pump','off')">ВЫКЛ</button>
-      </div>
-      <div class="control-group">
-        <span>Свет</span>
-        <button class="primary" onclick="ctrl('light','on')">ВКЛ</button>
-        <button class="outline" onclick="ctrl('light','off')">ВЫКЛ</button>
-      </div>
-      <div class="control-group">
-        <span>Вентиляция</span>
-        <button class="primary" onclick="ctrl('fan','on')">ВКЛ</button>
-        <button class="outline" onclick="ctrl('fan','off')">ВЫКЛ</button>
-      </div>
-      <div class="control-group">
-        <span>Дверь</span>
-        <button class="primary" onclick="ctrl('door','open')">ОТКРЫТЬ</button>
-        <button class="outline" onclick="ctrl('door','half')">ПРИОТКРЫТЬ</button>
-        <button class="outline" onclick="ctrl('door','close')">ЗАКРЫТЬ</button>
-      </div>
-      <div class="control-group">
-        <span>Автоматика</span>
-        <button class="primary" onclick="ctrl('auto','on')">ВКЛ</button>
-        <button class="outline" onclick="ctrl('auto','off')">ВЫКЛ</button>
-      </div>
-    </div>
-
-    <!-- Настройки -->
-    <div class="card">
-      <h3>Настройки климата и полива</h3>
-      <form class="settings-form" id="settingsForm" onsubmit="saveSettings();return false;">
-        <div class="field">
-          <label>Temp мин</label>
-          <input type="number" step="0.1" id="comfortTempMin">
-        </div>
-        <div class="field">
-          <label>Temp макс</label>
-          <input type="number" step="0.1" id="comfortTempMax">
-        </div>
-        <div class="field">
-          <label>Hum мин</label>
-          <input type="number" step="0.1" id="comfortHumMin">
-        </div>
-        <div class="field">
-          <label>Hum макс</label>
-          <input type="number" step="0.1" id="comfortHumMax">
-        </div>
-        <div class="field">
-          <label>Порог почвы %</label>
-          <input type="number" step="1" id="soilMoistureSetpoint">
-        </div>
-        <div class="field">
-          <label>Гистерезис почвы %</label>
-          <input type="number" step="1" id="soilMoistureHysteresis">
-        </div>
-        <div class="field">
-          <label>Порог света lux</label>
-          <input type="number" step="1" id="lightLuxMin">
-        </div>
-        <div class="field">
-          <label>Окно полива (от/до)</label>
-          <div style="display:flex;gap:4px;">
-            <input type="number" min="0" max="23" id="wateringStartHour" style="width:50%;">
-            <input type="number" min="0" max="23" id="wateringEndHour" style="width:50%;">
-          </div>
-        </div>
-        <div class="field">
-          <label>Ограничение света (час)</label>
-          <input type="number" min="0" max="23" id="lightCutoffHour">
-        </div>
-        <div class="field">
-          <label>Режим климата</label>
-          <select id="climateMode">
-            <option value="0">Eco</option>
-            <option value="1">Normal</option>
-            <option value="2">Aggressive</option>
-          </select>
-        </div>
-      </form>
-      <button class="primary" onclick="saveSettings()">💾 Сохранить</button>
-    </div>
-
-    <!-- Диагностика / Wi-Fi -->
-    <div class="card">
-      <h3>Диагностика и сеть</h3>
-      <pre id="diag" style="font-size:0.75rem;max-height:150px;overflow:auto;background:rgba(15,23,42,0.9);padding:8px;border-radius:10px;border:1px solid rgba(148,163,184,0.4);"></pre>
-
-      <div class="control-group">
-        <span>Wi-Fi</span>
-        <button class="outline" onclick="scanWifi()">Сканировать</button>
-      </div>
-      <div id="wifiList" style="font-size:0.78rem;opacity:0.85;margin-bottom:8px;"></div>
-
-      <div class="field">
-        <label>SSID сети</label>
-        <input type="text" id="wifiSsid" placeholder="Имя Wi-Fi сети">
-      </div>
-      <div class="field">
-        <label>Пароль</label>
-        <input type="password" id="wifiPass" placeholder="Пароль Wi-Fi">
-      </div>
-      <div class="control-group" style="margin-top:8px;">
-        <button class="primary" onclick="saveWifi()">Подключить к Wi-Fi</button>
-      </div>
-      <div class="wifi-note">
-        При работе в режиме точки доступа (YotikM2-Setup) введите здесь домашний Wi-Fi, сохраните — устройство попытается подключиться к нему.
-      </div>
-    </div>
-  </div>
-
-  <div class="footer">
-    <div class="status-row">
-      <span class="status-dot" id="statusDot"></span>
-      <span id="statusText">Обновление данных...</span>
-    </div>
-    <div class="chip">Логин/пароль панели: admin / greenhouse</div>
-  </div>
-</div>
-
-<script>
-let lastSensors = null;
-
-function classForMetric(id, value) {
-  if (value === null) return '';
-  if (id === 'm-airT') {
-    if (value < 10 || value > 40) return 'alarm';
-    if (value < 15 || value > 35) return 'warn';
-    return 'ok';
-  }
-  if (id === 'm-airH') {
-    if (value < 20 || value > 90) return 'alarm';
-    if (value < 30 || value > 80) return 'warn';
-    return 'ok';
-  }
-  if (id === 'm-soilW') {
-    if (value < 15 || value > 95) return 'alarm';
-    if (value < 25 || value > 90) return 'warn';
-    return 'ok';
-  }
-  if (id === 'm-lux') {
-    return '';
-  }
-  return '';
-}
-
-function updateMetrics(s) {
-  lastSensors = s;
-  const map = {
-    'm-airT': {v: s.airTemperature, u:'°C'},
-    'm-airH': {v: s.airHumidity,    u:'%'},
-    'm-soilW':{v: s.soilMoisture,   u:'%'},
-    'm-lux':  {v: s.lightLevelLux,  u:'lux'}
-  };
-  Object.keys(map).forEach(id => {
-    const el  = document.getElementById(id);
-    const val = map[id].v;
-    const u   = map[id].u;
-    if (!el) return;
-    const vEl = el.querySelector('.value');
-    if (val === null || isNaN(val)) {
-      vEl.innerHTML = '--<small>'+u+'</small>';
-      el.className = 'metric';
-    } else {
-      vEl.innerHTML = val.toFixed(1)+'<small>'+u+'</small>';
-      const cls = classForMetric(id, val);
-      el.className = 'metric'+(cls ? ' '+cls : '');
+// ===== API =====
+// Все JSON-ответы пишутся JsonWriter'ом в буфер ответа и уходят chunked:
+// produce() дописывает очередную порцию документа и возвращает false, когда
+// документ закончен. Порции генерируются по мере освобождения TCP-окна —
+// ни весь ответ, ни временные String в памяти не собираются.
+// Тот же механизм с MetricsWriter отдаёт /metrics.
+typedef std::function<bool(JsonWriter &w)> JsonProducer;
+
+static constexpr size_t JSON_CHUNK = 2048;   // максимум одной порции
+
+// Порция, не влезшая в JSON_CHUNK, не уходит обрезанной под кодом 200:
+//  - первая готовится ещё в обработчике (prime) — не влезла, ответ 500;
+//  - более поздняя (заголовки уже отправлены) — _sourceValid() становится
+//    false, и библиотека закрывает соединение: клиент видит оборванный
+//    chunked-ответ без завершающей нулевой порции, а не «успешный» документ.
+// Заодно меряет TTFB — от создания ответа до передачи первых байт тела в TCP.
+template <typename Writer>
+class WriterResponse : public AsyncAbstractResponse {
+public:
+  WriterResponse(AsyncWebServerRequest *req, int code, const char *contentType,
+                 std::function<bool(Writer &w)> fn)
+      : produce(fn), createdUs(Perf::nowUs()) {
+    _code              = code;
+    _contentType       = contentType;
+    _contentLength     = 0;
+    _sendContentLength = false;
+    _chunked           = req->version() != 0;   // HTTP/1.0 — конец тела по закрытию
+  }
+
+  // Первая порция; false — не влезла
+  bool prime() {
+    fill();
+    return !failed;
+  }
+
+  bool _sourceValid() const override { return !failed; }
+
+  size_t _fillBuffer(uint8_t *out, size_t maxLen) override {
+    size_t copied = 0;
+    while (copied < maxLen) {
+      if (head == w.length()) {
+        if (!more) break;
+        fill();
+        if (failed) return copied ? copied : RESPONSE_TRY_AGAIN;
+        continue;
+      }
+      size_t n = min(maxLen - copied, w.length() - head);
+      memcpy(out + copied, w.c_str() + head, n);
+      head   += n;
+      copied += n;
     }
-  });
+    if (createdUs != 0 && copied > 0) {
+      Perf::record(Perf::WEB_TTFB, (uint32_t)(Perf::nowUs() - createdUs));
+      createdUs = 0;
+    }
+    return copied;
+  }
 
-  const dot = document.getElementById('statusDot');
-  const txt = document.getElementById('statusText');
-  if (s.automationEnabled) {
-    dot.style.background = '#22c55e';
-    txt.textContent = 'Автоматика: ВКЛ';
-  } else {
-    dot.style.background = '#f97316';
-    txt.textContent = 'Автоматика: ВЫКЛ';
-  }
-}
-
-async function fetchJson(url, opts) {
-  const res = await fetch(url, opts || {});
-  if (!res.ok) throw new Error('HTTP '+res.status);
-  return await res.json();
-}
-
-async function loadSensors() {
-  try {
-    const data = await fetchJson('/api/sensors');
-    updateMetrics(data);
-  } catch(e) {
-    console.error(e);
-  }
-}
-
-async function loadSettings() {
-  try {
-    const s = await fetchJson('/api/settings');
-    const set = (id,val)=>{ const el=document.getElementById(id); if(el) el.value = val; };
-    set('comfortTempMin', s.comfortTempMin);
-    set('comfortTempMax', s.comfortTempMax);
-    set('comfortHumMin',  s.comfortHumMin);
-    set('comfortHumMax',  s.comfortHumMax);
-    set('soilMoistureSetpoint', s.soilMoistureSetpoint);
-    set('soilMoistureHysteresis', s.soilMoistureHysteresis);
-    set('lightLuxMin', s.lightLuxMin);
-    set('wateringStartHour', s.wateringStartHour);
-    set('wateringEndHour',   s.wateringEndHour);
-    set('lightCutoffHour',   s.lightCutoffHour);
-    set('climateMode',       s.climateMode);
-  } catch(e) {
-    console.error(e);
-  }
-}
-
-async function saveSettings() {
-  const ids = ['comfortTempMin','comfortTempMax','comfortHumMin','comfortHumMax',
-               'soilMoistureSetpoint','soilMoistureHysteresis','lightLuxMin',
-               'wateringStartHour','wateringEndHour','lightCutoffHour','climateMode'];
-  const body = {};
-  ids.forEach(id => {
-    const el = document.getElementById(id);
-    if (!el) return;
-    body[id] = el.value;
-  });
+private:
+  char                          buf[JSON_CHUNK];
+  Writer                        w{buf, sizeof(buf)};
+  std::function<bool(Writer &)> produce;
+  int64_t                       createdUs;     // 0 — TTFB уже записан
+  size_t                        head   = 0;    // сколько байт порции уже отдано
+  bool                          more   = true;
+  bool                          failed = false;
+
+  void fill() {
+    w.clearBuffer();
+    head = 0;
+    more = produce(w);
+    if (w.overflow()) {
+      Serial.println(F("⚠️ Web: порция ответа не влезла в буфер, ответ прерван"));
+      failed = true;
+      more   = false;
+    }
+  }
+};
+
+template <typename Writer>
+static AsyncWebServerResponse *chunkedResponse(AsyncWebServerRequest *req, const char *contentType,
+                                               std::function<bool(Writer &w)> produce, int code = 200) {
+  WriterResponse<Writer> *res = new WriterResponse<Writer>(req, code, contentType, produce);
+  if (!res->prime()) {
+    delete res;
+    return req->beginResponse(500, "text/plain", "Response chunk overflow");
+  }
+  return res;
+}
 
-  try {
-    await fetch('/api/settings', {
-      method: 'POST',
-      headers: { 'Content-Type':'application/json' },
-      body: JSON.stringify(body)
-    });
-    alert('Настройки сохранены');
-    loadSettings();
-  } catch(e) {
-    console.error(e);
-    alert('Ошибка сохранения');
+static AsyncWebServerResponse *jsonResponse(AsyncWebServerRequest *req, JsonProducer produce,
+                                            int code = 200) {
+  return chunkedResponse<JsonWriter>(req, "application/json", produce, code);
+}
+
+// Поля показаний в порядке вывода; те же таблицы строят дельты /api/stream
+struct SensorFloatField {
+  const char  *key;
+  float SensorData::*ptr;
+  uint8_t      decimals;
+};
+struct SensorBoolField {
+  const char *key;
+  bool SensorData::*ptr;
+};
+
+static const SensorFloatField SENSOR_FLOATS[] = {
+  {"airTemperature",  &SensorData::airTemperature,  1},
+  {"airHumidity",     &SensorData::airHumidity,     1},
+  {"soilMoisture",    &SensorData::soilMoisture,    1},
+  {"soilMoistureVar", &SensorData::soilMoistureVar, 2},
+  {"lightLevelLux",   &SensorData::lightLevelLux,   1},
+};
+static const SensorBoolField SENSOR_BOOLS[] = {
+  {"pumpOn",   &SensorData::pumpOn},
+  {"fanOn",    &SensorData::fanOn},
+  {"lightOn",  &SensorData::lightOn},
+  {"doorOpen", &SensorData::doorOpen},
+};
+
+static inline float jsonFloat(float v) { return isnan(v) ? 0.0f : v; }
+
+// Значения, одинаковые после округления до выводимой точности, не меняются
+static bool floatChanged(float a, float b, uint8_t decimals) {
+  float k = decimals == 2 ? 100.0f : 10.0f;
+  return lroundf(jsonFloat(a) * k) != lroundf(jsonFloat(b) * k);
+}
+
+// prev == nullptr — полный объект; иначе только поля, изменившиеся
+// относительно prev. false — изменений нет (в w ничего не записано).
+bool WebInterface::writeSensors(JsonWriter &w, const SensorData &sd, uint32_t version,
+                                bool automation, const StreamState *prev) {
+  bool any = false;
+  w.beginObject();
+
+  for (const SensorFloatField &f : SENSOR_FLOATS) {
+    if (prev && !floatChanged(sd.*f.ptr, prev->data.*f.ptr, f.decimals)) continue;
+    w.field(f.key, jsonFloat(sd.*f.ptr), f.decimals);
+    any = true;
+  }
+  for (const SensorBoolField &f : SENSOR_BOOLS) {
+    if (prev && sd.*f.ptr == prev->data.*f.ptr) continue;
+    w.field(f.key, sd.*f.ptr);
+    any = true;
+  }
+  if (!prev || automation != prev->automation) {
+    w.field("automationEnabled", automation);
+    any = true;
   }
+  if (prev && !any) {
+    w.clearBuffer();
+    return false;
+  }
+
+  w.field("timestampMs", sd.timestampMs);
+  w.field("version", version);
+  w.endObject();
+  return true;
 }
 
-async function ctrl(device, action) {
-  try {
-    await fetch('/api/control', {
-      method: 'POST',
-      headers: {'Content-Type':'application/json'},
-      body: JSON.stringify({ device, action })
-    });
-  } catch(e) {
-    console.error(e);
+void WebInterface::handleSensors(AsyncWebServerRequest *req) {
+  req->send(jsonResponse(req, [this](JsonWriter &w) {
+    SensorData sd;
+    uint32_t   version = g_sensorStore.read(sd);
+    writeSensors(w, sd, version, g_settings.automationEnabled, nullptr);
+    return false;
+  }));
+}
+
+// Тот же снимок в двоичном виде (формат — SensorPacket.h), без текста
+void WebInterface::handleSensorsBin(AsyncWebServerRequest *req) {
+  SensorData   sd;
+  uint32_t     version = g_sensorStore.read(sd);
+  SensorPacket pkt     = SensorPacket::from(sd, version, g_settings.automationEnabled);
+
+  AsyncResponseStream *res = req->beginResponseStream("application/octet-stream", sizeof(pkt));
+  res->write(reinterpret_cast<const uint8_t*>(&pkt), sizeof(pkt));
+  res->addHeader("Cache-Control", "no-store");
+  req->send(res);
+}
+
+void WebInterface::handleSettingsGet(AsyncWebServerRequest *req) {
+  req->send(jsonResponse(req, [](JsonWriter &w) {
+    w.beginObject();
+    for (uint8_t i = 0; i < SettingsFields::count(); ++i) {
+      SettingsFields::write(w, g_settings, SettingsFields::field(i));
+    }
+    w.endObject();
+    return false;
+  }));
+}
+
+// Ответ на POST с телом: {"ok":..,"unknown":[ключи], ...} — неизвестные поля
+// не ломают запрос, но возвращаются клиенту. Список — до ~1,2 КБ (8 ключей
+// по 23 байта, в худшем случае каждый байт — \u00XX), поэтому ответы пишут
+// его отдельной порцией jsonResponse
+static constexpr uint8_t MAX_REPORTED = 8;
+
+struct BodyReport {
+  char    unknown[MAX_REPORTED][24];
+  uint8_t unknownCount = 0;
+
+  void addUnknown(const char *key) {
+    if (unknownCount < MAX_REPORTED) {
+      strlcpy(unknown[unknownCount++], key, sizeof(unknown[0]));
+    }
   }
+
+  void writeUnknown(JsonWriter &w) const {
+    w.key("unknown").beginArray();
+    for (uint8_t i = 0; i < unknownCount; ++i) w.value(unknown[i]);
+    w.endArray();
+  }
+};
+
+static void sendBadJson(AsyncWebServerRequest *req, size_t pos) {
+  char buf[96];
+  JsonWriter w(buf, sizeof(buf));
+  w.beginObject();
+  w.field("ok", false);
+  w.field("error", "bad_json");
+  w.field("pos", (unsigned long)pos);
+  w.endObject();
+  req->send(400, "application/json", w.c_str());
+}
+
+static void sendError(AsyncWebServerRequest *req, int code, const char *error) {
+  char buf[96];
+  JsonWriter w(buf, sizeof(buf));
+  w.beginObject().field("ok", false).field("error", error).endObject();
+  req->send(code, "application/json", w.c_str());
 }
 
-async function scanWifi() {
-  const listEl = document.getElementById('wifiList');
-  listEl.textContent = 'Сканирование...';
-  try {
-    const data = await fetchJson('/api/wifi_scan');
-    if (!data.networks || !data.networks.length) {
-      listEl.textContent = 'Сети не найдены';
+// Один проход по телу: каждое поле ищется в таблице SettingsFields,
+// проверяется диапазон и пишется в копию настроек. Сохраняем, только если
+// ошибок нет, — частично применённых настроек не бывает.
+void WebInterface::handleSettingsPost(AsyncWebServerRequest *req, const char *body, size_t len) {
+  struct Invalid { const char *key; SettingsFields::Result why; };
+  Invalid    invalid[MAX_REPORTED];
+  uint8_t    invalidCount = 0;
+  uint8_t    applied      = 0;
+  BodyReport report;
+
+  JsonReader        r(body, len);
+  JsonReader::Value v;
+  char              key[24];
+
+  {
+    ControlLock    lock;
+    SystemSettings next = g_settings;
+
+    if (r.beginObject()) {
+      while (r.nextMember(key, sizeof(key), v)) {
+        const SettingsFields::Field *f = SettingsFields::find(key);
+        if (!f) {
+          report.addUnknown(key);
+          continue;
+        }
+        SettingsFields::Result res = SettingsFields::apply(next, *f, v);
+        if (res == SettingsFields::OK) {
+          applied++;
+        } else if (invalidCount < MAX_REPORTED) {
+          invalid[invalidCount++] = { f->key, res };
+        }
+      }
+    }
+    if (r.failed()) {
+      sendBadJson(req, r.errorPos());
       return;
     }
-    listEl.innerHTML = data.networks.map(n => `• ${n.ssid} (${n.rssi} dBm)`).join('<br>');
-  } catch(e) {
-    console.error(e);
-    listEl.textContent = 'Ошибка сканирования';
+
+    if (invalidCount == 0 && applied > 0) {
+      g_settings = next;
+      g_eeprom.saveSettings(g_settings);
+    }
   }
+
+  // Порции: итог и ошибки полей, затем неизвестные ключи
+  bool ok   = invalidCount == 0;
+  bool head = true;
+  req->send(jsonResponse(req, [=](JsonWriter &w) mutable {
+    if (head) {
+      head = false;
+      w.beginObject();
+      w.field("ok", ok);
+      w.field("applied", ok ? applied : 0);
+      w.key("invalid").beginArray();
+      for (uint8_t i = 0; i < invalidCount; ++i) {
+        w.beginObject();
+        w.field("field", invalid[i].key);
+        w.field("error", SettingsFields::resultName(invalid[i].why));
+        w.endObject();
+      }
+      w.endArray();
+      return true;
+    }
+    report.writeUnknown(w);
+    w.endObject();
+    return false;
+  }, ok ? 200 : 400));
 }
 
-async function saveWifi() {
-  const ssid = document.getElementById('wifiSsid').value.trim();
-  const pass = document.getElementById('wifiPass').value.trim();
-  if (!ssid) {
-    alert('Введите SSID сети');
-    return;
+// ===== Команды и сцены =====
+// Пакет команд: {"device","action"[,"ms"]} — одна, [{...},...] или
+// {"commands":[...]} — несколько, {"scene":"имя"} — сохранённая сцена.
+struct CommandBatch {
+  Commands::Command cmds[Commands::MAX_BATCH];
+  Commands::Result  res[Commands::MAX_BATCH];
+  uint8_t           n       = 0;
+  bool              tooMany = false;
+
+  void add(const Commands::Command &c, Commands::Result r) {
+    if (n >= Commands::MAX_BATCH) {
+      tooMany = true;
+      return;
+    }
+    cmds[n] = c;
+    res[n]  = r;
+    n++;
   }
-  try {
-    const res = await fetch('/api/wifi_set', {
-      method: 'POST',
-      headers: { 'Content-Type':'application/json' },
-      body: JSON.stringify({ ssid, password: pass })
-    });
-    const txt = await res.text();
-    try {
-      const j = JSON.parse(txt);
-      alert(j.message || 'Настройки сохранены. Устройство перезапускает Wi-Fi.');
-    } catch {
-      alert('Ответ: '+txt);
+
+  bool allOk() const {
+    for (uint8_t i = 0; i < n; ++i) {
+      if (res[i] != Commands::OK) return false;
+    }
+    return n > 0 && !tooMany;
+  }
+};
+
+// Поля одной команды; take() — false, если ключ не из команды
+struct CommandFields {
+  char     device[16] = "";
+  char     action[16] = "";
+  uint16_t ms         = 0;
+  bool     any        = false;
+  bool     bad        = false;
+
+  bool take(const char *key, const JsonReader::Value &v) {
+    double x;
+    if      (strcmp(key, "device") == 0) bad |= !v.copyString(device, sizeof(device));
+    else if (strcmp(key, "action") == 0) bad |= !v.copyString(action, sizeof(action));
+    else if (strcmp(key, "ms") == 0) {
+      if (v.asNumber(x) && x >= 0 && x <= 65535) ms = (uint16_t)x;
+      else bad = true;
+    }
+    else return false;
+    any = true;
+    return true;
+  }
+
+  Commands::Result build(Commands::Command &c) const {
+    if (bad) return Commands::BAD_ARG;
+    return Commands::make(device, action, ms, c);
+  }
+};
+
+// Массив команд; false — синтаксическая ошибка, errPos — позиция в теле
+static bool parseCommandList(const char *base, const JsonReader::Value &list,
+                             CommandBatch &batch, BodyReport &report, size_t &errPos) {
+  JsonReader        r(list.start, list.len);
+  JsonReader::Value v, f;
+  char              key[24];
+
+  if (r.beginArray()) {
+    while (r.nextElement(v)) {
+      CommandFields     fields;
+      Commands::Command c;
+      if (v.type == JsonReader::T_OBJECT) {
+        JsonReader item(v.start, v.len);
+        if (item.beginObject()) {
+          while (item.nextMember(key, sizeof(key), f)) {
+            if (!fields.take(key, f)) report.addUnknown(key);
+          }
+        }
+        if (item.failed()) {
+          errPos = (size_t)(v.start - base) + item.errorPos();
+          return false;
+        }
+        batch.add(c, fields.build(c));
+      } else {
+        batch.add(c, Commands::BAD_ARG);
+      }
     }
-  } catch(e) {
-    console.error(e);
-    alert('Ошибка отправки настроек Wi-Fi');
   }
+  if (r.failed()) {
+    errPos = (size_t)(list.start - base) + r.errorPos();
+    return false;
+  }
+  return true;
 }
 
-async function loadDiag() {
-  try {
-    const data = await fetchJson('/api/diagnostics');
-    const pre  = document.getElementById('diag');
-    pre.textContent = data.text;
-  } catch(e) {
-    console.error(e);
+static void writeCommand(JsonWriter &w, const Commands::Command &c) {
+  w.field("device", Commands::deviceName(c.device));
+  w.field("action", Commands::actionName(c.action));
+  if (c.action == Commands::ACT_PULSE) w.field("ms", (unsigned)c.arg);
+}
+
+static bool validSceneName(const char *name) {
+  size_t n = strlen(name);
+  if (n == 0 || n >= Scene::NAME_LEN) return false;
+  for (size_t i = 0; i < n; ++i) {
+    char c = name[i];
+    if (!isalnum((unsigned char)c) && c != '_' && c != '-') return false;
   }
+  return true;
 }
 
-setInterval(loadSensors, 4000);
-setInterval(loadDiag,    15000);
+// Все команды проверяются до выполнения; если хоть одна неверна — не
+// выполняется ни одна. Корректные выполняются одним шагом под ControlLock.
+void WebInterface::handleControl(AsyncWebServerRequest *req, const char *body, size_t len) {
+  CommandBatch      batch;
+  BodyReport        report;
+  CommandFields     single;
+  char              scene[Scene::NAME_LEN] = "";
+  size_t            errPos = 0;
+  bool              sceneBad = false;
+
+  JsonReader        r(body, len);
+  JsonReader::Value v;
+  char              key[24];
+
+  const char *p = body;
+  while (p < body + len && isspace((unsigned char)*p)) p++;
+
+  if (p < body + len && *p == '[') {
+    JsonReader::Value all;
+    all.type  = JsonReader::T_ARRAY;
+    all.start = p;
+    all.len   = (size_t)(body + len - p);
+    if (!parseCommandList(body, all, batch, report, errPos)) {
+      sendBadJson(req, errPos);
+      return;
+    }
+  } else {
+    JsonReader::Value list;
+    if (r.beginObject()) {
+      while (r.nextMember(key, sizeof(key), v)) {
+        if (single.take(key, v)) continue;
+        if      (strcmp(key, "scene") == 0)                                  sceneBad = !v.copyString(scene, sizeof(scene));
+        else if (strcmp(key, "commands") == 0 && v.type == JsonReader::T_ARRAY) list = v;
+        else                                                                 report.addUnknown(key);
+      }
+    }
+    if (r.failed()) {
+      sendBadJson(req, r.errorPos());
+      return;
+    }
+    if (sceneBad) {
+      sendError(req, 400, "bad_scene");
+      return;
+    }
+
+    // Сцена первой, затем явные команды — ими можно уточнить сцену
+    if (scene[0]) {
+      ControlLock  lock;
+      const Scene *s = g_scenes.find(scene);
+      if (!s) {
+        sendError(req, 404, "unknown_scene");
+        return;
+      }
+      for (uint8_t i = 0; i < s->count; ++i) batch.add(s->cmds[i], Commands::OK);
+    }
+    if (single.any) {
+      Commands::Command c;
+      batch.add(c, single.build(c));
+    }
+    if (list.type == JsonReader::T_ARRAY && !parseCommandList(body, list, batch, report, errPos)) {
+      sendBadJson(req, errPos);
+      return;
+    }
+  }
 
-loadSensors();
-loadSettings();
-loadDiag();
-</script>
-</body>
-</html>
-)rawliteral";
+  uint32_t atMs[Commands::MAX_BATCH] = {0};
+  bool     ok = batch.allOk();
+  if (ok) {
+    Commands::applyAll(batch.cmds, batch.n, atMs);
+  } else {
+    for (uint8_t i = 0; i < batch.n; ++i) {
+      if (batch.res[i] == Commands::OK) batch.res[i] = Commands::NOT_APPLIED;
+    }
+  }
 
-void WebInterface::handleRoot() {
-  server.send_P(200, "text/html", INDEX_HTML);
+  // Порции: итог и результаты (MAX_BATCH × ~110 байт), затем неизвестные ключи.
+  // Команды уже выполнены — ответ не должен сорваться из-за размера
+  bool head = true;
+  req->send(jsonResponse(req, [=](JsonWriter &w) mutable {
+    if (head) {
+      head = false;
+      w.beginObject();
+      w.field("ok", ok);
+      if (scene[0]) w.field("scene", (const char*)scene);
+      if (batch.tooMany) w.field("error", "too_many_commands");
+      else if (batch.n == 0) w.field("error", "no_commands");
+      w.key("results").beginArray();
+      for (uint8_t i = 0; i < batch.n; ++i) {
+        w.beginObject();
+        if (batch.res[i] != Commands::UNKNOWN_DEVICE && batch.res[i] != Commands::UNKNOWN_ACTION &&
+            batch.res[i] != Commands::BAD_ARG) {
+          writeCommand(w, batch.cmds[i]);
+        }
+        w.field("result", Commands::resultName(batch.res[i]));
+        if (ok) w.field("atMs", (unsigned long)atMs[i]);
+        w.endObject();
+      }
+      w.endArray();
+      return true;
+    }
+    report.writeUnknown(w);
+    w.endObject();
+    return false;
+  }, ok ? 200 : 400));
 }
 
-void WebInterface::handleNotFound() {
-  server.send(404, "text/plain", "Not found");
-}
+// {"scenes":[{"name","commands":[...]}]} — по сцене на порцию
+void WebInterface::handleScenesGet(AsyncWebServerRequest *req) {
+  uint8_t i = 0;
+  req->send(jsonResponse(req, [i](JsonWriter &w) mutable {
+    if (i == 0) w.beginObject().key("scenes").beginArray();
+
+    Scene s;
+    bool  have;
+    {
+      ControlLock lock;
+      have = i < g_scenes.count();
+      if (have) s = g_scenes.at(i);
+    }
+    if (!have) {
+      w.endArray().endObject();
+      return false;
+    }
 
-// ===== API =====
+    w.beginObject();
+    w.field("name", (const char*)s.name);
+    w.key("commands").beginArray();
+    for (uint8_t c = 0; c < s.count; ++c) {
+      w.beginObject();
+      writeCommand(w, s.cmds[c]);
+      w.endObject();
+    }
+    w.endArray();
+    w.endObject();
+    i++;
+    return true;
+  }));
+}
 
-String WebInterface::buildSensorsJson() {
-  String j;
-  j.reserve(256);
-  j += "{";
-  j += "\"airTemperature\":"  + String(isnan(g_sensorData.airTemperature)?0:g_sensorData.airTemperature,1) + ",";
-  j += "\"airHumidity\":"     + String(isnan(g_sensorData.airHumidity)?0:g_sensorData.airHumidity,1) + ",";
-  j += "\"soilMoisture\":"    + String(isnan(g_sensorData.soilMoisture)?0:g_sensorData.soilMoisture,1) + ",";
-  j += "\"lightLevelLux\":"   + String(isnan(g_sensorData.lightLevelLux)?0:g_sensorData.lightLevelLux,1) + ",";
-  j += "\"pumpOn\":"          + String(g_sensorData.pumpOn ? "true":"false") + ",";
-  j += "\"fanOn\":"           + String(g_sensorData.fanOn  ? "true":"false") + ",";
-  j += "\"lightOn\":"         + String(g_sensorData.lightOn ? "true":"false") + ",";
-  j += "\"doorOpen\":"        + String(g_sensorData.doorOpen ? "true":"false") + ",";
-  j += "\"automationEnabled\":"+ String(g_settings.automationEnabled ? "true":"false");
-  j += "}";
-  return j;
-}
-
-void WebInterface::handleSensors() {
-  server.send(200, "application/json", buildSensorsJson());
-}
-
-String WebInterface::buildSettingsJson() {
-  String j;
-  j.reserve(256);
-  j += "{";
-  j += "\"comfortTempMin\":"       + String(g_settings.comfortTempMin,1) + ",";
-  j += "\"comfortTempMax\":"       + String(g_settings.comfortTempMax,1) + ",";
-  j += "\"comfortHumMin\":"        + String(g_settings.comfortHumMin,1) + ",";
-  j += "\"comfortHumMax\":"        + String(g_settings.comfortHumMax,1) + ",";
-  j += "\"soilMoistureSetpoint\":"+ String(g_settings.soilMoistureSetpoint,1) + ",";
-  j += "\"soilMoistureHysteresis\":"+String(g_settings.soilMoistureHysteresis,1) + ",";
-  j += "\"lightLuxMin\":"          + String(g_settings.lightLuxMin,1) + ",";
-  j += "\"wateringStartHour\":"    + String(g_settings.wateringStartHour) + ",";
-  j += "\"wateringEndHour\":"      + String(g_settings.wateringEndHour) + ",";
-  j += "\"lightCutoffHour\":"      + String(g_settings.lightCutoffHour) + ",";
-  j += "\"climateMode\":"          + String(g_settings.climateMode);
-  j += "}";
-  return j;
-}
-
-void WebInterface::handleSettingsGet() {
-  server.send(200, "application/json", buildSettingsJson());
-}
-
-void WebInterface::handleSettingsPost() {
-  if (!server.hasArg("plain")) {
-    server.send(400, "text/plain", "Expected JSON body");
+// {"name":"evening","commands":[...]} — сохранить (заменить),
+// пустой "commands" — удалить сцену
+void WebInterface::handleScenesPost(AsyncWebServerRequest *req, const char *body, size_t len) {
+  CommandBatch      batch;
+  BodyReport        report;
+  Scene             scene;
+  size_t            errPos   = 0;
+  bool              nameOk   = false;
+
+  JsonReader        r(body, len);
+  JsonReader::Value v, list;
+  char              key[24];
+
+  if (r.beginObject()) {
+    while (r.nextMember(key, sizeof(key), v)) {
+      if      (strcmp(key, "name") == 0)                                      nameOk = v.copyString(scene.name, sizeof(scene.name));
+      else if (strcmp(key, "commands") == 0 && v.type == JsonReader::T_ARRAY) list = v;
+      else                                                                    report.addUnknown(key);
+    }
+  }
+  if (r.failed()) {
+    sendBadJson(req, r.errorPos());
     return;
   }
-  String body = server.arg("plain");
-
-  auto getNumber = [&](const String &key, float current)->float {
-    int idx = body.indexOf("\"" + key + "\"");
-    if (idx < 0) return current;
-    idx = body.indexOf(":", idx);
-    if (idx < 0) return current;
-    int end = body.indexOf(",", idx);
-    if (end < 0) end = body.indexOf("}", idx);
-    if (end < 0) return current;
-    String sub = body.substring(idx+1, end);
-    sub.trim();
-    return sub.toFloat();
-  };
-
-  auto getInt = [&](const String &key, int current)->int {
-    return (int)getNumber(key, current);
-  };
-
-  g_settings.comfortTempMin        = getNumber("comfortTempMin", g_settings.comfortTempMin);
-  g_settings.comfortTempMax        = getNumber("comfortTempMax", g_settings.comfortTempMax);
-  g_settings.comfortHumMin         = getNumber("comfortHumMin",  g_settings.comfortHumMin);
-  g_settings.comfortHumMax         = getNumber("comfortHumMax",  g_settings.comfortHumMax);
-  g_settings.soilMoistureSetpoint  = getNumber("soilMoistureSetpoint", g_settings.soilMoistureSetpoint);
-  g_settings.soilMoistureHysteresis= getNumber("soilMoistureHysteresis", g_settings.soilMoistureHysteresis);
-  g_settings.lightLuxMin           = getNumber("lightLuxMin", g_settings.lightLuxMin);
-  g_settings.wateringStartHour     = (uint8_t)constrain(getInt("wateringStartHour", g_settings.wateringStartHour),0,23);
-  g_settings.wateringEndHour       = (uint8_t)constrain(getInt("wateringEndHour",   g_settings.wateringEndHour),0,23);
-  g_settings.lightCutoffHour       = (uint8_t)constrain(getInt("lightCutoffHour",   g_settings.lightCutoffHour),0,23);
-  g_settings.climateMode           = (uint8_t)constrain(getInt("climateMode",       g_settings.climateMode),0,2);
-
-  g_eeprom.saveSettings(g_settings);
-  server.send(200, "text/plain", "OK");
-}
-
-void WebInterface::handleControl() {
-  if (!server.hasArg("plain")) {
-    server.send(400, "text/plain", "Expected JSON body");
+  if (!nameOk || !validSceneName(scene.name)) {
+    sendError(req, 400, "bad_name");
     return;
   }
-  String body = server.arg("plain");
-
-  auto getStr = [&](const String &key)->String {
-    int idx = body.indexOf("\"" + key + "\"");
-    if (idx < 0) return "";
-    idx = body.indexOf(":", idx);
-    if (idx < 0) return "";
-    int q1 = body.indexOf("\"", idx+1);
-    int q2 = body.indexOf("\"", q1+1);
-    if (q1 < 0 || q2 < 0) return "";
-    return body.substring(q1+1, q2);
-  };
-
-  String device = getStr("device");
-  String action = getStr("action");
-
-  if (device == "pump") {
-    if      (action == "pulse") g_devices.setPump(true, 1000);
-    else if (action == "on")    g_devices.setPump(true, 0);
-    else if (action == "off")   g_devices.setPump(false);
-  } else if (device == "light") {
-    if      (action == "on")    g_devices.setLight(true);
-    else if (action == "off")   g_devices.setLight(false);
-  } else if (device == "fan") {
-    if      (action == "on")    g_devices.setFan(true);
-    else if (action == "off")   g_devices.setFan(false);
-  } else if (device == "door") {
-    if      (action == "open")  g_devices.setDoorAngle(Constants::SERVO_OPEN_ANGLE);
-    else if (action == "half")  g_devices.setDoorAngle(Constants::SERVO_HALF_ANGLE);
-    else if (action == "close") g_devices.setDoorAngle(Constants::SERVO_CLOSED_ANGLE);
-  } else if (device == "auto") {
-    if      (action == "on")  g_settings.automationEnabled = true;
-    else if (action == "off") g_settings.automationEnabled = false;
-  }
-
-  server.send(200, "text/plain", "OK");
-}
-
-String WebInterface::buildDiagnosticsJson() {
-  String txt;
-  txt.reserve(256);
-
-  txt += "Wi-Fi: ";
-  if (WiFi.getMode() == WIFI_STA && WiFi.status() == WL_CONNECTED) {
-    txt += "STA ";
-    txt += WiFi.SSID();
-    txt += " (";
-    txt += WiFi.localIP().toString();
-    txt += ")\n";
-  } else if (WiFi.getMode() == WIFI_AP) {
-    txt += "AP ";
-    txt += WiFi.softAPIP().toString();
-    txt += "\n";
-  } else {
-    txt += "нет соединения\n";
+  if (list.type == JsonReader::T_ARRAY && !parseCommandList(body, list, batch, report, errPos)) {
+    sendBadJson(req, errPos);
+    return;
   }
 
-  txt += "Климат: T=";
-  txt += String(g_sensorData.airTemperature,1);
-  txt += "C H=";
-  txt += String(g_sensorData.airHumidity,1);
-  txt += "%\n";
+  bool ok      = true;
+  bool deleted = false;
+  const char *error = nullptr;
+
+  if (batch.n == 0 && !batch.tooMany) {
+    ControlLock lock;
+    deleted = g_scenes.remove(scene.name);
+    if (!deleted) { ok = false; error = "unknown_scene"; }
+  } else if (batch.n > Scene::MAX_COMMANDS || batch.tooMany) {
+    ok = false; error = "too_many_commands";
+  } else if (!batch.allOk()) {
+    ok = false; error = "bad_command";
+  } else {
+    scene.count = batch.n;
+    memcpy(scene.cmds, batch.cmds, batch.n * sizeof(Commands::Command));
+    ControlLock lock;
+    if (!g_scenes.put(scene)) { ok = false; error = "scene_table_full"; }
+  }
 
-  txt += "Почва: W=";
-  txt += String(g_sensorData.soilMoisture,1);
-  txt += "%\n";
+  // Порции: итог, затем неизвестные ключи
+  int  code = ok ? 200 : (error && strcmp(error, "unknown_scene") == 0 ? 404 : 400);
+  bool head = true;
+  req->send(jsonResponse(req, [=](JsonWriter &w) mutable {
+    if (head) {
+      head = false;
+      w.beginObject();
+      w.field("ok", ok);
+      w.field("name", (const char*)scene.name);
+      if (deleted) w.field("deleted", true);
+      if (error)   w.field("error", error);
+      if (!ok && batch.n > 0) {
+        w.key("results").beginArray();
+        for (uint8_t i = 0; i < batch.n; ++i) {
+          w.beginObject().field("result", Commands::resultName(batch.res[i])).endObject();
+        }
+        w.endArray();
+      }
+      return true;
+    }
+    report.writeUnknown(w);
+    w.endObject();
+    return false;
+  }, code));
+}
 
-  txt += "Свет: L=";
-  txt += String(g_sensorData.lightLevelLux,1);
-  txt += " lux\n";
+// ===== Диагностика =====
+// {"text":"..."} — текст собирается по разделам, каждый раздел — своя порция
+static void diagOnOff(JsonWriter &w, const char *name, bool on) {
+  w.stringPart(name).stringPart(on ? "ВКЛ" : "ВЫКЛ");
+}
 
-  txt += "Устройства: насос=";
-  txt += (g_sensorData.pumpOn ? "ВКЛ" : "ВЫКЛ");
-  txt += ", вентилятор=";
-  txt += (g_sensorData.fanOn ? "ВКЛ":"ВЫКЛ");
-  txt += ", свет=";
-  txt += (g_sensorData.lightOn ? "ВКЛ":"ВЫКЛ");
-  txt += "\n";
+static void diagIp(JsonWriter &w, const IPAddress &ip) {
+  for (uint8_t i = 0; i < 4; ++i) {
+    if (i > 0) w.stringPart(".");
+    w.stringPart((unsigned long)ip[i]);
+  }
+}
 
-  String j;
-  j.reserve(txt.length() + 20);
-  j += "{";
-  j += "\"text\":\"";
+static void diagNetwork(JsonWriter &w, const SensorData &sd) {
+  w.stringPart("Wi-Fi: ");
+  wifi_ap_record_t ap;
+  if (g_wifi.connected() && esp_wifi_sta_get_ap_info(&ap) == ESP_OK) {
+    w.stringPart("STA ").stringPart((const char*)ap.ssid).stringPart(" (");
+    diagIp(w, WiFi.localIP());
+    w.stringPart(")");
+  } else {
+    w.stringPart("нет соединения (").stringPart(WifiManager::stateName(g_wifi.currentState()));
+    w.stringPart(", неудачных попыток ").stringPart((unsigned long)g_wifi.attempts());
+    if (g_wifi.retryInMs() > 0) {
+      w.stringPart(", повтор через ").stringPart(g_wifi.retryInMs() / 1000).stringPart(" с");
+    }
+    w.stringPart(")");
+  }
+  if (g_wifi.apActive()) {
+    w.stringPart(", AP ");
+    diagIp(w, WiFi.softAPIP());
+  }
+  w.stringPart("\n");
+
+  w.stringPart("Климат: T=").stringPart(sd.airTemperature, 1);
+  w.stringPart("C H=").stringPart(sd.airHumidity, 1).stringPart("%\n");
+  w.stringPart("Почва: W=").stringPart(sd.soilMoisture, 1).stringPart("%\n");
+  w.stringPart("Свет: L=").stringPart(sd.lightLevelLux, 1).stringPart(" lux\n");
+
+  diagOnOff(w, "Устройства: насос=", sd.pumpOn);
+  diagOnOff(w, ", вентилятор=", sd.fanOn);
+  diagOnOff(w, ", свет=", sd.lightOn);
+  w.stringPart("\n");
+
+  w.stringPart("Память: свободно ").stringPart((unsigned long)ESP.getFreeHeap());
+  w.stringPart(" Б, минимум ").stringPart((unsigned long)ESP.getMinFreeHeap());
+  w.stringPart(" Б, макс. блок ").stringPart((unsigned long)ESP.getMaxAllocHeap());
+  w.stringPart(" Б\n");
+}
 
-  for (size_t i=0;i<txt.length();++i) {
-    char c = txt[i];
-    if (c == '\n')      j += "\\n";
-    else if (c == '\"') j += "\\\"";
-    else                j += c;
+static void diagAutomation(JsonWriter &w) {
+  w.stringPart("Переключения:");
+  for (uint8_t i = 0; i < Devices::ACT_COUNT; ++i) {
+    Devices::ActuatorId id = (Devices::ActuatorId)i;
+    w.stringPart(" ").stringPart(Devices::actuatorName(id)).stringPart("=");
+    w.stringPart((unsigned long)g_devices.switchCount(id));
+  }
+  w.stringPart(", насос сегодня ").stringPart(g_devices.pumpMsToday() / 1000UL);
+  w.stringPart(" с, всего ").stringPart(g_devices.pumpMsTotal() / 1000UL).stringPart(" с\n");
+
+  static const char* const MODE_NAMES[Automation::CLIMATE_MODES] = {"Eco", "Normal", "Aggressive"};
+  w.stringPart("Вне комфорта:");
+  for (uint8_t m = 0; m < Automation::CLIMATE_MODES; ++m) {
+    unsigned long total = g_automation.modeSec(m);
+    if (total == 0) continue;
+    w.stringPart(" ").stringPart(MODE_NAMES[m]).stringPart("=");
+    w.stringPart(100.0f * g_automation.outOfBandSec(m) / total, 1);
+    w.stringPart("% из ").stringPart(total / 60UL).stringPart(" мин");
+  }
+  w.stringPart("\n");
+
+  SlopeEstimator::Fit trend = g_automation.soilTrend();
+  w.stringPart("Тренд почвы: ");
+  if (trend.valid) {
+    w.stringPart(trend.slope, 2).stringPart("±").stringPart(trend.stdErr, 2);
+    w.stringPart(" %/ч, R²=").stringPart(trend.r2, 2);
+    w.stringPart(", n≈").stringPart(trend.nEff, 0);
+  } else {
+    w.stringPart("мало данных");
   }
-  j += "\"}";
-  return j;
+  w.stringPart("\n");
 }
 
-void WebInterface::handleDiagnosticsApi() {
-  server.send(200, "application/json", buildDiagnosticsJson());
+static void diagTiming(JsonWriter &w) {
+  w.stringPart("Опрос датчиков:");
+  for (uint8_t i = 0; i < Devices::SENSOR_COUNT; ++i) {
+    Devices::SensorId id  = (Devices::SensorId)i;
+    const SensorTiming &t = g_devices.sensorTiming(id);
+    w.stringPart(" ").stringPart(Devices::sensorName(id)).stringPart("=");
+    w.stringPart((unsigned long)t.lastLatencyMs).stringPart("мс/");
+    w.stringPart((unsigned long)t.lastBusUs).stringPart("мкс");
+    if (t.errors) {
+      w.stringPart(" (ошибок ").stringPart((unsigned long)t.errors).stringPart(")");
+    }
+  }
+  w.stringPart("\n");
+
+  w.stringPart("Цикл управления: ").stringPart((unsigned long)g_runtime.controlLastUs());
+  w.stringPart(" мкс, макс ").stringPart((unsigned long)g_runtime.controlMaxUs());
+  w.stringPart(" мкс, худший интервал ").stringPart((unsigned long)g_runtime.controlMaxGapUs()).stringPart(" мкс\n");
+
+  for (uint8_t i = 0; i < g_scheduler.jobCount(); ++i) {
+    const Scheduler::Job &job = g_scheduler.job(i);
+    w.stringPart("  ").stringPart(job.name);
+    w.stringPart(": n=").stringPart((unsigned long)job.runs);
+    w.stringPart(" max=").stringPart((unsigned long)job.maxRunUs);
+    w.stringPart("мкс опозд=").stringPart((unsigned long)job.maxLateMs);
+    w.stringPart("мс overrun=").stringPart((unsigned long)job.overruns);
+    w.stringPart("\n");
+  }
 }
 
-void WebInterface::handleWifiScan() {
-  int n = WiFi.scanNetworks();
-  String j;
-  j.reserve(128);
-  j += "{\"networks\":[";
-  for (int i=0;i<n;++i) {
-    if (i>0) j += ",";
-    j += "{";
-    j += "\"ssid\":\"" + WiFi.SSID(i) + "\",";
-    j += "\"rssi\":" + String(WiFi.RSSI(i));
-    j += "}";
+// Доля процессорного времени задач FreeRTOS с прошлого запроса (% одного
+// ядра) и запас стека. Нужны счётчики времени выполнения в sdkconfig
+static void diagTasks(JsonWriter &w) {
+#if configUSE_TRACE_FACILITY && configGENERATE_RUN_TIME_STATS
+  static constexpr uint8_t MAX_TASKS = 24;
+  static TaskStatus_t tasks[MAX_TASKS];
+  static UBaseType_t  prevNum[MAX_TASKS];
+  static uint32_t     prevRun[MAX_TASKS];
+  static uint8_t      prevCount = 0;
+  static uint32_t     prevTotal = 0;
+
+  uint32_t    total = 0;
+  UBaseType_t n     = uxTaskGetSystemState(tasks, MAX_TASKS, &total);
+  uint32_t    dt    = total - prevTotal;
+
+  w.stringPart("Задачи (ЦП с прошлого запроса, запас стека):\n");
+  for (UBaseType_t i = 0; i < n; ++i) {
+    const TaskStatus_t &t = tasks[i];
+    uint32_t run = t.ulRunTimeCounter;
+    uint32_t span = total;                        // новая задача — с момента загрузки
+    for (uint8_t k = 0; k < prevCount; ++k) {
+      if (prevNum[k] == t.xTaskNumber) {
+        run -= prevRun[k];
+        span = dt;
+        break;
+      }
+    }
+    w.stringPart("  ").stringPart(t.pcTaskName).stringPart(": ");
+    w.stringPart(span ? 100.0f * run / span : 0.0f, 1).stringPart("%, стек ");
+    w.stringPart((unsigned long)t.usStackHighWaterMark).stringPart("\n");
+  }
+
+  prevCount = (uint8_t)n;
+  for (uint8_t k = 0; k < prevCount; ++k) {
+    prevNum[k] = tasks[k].xTaskNumber;
+    prevRun[k] = tasks[k].ulRunTimeCounter;
   }
-  j += "]}";
-  server.send(200, "application/json", j);
+  prevTotal = total;
+#else
+  w.stringPart("Задачи: нет счётчиков времени (configGENERATE_RUN_TIME_STATS)\n");
+#endif
 }
 
-void WebInterface::handleWifiSet() {
-  if (!server.hasArg("plain")) {
-    server.send(400, "application/json", "{\"ok\":false,\"message\":\"expected JSON body\"}");
-    return;
+void WebInterface::handleDiagnosticsApi(AsyncWebServerRequest *req) {
+  uint8_t section = 0;
+  req->send(jsonResponse(req, [section](JsonWriter &w) mutable {
+    switch (section++) {
+      case 0:
+        w.beginObject().key("text").beginString();
+        diagNetwork(w, g_sensorStore.snapshot());
+        return true;
+      case 1:
+        diagAutomation(w);
+        return true;
+      case 2:
+        diagTasks(w);
+        return true;
+      default:
+        diagTiming(w);
+        w.endString().endObject();
+        return false;
+    }
+  }));
+}
+
+// ===== Скан Wi-Fi =====
+// Готовые результаты скана забираются в кэш: повторы SSID схлопываются
+// в лучший RSSI, список упорядочен по убыванию RSSI.
+void WebInterface::scanLoop() {
+  int16_t n = WiFi.scanComplete();
+  if (n < 0) return;
+
+  ScanCache fresh;
+  for (int16_t i = 0; i < n; ++i) {
+    const wifi_ap_record_t *ap = static_cast<const wifi_ap_record_t*>(WiFi.getScanInfoByIndex(i));
+    if (!ap || ap->ssid[0] == '\0') continue;   // скрытые сети не показываем
+
+    const char *ssid = (const char*)ap->ssid;
+    int8_t      rssi = ap->rssi;
+
+    // Уже есть — оставляем лучший RSSI и убираем запись, чтобы вставить заново
+    uint8_t pos = fresh.count;
+    for (uint8_t j = 0; j < fresh.count; ++j) {
+      if (strcmp(fresh.nets[j].ssid, ssid) == 0) { pos = j; break; }
+    }
+    if (pos < fresh.count) {
+      if (fresh.nets[pos].rssi >= rssi) continue;
+      memmove(&fresh.nets[pos], &fresh.nets[pos + 1], (fresh.count - pos - 1) * sizeof(ScanEntry));
+      fresh.count--;
+    }
+
+    // Вставка по убыванию RSSI; при переполнении выпадает самая слабая
+    uint8_t at = 0;
+    while (at < fresh.count && fresh.nets[at].rssi >= rssi) at++;
+    if (at >= Constants::WIFI_SCAN_MAX) continue;
+    uint8_t tail = fresh.count < Constants::WIFI_SCAN_MAX ? fresh.count : Constants::WIFI_SCAN_MAX - 1;
+    memmove(&fresh.nets[at + 1], &fresh.nets[at], (tail - at) * sizeof(ScanEntry));
+    strlcpy(fresh.nets[at].ssid, ssid, sizeof(fresh.nets[at].ssid));
+    fresh.nets[at].rssi   = rssi;
+    fresh.nets[at].secure = ap->authmode != WIFI_AUTH_OPEN;
+    if (fresh.count < Constants::WIFI_SCAN_MAX) fresh.count++;
   }
+  WiFi.scanDelete();
+
+  fresh.valid   = true;
+  fresh.takenMs = millis();
+  portENTER_CRITICAL(&scanMux);
+  scan = fresh;
+  portEXIT_CRITICAL(&scanMux);
+}
+
+static constexpr uint8_t WIFI_SCAN_PER_CHUNK = 4;
+
+// Ответ сразу из кэша. Если кэш старше WIFI_SCAN_TTL_MS (или ?refresh),
+// запускается фоновый скан, и в ответе "scanning":true — страница
+// переспрашивает, пока он не закончится.
+void WebInterface::handleWifiScan(AsyncWebServerRequest *req) {
+  ScanCache c;
+  portENTER_CRITICAL(&scanMux);
+  c = scan;
+  portEXIT_CRITICAL(&scanMux);
 
-  String body = server.arg("plain");
+  unsigned long age   = millis() - c.takenMs;
+  int16_t       state = WiFi.scanComplete();
+  bool          stale = !c.valid || age >= Constants::WIFI_SCAN_TTL_MS || req->hasParam("refresh");
 
-  auto getString = [&](const String &key, const String &current)->String {
-    int idx = body.indexOf("\"" + key + "\"");
-    if (idx < 0) return current;
-    idx = body.indexOf(":", idx);
-    if (idx < 0) return current;
-    int q1 = body.indexOf("\"", idx+1);
-    int q2 = body.indexOf("\"", q1+1);
-    if (q1 < 0 || q2 < 0) return current;
-    String sub = body.substring(q1+1, q2);
-    sub.trim();
-    return sub;
-  };
+  if (state == WIFI_SCAN_FAILED && stale) {
+    WiFi.scanNetworks(true);
+    state = WIFI_SCAN_RUNNING;
+  }
 
-  String ssid = getString("ssid", "");
-  String pass = getString("password", "");
+  // SSID до 32 байт, в худшем случае каждый — \u00XX: ~250 байт на сеть,
+  // поэтому сети идут порциями по WIFI_SCAN_PER_CHUNK
+  bool    scanning = state != WIFI_SCAN_FAILED;   // идёт или ждёт сбора в loop()
+  uint8_t i        = 0;
+  req->send(jsonResponse(req, [c, age, scanning, i](JsonWriter &w) mutable {
+    if (i == 0) {
+      w.beginObject();
+      w.field("scanning", scanning);
+      w.key("ageMs");
+      if (c.valid) w.value(age);
+      else         w.nullValue();
+      w.key("networks").beginArray();
+    }
+    for (uint8_t n = 0; n < WIFI_SCAN_PER_CHUNK && i < c.count; ++n, ++i) {
+      w.beginObject();
+      w.field("ssid", (const char*)c.nets[i].ssid);
+      w.field("rssi", (int)c.nets[i].rssi);
+      w.field("secure", c.nets[i].secure);
+      w.endObject();
+    }
+    if (i < c.count) return true;
+    w.endArray().endObject();
+    return false;
+  }));
+}
+
+void WebInterface::handleWifiSet(AsyncWebServerRequest *req, const char *body, size_t len) {
+  JsonReader        r(body, len);
+  JsonReader::Value v;
+  char              key[24];
+  char              ssid[sizeof(g_settings.wifiSSID)]     = "";
+  char              pass[sizeof(g_settings.wifiPassword)] = "";
+  bool              tooLong = false;
+  BodyReport        report;
+
+  if (r.beginObject()) {
+    while (r.nextMember(key, sizeof(key), v)) {
+      if      (strcmp(key, "ssid") == 0)     tooLong |= !v.copyString(ssid, sizeof(ssid));
+      else if (strcmp(key, "password") == 0) tooLong |= !v.copyString(pass, sizeof(pass));
+      else                                   report.addUnknown(key);
+    }
+  }
+  if (r.failed()) {
+    sendBadJson(req, r.errorPos());
+    return;
+  }
+  if (tooLong) {
+    req->send(400, "application/json", "{\"ok\":false,\"message\":\"SSID и пароль — строки до 31 символа\"}");
+    return;
+  }
 
-  if (ssid.length() == 0) {
-    server.send(400, "application/json", "{\"ok\":false,\"message\":\"SSID пустой\"}");
+  if (ssid[0] == '\0') {
+    req->send(400, "application/json", "{\"ok\":false,\"message\":\"SSID пустой\"}");
     return;
   }
 
   // Сохраняем в настройки
-  ssid.toCharArray(g_settings.wifiSSID, sizeof(g_settings.wifiSSID));
-  pass.toCharArray(g_settings.wifiPassword, sizeof(g_settings.wifiPassword));
-  g_eeprom.saveSettings(g_settings);
+  {
+    ControlLock lock;
+    strlcpy(g_settings.wifiSSID, ssid, sizeof(g_settings.wifiSSID));
+    strlcpy(g_settings.wifiPassword, pass, sizeof(g_settings.wifiPassword));
+    g_eeprom.saveSettings(g_settings);
+  }
 
-  // Переинициализация Wi-Fi в STA
-  WiFi.disconnect(true);
-  delay(100);
-  WiFi.mode(WIFI_STA);
-  WiFi.begin(g_settings.wifiSSID, g_settings.wifiPassword);
+  // Переподключение — в WifiManager::loop(), после отправки ответа
+  g_wifi.reconnect();
 
-  server.send(200, "application/json",
+  req->send(200, "application/json",
               "{\"ok\":true,\"message\":\"Настройки сохранены. Устройство пытается подключиться к Wi-Fi. Если пропала точка доступа — ищите его в вашей сети.\"}");
-}
\ No newline at end of file
+}
+
+// ===== Производительность =====
+// Порции: заголовок + память, по одной подсистеме, затем опрос датчиков
+void WebInterface::handlePerf(AsyncWebServerRequest *req) {
+  if (req->hasParam("reset")) {
+    Perf::reset();
+  }
+
+  uint8_t step = 0;
+  req->send(jsonResponse(req, [step](JsonWriter &w) mutable {
+    if (step == 0) {
+      w.beginObject();
+      w.field("bucketUnit", "log2_us");
+      w.field("uptimeMs", millis());
+      w.key("heap").beginObject();
+      w.field("free",     (unsigned long)ESP.getFreeHeap());
+      w.field("minFree",  (unsigned long)ESP.getMinFreeHeap());
+      w.field("maxAlloc", (unsigned long)ESP.getMaxAllocHeap());
+      w.endObject();
+      w.key("subsystems").beginObject();
+      step++;
+      return true;
+    }
+
+    if (step <= Perf::CHANNEL_COUNT) {
+      Perf::Channel   ch = (Perf::Channel)(step - 1);
+      Perf::Histogram h  = Perf::snapshot(ch);
+
+      w.key(Perf::channelName(ch)).beginObject();
+      w.field("count", h.count);
+      w.field("avgUs", h.avgUs());
+      w.field("p50Us", h.percentileUs(50));
+      w.field("p99Us", h.percentileUs(99));
+      w.field("maxUs", h.maxUs);
+      w.key("buckets").beginArray();
+      for (uint8_t b = 0; b < Perf::BUCKETS; ++b) w.value(h.buckets[b]);
+      w.endArray().endObject();
+      step++;
+      return true;
+    }
+
+    w.endObject();
+    w.key("acquisition").beginObject();
+    for (uint8_t i = 0; i < Devices::SENSOR_COUNT; ++i) {
+      Devices::SensorId id  = (Devices::SensorId)i;
+      const SensorTiming &t = g_devices.sensorTiming(id);
+
+      w.key(Devices::sensorName(id)).beginObject();
+      w.field("latencyMs",    t.lastLatencyMs);
+      w.field("maxLatencyMs", t.maxLatencyMs);
+      w.field("busUs",        t.lastBusUs);
+      w.field("maxBusUs",     t.maxBusUs);
+      w.field("errors",       t.errors);
+      w.endObject();
+    }
+    w.endObject().endObject();
+    return false;
+  }));
+}
+
+// ===== /metrics (Prometheus) =====
+// Текстовый формат exposition 0.0.4. Порции — по семейству метрик и по
+// половине гистограммы подсистемы; память — один буфер порции, как у JSON.
+struct SensorMetric {
+  const char *name;
+  const char *help;
+  float SensorData::*ptr;
+  uint8_t     decimals;
+};
+static const SensorMetric SENSOR_METRICS[] = {
+  {"greenhouse_air_temperature_celsius",  "Температура воздуха",           &SensorData::airTemperature,  2},
+  {"greenhouse_air_humidity_percent",     "Влажность воздуха",             &SensorData::airHumidity,     2},
+  {"greenhouse_air_pressure_hpa",         "Давление",                      &SensorData::airPressure,     2},
+  {"greenhouse_soil_temperature_celsius", "Температура почвы",             &SensorData::soilTemperature, 2},
+  {"greenhouse_soil_moisture_percent",    "Влажность почвы после фильтра", &SensorData::soilMoisture,    2},
+  {"greenhouse_soil_moisture_variance",   "Дисперсия влажности почвы, %2", &SensorData::soilMoistureVar, 3},
+  {"greenhouse_light_lux",                "Освещённость",                  &SensorData::lightLevelLux,   1},
+};
+
+static constexpr uint8_t METRICS_ROUTES_PER_STEP = 12;
+static constexpr uint8_t METRICS_HIST_SPLIT = Perf::BUCKETS / 2;
+
+static void metricsSystem(MetricsWriter &m) {
+  m.family("greenhouse_uptime_seconds", "gauge", "Время с загрузки");
+  m.metric("greenhouse_uptime_seconds").value((unsigned long long)(esp_timer_get_time() / 1000000));
+
+  m.family("greenhouse_heap_free_bytes", "gauge", "Свободная куча");
+  m.metric("greenhouse_heap_free_bytes").value((unsigned long)ESP.getFreeHeap());
+  m.family("greenhouse_heap_min_free_bytes", "gauge", "Минимум свободной кучи с загрузки");
+  m.metric("greenhouse_heap_min_free_bytes").value((unsigned long)ESP.getMinFreeHeap());
+  m.family("greenhouse_heap_max_alloc_bytes", "gauge", "Крупнейший свободный блок кучи");
+  m.metric("greenhouse_heap_max_alloc_bytes").value((unsigned long)ESP.getMaxAllocHeap());
+
+  m.family("greenhouse_wifi_connected", "gauge", "STA-соединение установлено");
+  m.metric("greenhouse_wifi_connected").value((unsigned long)(g_wifi.connected() ? 1 : 0));
+  m.family("greenhouse_automation_enabled", "gauge", "Автоматика включена");
+  m.metric("greenhouse_automation_enabled").value((unsigned long)(g_settings.automationEnabled ? 1 : 0));
+}
+
+static void metricsSensors(MetricsWriter &m) {
+  SensorData sd;
+  uint32_t   version = g_sensorStore.read(sd);
+
+  for (const SensorMetric &f : SENSOR_METRICS) {
+    m.family(f.name, "gauge", f.help);
+    m.metric(f.name).value(sd.*f.ptr, f.decimals);
+  }
+  m.family("greenhouse_sensors_healthy", "gauge", "Все датчики отвечают");
+  m.metric("greenhouse_sensors_healthy").value((unsigned long)(sd.sensorsHealthy ? 1 : 0));
+  m.family("greenhouse_sensor_snapshots_total", "counter", "Опубликованные снимки датчиков");
+  m.metric("greenhouse_sensor_snapshots_total").value((unsigned long)(version / 2));
+}
+
+static void metricsActuators(MetricsWriter &m) {
+  SensorData sd = g_sensorStore.snapshot();
+  const bool on[Devices::ACT_COUNT] = { sd.pumpOn, sd.fanOn, sd.lightOn, sd.doorOpen };
+
+  m.family("greenhouse_actuator_on", "gauge", "Исполнитель включён (дверь — открыта)");
+  for (uint8_t i = 0; i < Devices::ACT_COUNT; ++i) {
+    m.metric("greenhouse_actuator_on").label("device", Devices::actuatorName((Devices::ActuatorId)i))
+     .value((unsigned long)(on[i] ? 1 : 0));
+  }
+  m.family("greenhouse_relay_switches_total", "counter", "Переключения исполнителя с загрузки");
+  for (uint8_t i = 0; i < Devices::ACT_COUNT; ++i) {
+    Devices::ActuatorId id = (Devices::ActuatorId)i;
+    m.metric("greenhouse_relay_switches_total").label("device", Devices::actuatorName(id))
+     .value((unsigned long)g_devices.switchCount(id));
+  }
+  m.family("greenhouse_pump_today_seconds", "gauge", "Работа насоса за текущие сутки");
+  m.metric("greenhouse_pump_today_seconds").value(g_devices.pumpMsToday() / 1000.0f, 1);
+  m.family("greenhouse_pump_seconds_total", "counter", "Работа насоса с загрузки");
+  m.metric("greenhouse_pump_seconds_total").value(g_devices.pumpMsTotal() / 1000.0f, 1);
+}
+
+static void metricsAcquisition(MetricsWriter &m) {
+  m.family("greenhouse_sensor_read_errors_total", "counter", "Ошибки опроса датчика");
+  for (uint8_t i = 0; i < Devices::SENSOR_COUNT; ++i) {
+    Devices::SensorId id = (Devices::SensorId)i;
+    m.metric("greenhouse_sensor_read_errors_total").label("sensor", Devices::sensorName(id))
+     .value((unsigned long)g_devices.sensorTiming(id).errors);
+  }
+  m.family("greenhouse_sensor_latency_ms", "gauge", "Последняя задержка опроса датчика");
+  for (uint8_t i = 0; i < Devices::SENSOR_COUNT; ++i) {
+    Devices::SensorId id = (Devices::SensorId)i;
+    m.metric("greenhouse_sensor_latency_ms").label("sensor", Devices::sensorName(id))
+     .value((unsigned long)g_devices.sensorTiming(id).lastLatencyMs);
+  }
+}
+
+static void metricsTelegram(MetricsWriter &m) {
+  const TelegramBotHandler::Stats &t = g_telegram.stats();
+  m.family("greenhouse_telegram_polls_total", "counter", "Запросы long polling getUpdates");
+  m.metric("greenhouse_telegram_polls_total").value((unsigned long)t.polls);
+  m.family("greenhouse_telegram_poll_errors_total", "counter", "Ошибки long polling getUpdates");
+  m.metric("greenhouse_telegram_poll_errors_total").value((unsigned long)t.pollErrors);
+  m.family("greenhouse_telegram_messages_total", "counter", "Принятые сообщения Telegram");
+  m.metric("greenhouse_telegram_messages_total").label("result", "queued").value((unsigned long)(t.received - t.dropped));
+  m.metric("greenhouse_telegram_messages_total").label("result", "dropped").value((unsigned long)t.dropped);
+  m.family("greenhouse_telegram_command_latency_ms", "gauge", "Приём команды → выполнение, последняя");
+  m.metric("greenhouse_telegram_command_latency_ms").value((unsigned long)t.lastLatencyMs);
+}
+
+// TLS-рукопожатия: полные против возобновлённых сессий. Среднее время
+// процессора — cpu_microseconds_total / handshakes_total того же kind
+static const char *const TLS_KIND[2] = { "full", "resumed" };
+
+static void metricsTelegramTls(MetricsWriter &m) {
+  const TelegramBotHandler::Stats &t = g_telegram.stats();
+  m.family("greenhouse_telegram_handshakes_total", "counter", "TLS-рукопожатия Telegram (приём и отправка)");
+  for (uint8_t k = 0; k < 2; ++k) {
+    m.metric("greenhouse_telegram_handshakes_total").label("kind", TLS_KIND[k]).value((unsigned long)t.tls[k].count);
+  }
+  m.family("greenhouse_telegram_handshake_cpu_microseconds_total", "counter", "Время процессора в рукопожатиях");
+  for (uint8_t k = 0; k < 2; ++k) {
+    m.metric("greenhouse_telegram_handshake_cpu_microseconds_total").label("kind", TLS_KIND[k])
+     .value((unsigned long long)t.tls[k].cpuUsTotal);
+  }
+  m.family("greenhouse_telegram_handshake_ms", "gauge", "Длительность TLS-рукопожатия с сетью");
+  for (uint8_t k = 0; k < 2; ++k) {
+    const TelegramBotHandler::Stats::Handshakes &h = t.tls[k];
+    m.metric("greenhouse_telegram_handshake_ms").label("kind", TLS_KIND[k]).label("stat", "last").value((unsigned long)h.lastMs);
+    m.metric("greenhouse_telegram_handshake_ms").label("kind", TLS_KIND[k]).label("stat", "max").value((unsigned long)h.maxMs);
+  }
+  m.family("greenhouse_telegram_tls_failures_total", "counter", "Неудачные TLS-соединения Telegram");
+  m.metric("greenhouse_telegram_tls_failures_total").label("reason", "connect").value((unsigned long)t.tlsFailures);
+  m.metric("greenhouse_telegram_tls_failures_total").label("reason", "pin").value((unsigned long)t.pinFailures);
+}
+
+static void metricsTelegramTlsCost(MetricsWriter &m) {
+  const TelegramBotHandler::Stats &t = g_telegram.stats();
+  m.family("greenhouse_telegram_handshake_cpu_us", "gauge", "Время процессора одного рукопожатия");
+  for (uint8_t k = 0; k < 2; ++k) {
+    const TelegramBotHandler::Stats::Handshakes &h = t.tls[k];
+    m.metric("greenhouse_telegram_handshake_cpu_us").label("kind", TLS_KIND[k]).label("stat", "last").value((unsigned long)h.lastCpuUs);
+    m.metric("greenhouse_telegram_handshake_cpu_us").label("kind", TLS_KIND[k]).label("stat", "max").value((unsigned long)h.maxCpuUs);
+  }
+  m.family("greenhouse_telegram_handshake_heap_peak_bytes", "gauge", "Наибольший расход кучи в рукопожатии");
+  for (uint8_t k = 0; k < 2; ++k) {
+    const TelegramBotHandler::Stats::Handshakes &h = t.tls[k];
+    m.metric("greenhouse_telegram_handshake_heap_peak_bytes").label("kind", TLS_KIND[k]).label("stat", "last")
+     .value((unsigned long)h.lastHeapPeak);
+    m.metric("greenhouse_telegram_handshake_heap_peak_bytes").label("kind", TLS_KIND[k]).label("stat", "max")
+     .value((unsigned long)h.maxHeapPeak);
+  }
+  m.family("greenhouse_telegram_tls_session_heap_bytes", "gauge", "Куча, занятая одним TLS-соединением");
+  m.metric("greenhouse_telegram_tls_session_heap_bytes").value((unsigned long)t.sessionHeapBytes);
+}
+
+static void metricsTelegramErrors(MetricsWriter &m) {
+  const TelegramBotHandler::Stats &t = g_telegram.stats();
+  m.family("greenhouse_telegram_command_errors_total", "counter", "Нераспознанные команды и неверные аргументы");
+  m.metric("greenhouse_telegram_command_errors_total").label("reason", "unknown").value((unsigned long)t.unknownCommands);
+  m.metric("greenhouse_telegram_command_errors_total").label("reason", "arguments").value((unsigned long)t.badArguments);
+  m.family("greenhouse_telegram_commands_total", "counter", "Выполненные команды Telegram (команда или кнопка)");
+}
+
+static void metricsTelegramOutbox(MetricsWriter &m) {
+  const TelegramOutbox::Stats &o = g_telegram.outboxStats();
+  m.family("greenhouse_telegram_outbox_total", "counter", "Очередь исходящих Telegram");
+  m.metric("greenhouse_telegram_outbox_total").label("event", "queued").value((unsigned long)o.queued);
+  m.metric("greenhouse_telegram_outbox_total").label("event", "coalesced").value((unsigned long)o.coalesced);
+  m.metric("greenhouse_telegram_outbox_total").label("event", "dropped").value((unsigned long)o.dropped);
+  m.metric("greenhouse_telegram_outbox_total").label("event", "sent").value((unsigned long)o.sent);
+  m.metric("greenhouse_telegram_outbox_total").label("event", "retried").value((unsigned long)o.retries);
+  m.metric("greenhouse_telegram_outbox_total").label("event", "failed").value((unsigned long)o.failed);
+  m.family("greenhouse_telegram_outbox_pending", "gauge", "Сообщений в очереди исходящих");
+  m.metric("greenhouse_telegram_outbox_pending").value((unsigned long)g_telegram.outboxPending());
+}
+
+// Цена обновления статуса: запросы к API и байты на одно обновление —
+// отношения этих счётчиков
+static void metricsTelegramApi(MetricsWriter &m) {
+  const TelegramBotHandler::Stats &t = g_telegram.stats();
+  m.family("greenhouse_telegram_callbacks_total", "counter", "Нажатия inline-кнопок");
+  m.metric("greenhouse_telegram_callbacks_total").value((unsigned long)t.callbacks);
+  m.family("greenhouse_telegram_status_refresh_total", "counter", "Обновления статуса: на месте, без изменений, новым сообщением");
+  m.metric("greenhouse_telegram_status_refresh_total").label("result", "edited").value((unsigned long)t.statusEdits);
+  m.metric("greenhouse_telegram_status_refresh_total").label("result", "unchanged").value((unsigned long)t.statusUnchanged);
+  m.metric("greenhouse_telegram_status_refresh_total").label("result", "sent").value((unsigned long)t.statusSends);
+  m.family("greenhouse_telegram_api_calls_total", "counter", "Исходящие запросы к Bot API");
+  m.metric("greenhouse_telegram_api_calls_total").label("method", "sendMessage").value((unsigned long)t.apiSends);
+  m.metric("greenhouse_telegram_api_calls_total").label("method", "editMessageText").value((unsigned long)t.apiEdits);
+  m.metric("greenhouse_telegram_api_calls_total").label("method", "answerCallbackQuery").value((unsigned long)t.apiAnswers);
+  m.family("greenhouse_telegram_payload_bytes_total", "counter", "Текст и разметка кнопок в запросах к Bot API");
+  m.metric("greenhouse_telegram_payload_bytes_total").label("kind", "all").value((unsigned long)t.payloadBytes);
+  m.metric("greenhouse_telegram_payload_bytes_total").label("kind", "status").value((unsigned long)t.statusPayloadBytes);
+}
+
+void WebInterface::handleMetrics(AsyncWebServerRequest *req) {
+  // Порции: 9 общих, счётчики маршрутов, команды Telegram, затем по две на подсистему
+  static constexpr uint8_t FIXED_STEPS   = 9;
+  static constexpr uint8_t ROUTE_STEPS   = (MAX_ROUTES + METRICS_ROUTES_PER_STEP - 1) / METRICS_ROUTES_PER_STEP;
+  static constexpr uint8_t COMMAND_STEPS = (TelegramBotHandler::MAX_ROUTES + METRICS_ROUTES_PER_STEP - 1) / METRICS_ROUTES_PER_STEP;
+  static constexpr uint8_t HEAD_STEPS    = FIXED_STEPS + ROUTE_STEPS + COMMAND_STEPS;
+
+  uint8_t         step = 0;
+  Perf::Histogram h;      // копия на обе половины гистограммы
+  uint32_t        cumulative = 0;
+
+  req->send(chunkedResponse<MetricsWriter>(req, "text/plain; version=0.0.4; charset=utf-8",
+    [this, step, h, cumulative](MetricsWriter &m) mutable {
+      switch (step++) {
+        case 0: metricsSystem(m);         return true;
+        case 1: metricsSensors(m);        return true;
+        case 2: metricsActuators(m);      return true;
+        case 3: metricsAcquisition(m);    return true;
+        case 4: metricsTelegram(m);       return true;
+        case 5: metricsTelegramOutbox(m); return true;
+        case 6: metricsTelegramApi(m);    return true;
+        case 7: metricsTelegramTls(m);     return true;
+        case 8: metricsTelegramTlsCost(m); return true;
+        default:
+          break;
+      }
+
+      if (step <= FIXED_STEPS + ROUTE_STEPS) {
+        uint8_t from = (step - 1 - FIXED_STEPS) * METRICS_ROUTES_PER_STEP;
+        if (from == 0) m.family("greenhouse_http_requests_total", "counter", "HTTP-запросы по маршрутам");
+        for (uint8_t i = from; i < routeCount && i < from + METRICS_ROUTES_PER_STEP; ++i) {
+          m.metric("greenhouse_http_requests_total")
+           .label("route", routeStats[i].uri).label("method", routeStats[i].method)
+           .value((unsigned long)routeStats[i].requests);
+        }
+        return true;
+      }
+
+      if (step <= HEAD_STEPS) {
+        uint8_t from = (step - 1 - FIXED_STEPS - ROUTE_STEPS) * METRICS_ROUTES_PER_STEP;
+        if (from == 0) metricsTelegramErrors(m);
+        for (uint8_t i = from; i < g_telegram.commandCount() && i < from + METRICS_ROUTES_PER_STEP; ++i) {
+          m.metric("greenhouse_telegram_commands_total").label("command", g_telegram.commandName(i))
+           .value((unsigned long)g_telegram.commandCalls(i));
+        }
+        return true;
+      }
+
+      // Гистограммы Perf: корзина k — до 2^(k+1) мкс; telegram — задержка
+      // getUpdates, telegram_cmd — выполнение принятых команд
+      static const char *const NAME = "greenhouse_subsystem_duration_microseconds";
+      uint8_t       idx  = step - 1 - HEAD_STEPS;
+      Perf::Channel ch   = (Perf::Channel)(idx / 2);
+      bool          tail = idx % 2;
+
+      if (!tail) {
+        if (ch == 0) m.family(NAME, "histogram", "Время работы подсистемы за вызов");
+        h          = Perf::snapshot(ch);
+        cumulative = 0;
+      }
+      uint8_t from = tail ? METRICS_HIST_SPLIT : 0;
+      uint8_t to   = tail ? Perf::BUCKETS - 1 : METRICS_HIST_SPLIT;
+      for (uint8_t b = from; b < to; ++b) {
+        cumulative += h.buckets[b];
+        m.metric(NAME, "_bucket").label("subsystem", Perf::channelName(ch))
+         .label("le", 2UL << b).value((unsigned long)cumulative);
+      }
+      if (!tail) return true;
+
+      // Последняя корзина открыта сверху — входит только в +Inf
+      cumulative += h.buckets[Perf::BUCKETS - 1];
+      m.metric(NAME, "_bucket").label("subsystem", Perf::channelName(ch)).labelInf("le")
+       .value((unsigned long)cumulative);
+      m.metric(NAME, "_sum").label("subsystem", Perf::channelName(ch)).value((unsigned long long)h.sumUs);
+      m.metric(NAME, "_count").label("subsystem", Perf::channelName(ch)).value((unsigned long)cumulative);
+      return ch + 1 < Perf::CHANNEL_COUNT;
+    }));
+}
+
+// ===== История =====
+// /api/history?from=&to=&step= — unix-секунды; по умолчанию последние сутки.
+// Диапазон читается окнами по HISTORY_POINTS_PER_CHUNK точек: каждое окно —
+// отдельный query() и одна порция ответа (начала блоков закэшированы,
+// ранние файлы не открываются).
+static constexpr uint32_t HISTORY_POINTS_PER_CHUNK = 24;
+static constexpr uint32_t HISTORY_MAX_RANGE_SEC    = 40UL * 86400UL;
+
+static void historyPoint(const HistoryStore::Point &p, void *ctx) {
+  JsonWriter &w = *static_cast<JsonWriter*>(ctx);
+
+  w.beginArray();
+  w.value(p.t);
+  for (uint8_t i = 0; i < HistoryStore::CHANNELS; ++i) {
+    if (p.valid[i]) w.value(p.v[i], 1);
+    else            w.nullValue();
+  }
+  w.value(p.actuators);
+  w.endArray();
+}
+
+void WebInterface::handleHistory(AsyncWebServerRequest *req) {
+  uint32_t now  = (uint32_t)time(nullptr);
+  uint32_t to   = req->hasParam("to")   ? strtoul(req->getParam("to")->value().c_str(),   nullptr, 10) : now;
+  uint32_t from = req->hasParam("from") ? strtoul(req->getParam("from")->value().c_str(), nullptr, 10) : to - 86400UL;
+  uint32_t step = req->hasParam("step") ? strtoul(req->getParam("step")->value().c_str(), nullptr, 10) : 0;
+  if (to > HISTORY_MAX_RANGE_SEC && from < to - HISTORY_MAX_RANGE_SEC) from = to - HISTORY_MAX_RANGE_SEC;
+  if (step == 0) step = (to > from) ? (to - from) / 500 : 60;
+  if (step < 60) step = 60;
+  // Шаг шире диапазона даёт ту же одну точку; без ограничения step * 24
+  // переполняется и окна становятся крошечными
+  if (to >= from && step > to - from + 1) step = to - from + 1;
+
+  // Раньше первой записи журнала читать нечего — начинаем с неё (по сетке step)
+  uint32_t cursor = from;
+  uint32_t oldest = g_history.oldestTime();
+  if (oldest > cursor && oldest <= to) cursor += ((oldest - cursor) / step) * step;
+
+  uint8_t stage = 0;      // 0 — заголовок, 1 — точки, 2 — готово
+
+  req->send(jsonResponse(req, [=](JsonWriter &w) mutable -> bool {
+    if (stage == 0) {
+      w.beginObject();
+      w.field("from", from);
+      w.field("to",   to);
+      w.field("step", step);
+      w.key("columns").beginArray().value("t");
+      for (uint8_t i = 0; i < HistoryStore::CHANNELS; ++i) w.value(Channels::name(i));
+      w.value("actuators").endArray();
+      w.key("points").beginArray();
+      stage = (cursor <= to) ? 1 : 2;
+      return true;
+    }
+    if (stage == 1) {
+      uint64_t span = (uint64_t)step * HISTORY_POINTS_PER_CHUNK;
+      uint32_t last = ((uint64_t)(to - cursor) >= span) ? (uint32_t)(cursor + span - 1) : to;
+
+      g_history.query(cursor, last, step, historyPoint, &w);
+
+      if (last == to) stage = 2;
+      else            cursor = last + 1;
+      return true;
+    }
+    w.endArray().endObject();
+    return false;
+  }));
+}
+
+// ===== Сводки =====
+// /api/rollup?res=1m|15m|1h — min/avg/max/count по корзинам, от старых к новым;
+// одна порция — одно поле одного канала
+void WebInterface::handleRollup(AsyncWebServerRequest *req) {
+  Rollup::Level lv = Rollup::LEVEL_15M;
+  if (req->hasParam("res") && !Rollup::parseLevel(req->getParam("res")->value(), lv)) {
+    req->send(400, "text/plain", "res: 1m | 15m | 1h");
+    return;
+  }
+
+  uint16_t n    = g_rollup.filled(lv);
+  uint8_t  c    = 0;     // канал
+  uint8_t  f    = 0;     // поле: min, avg, max, count
+  bool     head = true;
+
+  req->send(jsonResponse(req, [=](JsonWriter &w) mutable -> bool {
+    static const char *const FIELDS[4] = {"min", "avg", "max", "count"};
+
+    if (head) {
+      w.beginObject();
+      w.field("res", Rollup::levelName(lv));
+      w.field("resolutionSec", g_rollup.resolutionSec(lv));
+      w.field("buckets", n);
+      w.key("channels").beginObject();
+      head = false;
+      return true;
+    }
+
+    if (f == 0) w.key(Channels::name(c)).beginObject();
+    w.key(FIELDS[f]).beginArray();
+    for (uint16_t i = 0; i < n; ++i) {
+      Rollup::Stat st;
+      g_rollup.bucket(lv, c, n - 1 - i, st);
+      if (f == 3)              w.value(st.count);
+      else if (st.count == 0)  w.nullValue();
+      else                     w.value(f == 0 ? st.min : f == 1 ? st.avg : st.max, 1);
+    }
+    w.endArray();
+
+    if (++f == 4) {
+      f = 0;
+      w.endObject();
+      if (++c == Channels::COUNT) {
+        w.endObject().endObject();
+        return false;
+      }
+    }
+    return true;
+  }));
+}
@@ -7,40 +7,103 @@
 #include "Automation.h"
 #include "EEPROMManager.h"
 #include "Profiles.h"
+#include "JsonWriter.h"
 
 #include <WiFi.h>
-#include <WebServer.h>
+#include <AsyncTCP.h>
+#include <ESPAsyncWebServer.h>
 
+// Асинхронный HTTP-сервер (ESPAsyncWebServer): обработчики выполняются
+// в задаче async_tcp, несколько соединений и keep-alive одновременно,
+// отправка не блокирует. loop() в задаче web рассылает /api/stream и
+// собирает результаты скана Wi-Fi.
 class WebInterface {
 public:
   void begin();
   void loop();
 
 private:
-  WebServer server{80};
+  AsyncWebServer   server{80};
+  AsyncEventSource events{"/api/stream"};
 
-  void setupWiFi();
+  // Последнее разосланное по /api/stream состояние
+  struct StreamState {
+    SensorData    data;
+    uint32_t      version    = 0;
+    bool          automation = false;
+    bool          primed     = false;
+    volatile bool resync     = false;   // подключился клиент — разослать полное состояние
+    unsigned long lastBeatMs = 0;
+  };
+  StreamState stream;
+
+  // Кэш скана Wi-Fi: уникальные SSID с лучшим RSSI, по убыванию RSSI.
+  // Заполняет loop() (scanLoop), читает обработчик — под scanMux.
+  struct ScanEntry {
+    char   ssid[33];
+    int8_t rssi;
+    bool   secure;
+  };
+  struct ScanCache {
+    ScanEntry     nets[Constants::WIFI_SCAN_MAX];
+    uint8_t       count   = 0;
+    bool          valid   = false;
+    unsigned long takenMs = 0;
+  };
+  ScanCache    scan;
+  portMUX_TYPE scanMux = portMUX_INITIALIZER_UNLOCKED;
+
+  typedef void (WebInterface::*Handler)(AsyncWebServerRequest *req);
+  typedef void (WebInterface::*BodyHandler)(AsyncWebServerRequest *req, const char *body, size_t len);
+
+  static constexpr size_t MAX_BODY = 1024;
+
+  // Счётчики запросов по маршрутам (для /metrics); меняются только в async_tcp
+  struct RouteStat {
+    const char *uri;
+    const char *method;
+    uint32_t    requests;
+  };
+  static constexpr uint8_t MAX_ROUTES = 24;
+  RouteStat routeStats[MAX_ROUTES];
+  uint8_t   routeCount = 0;
+
+  uint8_t addRouteStat(const char *uri, const char *method);
+
+  // Маршрут с BASIC-авторизацией и замером Perf::WEB
+  void route(const char *uri, WebRequestMethodComposite method, Handler h);
+  // POST с JSON-телом (до MAX_BODY байт)
+  void routeBody(const char *uri, BodyHandler h);
+
+  void streamLoop();
+  void scanLoop();
 
   // страницы
-  void handleRoot();
-  void handleNotFound();
+  void handleRoot(AsyncWebServerRequest *req);
+  void handleNotFound(AsyncWebServerRequest *req);
 
   // API
-  void handleSensors();
-  void handleSettingsGet();
-  void handleSettingsPost();
-  void handleControl();
-  void handleDiagnosticsApi();
-  void handleWifiScan();
-  void handleWifiSet();
-
-  // JSON
-  String buildSensorsJson();
-  String buildSettingsJson();
-  String buildDiagnosticsJson();
+  void handleSensors(AsyncWebServerRequest *req);
+  void handleSensorsBin(AsyncWebServerRequest *req);
+  void handleSettingsGet(AsyncWebServerRequest *req);
+  void handleSettingsPost(AsyncWebServerRequest *req, const char *body, size_t len);
+  void handleControl(AsyncWebServerRequest *req, const char *body, size_t len);
+  void handleScenesGet(AsyncWebServerRequest *req);
+  void handleScenesPost(AsyncWebServerRequest *req, const char *body, size_t len);
+  void handleDiagnosticsApi(AsyncWebServerRequest *req);
+  void handleWifiScan(AsyncWebServerRequest *req);
+  void handleWifiSet(AsyncWebServerRequest *req, const char *body, size_t len);
+  void handlePerf(AsyncWebServerRequest *req);
+  void handleMetrics(AsyncWebServerRequest *req);
+  void handleHistory(AsyncWebServerRequest *req);
+  void handleRollup(AsyncWebServerRequest *req);
+
+  // JSON (JsonWriter)
+  bool writeSensors(JsonWriter &w, const SensorData &sd, uint32_t version,
+                    bool automation, const StreamState *prev);
 
   // простая BASIC-авторизация
-  bool ensureAuth();
+  bool ensureAuth(AsyncWebServerRequest *req);
 
   static constexpr const char* WEB_USER = "admin";
   static constexpr const char* WEB_PASS = "greenhouse";
@@ -48,4 +111,4 @@ private:
 
 extern WebInterface g_web;
 
-#endif // WEB_INTERFACE_H
\ No newline at end of file
+#endif // WEB_INTERFACE_H
@@ -0,0 +1,141 @@
+// WifiManager.cpp
+#include "WifiManager.h"
+
+WifiManager g_wifi;
+
+static constexpr const char *AP_SSID = "YotikM2-Setup";
+static constexpr const char *AP_PASS = "YotikM2pass";
+
+void WifiManager::begin() {
+  WiFi.persistent(false);         // SSID/пароль храним сами (EEPROM)
+  WiFi.setAutoReconnect(false);   // переподключением управляет loop()
+  WiFi.onEvent(onEvent);
+
+  WiFi.mode(WIFI_STA);
+  startAttempt(millis());
+}
+
+void WifiManager::onEvent(arduino_event_id_t event, arduino_event_info_t info) {
+  (void)info;
+  switch (event) {
+    case ARDUINO_EVENT_WIFI_STA_GOT_IP:
+      g_wifi.gotIp = true;
+      break;
+    case ARDUINO_EVENT_WIFI_STA_DISCONNECTED:
+    case ARDUINO_EVENT_WIFI_STA_LOST_IP:
+      g_wifi.lostLink = true;
+      break;
+    default:
+      break;
+  }
+}
+
+void WifiManager::startAttempt(unsigned long now) {
+  Serial.printf("📶 Подключаемся к Wi-Fi \"%s\" (попытка %u)\n",
+                g_settings.wifiSSID, (unsigned)failedAttempts + 1);
+  gotIp          = false;
+  lostLink       = false;
+  attemptStartMs = now;
+  state          = CONNECTING;
+  WiFi.begin(g_settings.wifiSSID, g_settings.wifiPassword);
+}
+
+void WifiManager::scheduleRetry(unsigned long now) {
+  failedAttempts++;
+
+  unsigned long backoff = Constants::WIFI_BACKOFF_MIN_MS;
+  for (uint16_t i = 1; i < failedAttempts && backoff < Constants::WIFI_BACKOFF_MAX_MS; ++i) {
+    backoff *= 2;
+  }
+  if (backoff > Constants::WIFI_BACKOFF_MAX_MS) backoff = Constants::WIFI_BACKOFF_MAX_MS;
+
+  retryAtMs = now + backoff;
+  state     = WAIT_RETRY;
+  WiFi.disconnect(false);
+
+  Serial.printf("⚠️ Wi-Fi: нет связи, повтор через %lu с\n", backoff / 1000);
+  if (!apOn && (!everConnected || failedAttempts >= Constants::WIFI_AP_AFTER_FAILS)) startAp();
+}
+
+void WifiManager::startAp() {
+  WiFi.mode(WIFI_AP_STA);
+  WiFi.softAP(AP_SSID, AP_PASS);
+  apOn = true;
+  Serial.print(F("📡 Точка доступа для настройки, IP: "));
+  Serial.println(WiFi.softAPIP());
+}
+
+void WifiManager::stopAp() {
+  WiFi.softAPdisconnect(true);
+  WiFi.mode(WIFI_STA);
+  apOn = false;
+  Serial.println(F("📡 Точка доступа выключена"));
+}
+
+void WifiManager::reconnect() {
+  reconfigureAtMs    = millis() + RECONFIGURE_DELAY_MS;
+  reconfigurePending = true;
+}
+
+void WifiManager::loop() {
+  unsigned long now = millis();
+
+  if (reconfigurePending && (long)(now - reconfigureAtMs) >= 0) {
+    reconfigurePending = false;
+    failedAttempts     = 0;
+    WiFi.disconnect(false);
+    startAttempt(now);
+    return;
+  }
+
+  switch (state) {
+    case IDLE:
+      break;
+
+    case CONNECTING:
+      if (gotIp) {
+        state          = CONNECTED;
+        connectedAtMs  = now;
+        failedAttempts = 0;
+        everConnected  = true;
+        lostLink       = false;   // отголосок disconnect() перед попыткой
+        Serial.print(F("✅ Wi-Fi STA IP: "));
+        Serial.println(WiFi.localIP());
+        if (connectedCb) connectedCb();
+      } else if (now - attemptStartMs >= Constants::WIFI_CONNECT_TIMEOUT_MS) {
+        scheduleRetry(now);
+      }
+      break;
+
+    case CONNECTED:
+      if (lostLink) {
+        // Первая повторная попытка — сразу после минимальной паузы
+        Serial.println(F("⚠️ Wi-Fi: соединение потеряно"));
+        failedAttempts = 0;
+        scheduleRetry(now);
+      } else if (apOn && now - connectedAtMs >= Constants::WIFI_AP_LINGER_MS) {
+        stopAp();
+      }
+      break;
+
+    case WAIT_RETRY:
+      if ((long)(now - retryAtMs) >= 0) startAttempt(now);
+      break;
+  }
+}
+
+unsigned long WifiManager::retryInMs() const {
+  if (state != WAIT_RETRY) return 0;
+  long left = (long)(retryAtMs - millis());
+  return left > 0 ? (unsigned long)left : 0;
+}
+
+const char *WifiManager::stateName(State s) {
+  switch (s) {
+    case IDLE:       return "idle";
+    case CONNECTING: return "connecting";
+    case CONNECTED:  return "connected";
+    case WAIT_RETRY: return "wait_retry";
+  }
+  return "?";
+}
@@ -0,0 +1,69 @@
+// WifiManager.h
+#ifndef WIFI_MANAGER_H
+#define WIFI_MANAGER_H
+
+#include "Config.h"
+#include <WiFi.h>
+
+// Неблокирующее подключение к Wi-Fi: begin() только запускает попытку,
+// дальше всё делает loop() в задаче web по событиям стека Wi-Fi.
+//  - нет связи за WIFI_CONNECT_TIMEOUT_MS — повтор с экспоненциальной
+//    паузой (WIFI_BACKOFF_MIN_MS…WIFI_BACKOFF_MAX_MS);
+//  - если связи ещё не было (или она пропала на WIFI_AP_AFTER_FAILS попыток),
+//    поднимается точка доступа для настройки (AP+STA), STA продолжает
+//    переподключаться; после подключения AP гаснет через
+//    WIFI_AP_LINGER_MS, чтобы страница настройки успела получить ответ;
+//  - при восстановлении связи вызывается onConnected (Telegram и т.п.).
+class WifiManager {
+public:
+  enum State : uint8_t { IDLE = 0, CONNECTING, CONNECTED, WAIT_RETRY };
+
+  typedef void (*Callback)();
+
+  void begin();
+  void loop();
+
+  // Новые SSID/пароль уже в g_settings — переподключиться из loop(),
+  // выждав RECONFIGURE_DELAY_MS, чтобы ответ на запрос успел уйти
+  void reconnect();
+
+  void onConnected(Callback cb) { connectedCb = cb; }
+
+  bool          connected() const   { return state == CONNECTED; }
+  bool          apActive() const    { return apOn; }
+  State         currentState() const { return state; }
+  uint16_t      attempts() const    { return failedAttempts; }
+  unsigned long retryInMs() const;
+  static const char *stateName(State s);
+
+private:
+  volatile State state         = IDLE;
+  bool           apOn          = false;
+  bool           everConnected = false;
+
+  uint16_t      failedAttempts = 0;
+  unsigned long attemptStartMs  = 0;
+  unsigned long retryAtMs       = 0;
+  unsigned long connectedAtMs   = 0;
+  unsigned long reconfigureAtMs = 0;
+
+  static constexpr unsigned long RECONFIGURE_DELAY_MS = 300;
+
+  // Флаги из обработчика событий Wi-Fi (другая задача)
+  volatile bool gotIp              = false;
+  volatile bool lostLink           = false;
+  volatile bool reconfigurePending = false;
+
+  Callback connectedCb = nullptr;
+
+  void startAttempt(unsigned long now);
+  void scheduleRetry(unsigned long now);
+  void startAp();
+  void stopAp();
+
+  static void onEvent(arduino_event_id_t event, arduino_event_info_t info);
+};
+
+extern WifiManager g_wifi;
+
+#endif // WIFI_MANAGER_H
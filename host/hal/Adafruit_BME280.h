@@ -0,0 +1,24 @@
+// Adafruit_BME280.h (host)
+#ifndef HOST_ADAFRUIT_BME280_H
+#define HOST_ADAFRUIT_BME280_H
+
+#include <Wire.h>
+
+class Adafruit_BME280 {
+public:
+  enum sensor_mode      { MODE_SLEEP = 0, MODE_FORCED = 1, MODE_NORMAL = 3 };
+  enum sensor_sampling  { SAMPLING_NONE = 0, SAMPLING_X1, SAMPLING_X2, SAMPLING_X4, SAMPLING_X8, SAMPLING_X16 };
+  enum sensor_filter    { FILTER_OFF = 0, FILTER_X2, FILTER_X4, FILTER_X8, FILTER_X16 };
+  enum standby_duration { STANDBY_MS_0_5 = 0 };
+
+  bool  begin(uint8_t addr = 0x77, TwoWire *bus = nullptr);
+  void  setSampling(sensor_mode mode = MODE_NORMAL,
+                    sensor_sampling t = SAMPLING_X16, sensor_sampling p = SAMPLING_X16,
+                    sensor_sampling h = SAMPLING_X16, sensor_filter f = FILTER_OFF,
+                    standby_duration sb = STANDBY_MS_0_5);
+  float readTemperature();
+  float readHumidity();
+  float readPressure();    // Па
+};
+
+#endif // HOST_ADAFRUIT_BME280_H
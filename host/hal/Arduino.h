@@ -0,0 +1,75 @@
+// Arduino.h (host)
+// Минимальная замена ядра Arduino для сборки чистых модулей прошивки на
+// Linux: время — часы симуляции (HostHal), пины и АЦП — модель в HostHal.
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <math.h>
+#include <time.h>
+#include <algorithm>
+#include <cmath>
+
+#include "freertos/FreeRTOS.h"
+
+using std::isnan;
+using std::isinf;
+using std::min;
+using std::max;
+
+#define PROGMEM
+#define F(s) (s)
+
+#define HIGH   1
+#define LOW    0
+#define INPUT  0
+#define OUTPUT 1
+
+unsigned long millis();
+unsigned long micros();
+void          delay(unsigned long ms);
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int  digitalRead(uint8_t pin);
+int  analogRead(uint8_t pin);
+
+bool getLocalTime(struct tm *info, uint32_t ms = 5000);
+
+template <class T, class L, class H>
+inline T constrain(T x, L lo, H hi) { return x < lo ? lo : (x > hi ? hi : x); }
+
+// newlib ESP32 даёт strlcpy, glibc — только с 2.38
+#if defined(__GLIBC__) && (__GLIBC__ < 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ < 38))
+inline size_t strlcpy(char *dst, const char *src, size_t size) {
+  size_t len = strlen(src);
+  if (size) {
+    size_t n = len < size - 1 ? len : size - 1;
+    memcpy(dst, src, n);
+    dst[n] = '\0';
+  }
+  return len;
+}
+#endif
+
+// Serial: вывод в stdout только при HostHal::setVerbose(true)
+class HardwareSerial {
+public:
+  void   begin(unsigned long) {}
+  size_t print(const char *s);
+  size_t print(long v);
+  size_t print(double v, int digits = 2);
+  size_t println(const char *s = "");
+  size_t println(long v);
+  size_t println(double v, int digits = 2);
+  int    printf(const char *fmt, ...) __attribute__((format(printf, 2, 3)));
+};
+
+extern HardwareSerial Serial;
+
+#endif // HOST_ARDUINO_H
@@ -0,0 +1,25 @@
+// BH1750.h (host)
+#ifndef HOST_BH1750_H
+#define HOST_BH1750_H
+
+#include <Wire.h>
+
+class BH1750 {
+public:
+  enum Mode : uint8_t {
+    UNCONFIGURED             = 0,
+    CONTINUOUS_HIGH_RES_MODE = 0x10,
+    ONE_TIME_HIGH_RES_MODE   = 0x20,
+  };
+
+  explicit BH1750(uint8_t addr = 0x23) : address(addr) {}
+
+  bool  begin(Mode mode = CONTINUOUS_HIGH_RES_MODE, uint8_t addr = 0x23, TwoWire *bus = nullptr);
+  bool  configure(Mode mode);
+  float readLightLevel();
+
+private:
+  uint8_t address;
+};
+
+#endif // HOST_BH1750_H
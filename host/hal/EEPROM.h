@@ -0,0 +1,9 @@
+// EEPROM.h (host)
+// Прошивочные модули, попадающие в хост-сборку, EEPROM не трогают —
+// заголовок нужен только для цепочки #include через EEPROMManager.h.
+#ifndef HOST_EEPROM_H
+#define HOST_EEPROM_H
+
+#include <Arduino.h>
+
+#endif // HOST_EEPROM_H
@@ -0,0 +1,14 @@
+// ESP32Servo.h (host)
+#ifndef HOST_ESP32_SERVO_H
+#define HOST_ESP32_SERVO_H
+
+#include <Arduino.h>
+
+class Servo {
+public:
+  int  attach(int pin, int minUs = 544, int maxUs = 2400);
+  void write(int angle);
+  void detach() {}
+};
+
+#endif // HOST_ESP32_SERVO_H
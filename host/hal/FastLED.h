@@ -0,0 +1,29 @@
+// FastLED.h (host)
+#ifndef HOST_FASTLED_H
+#define HOST_FASTLED_H
+
+#include <Arduino.h>
+
+struct CRGB {
+  uint8_t r = 0, g = 0, b = 0;
+  CRGB() = default;
+  CRGB(uint8_t r_, uint8_t g_, uint8_t b_) : r(r_), g(g_), b(b_) {}
+};
+
+enum EOrder : uint8_t { RGB = 0, GRB };
+
+template <uint8_t DATA_PIN, EOrder ORDER> class WS2812B {};
+
+class CFastLED {
+public:
+  template <template <uint8_t, EOrder> class CHIPSET, uint8_t DATA_PIN, EOrder ORDER>
+  void addLeds(CRGB *leds, int count) { (void)leds; (void)count; }
+
+  void clear(bool write = false) { (void)write; }
+  void show() {}
+  void setBrightness(uint8_t b) { (void)b; }
+};
+
+extern CFastLED FastLED;
+
+#endif // HOST_FASTLED_H
@@ -0,0 +1,281 @@
+// HostHal.cpp
+#include "HostHal.h"
+#include <esp_timer.h>
+#include <Wire.h>
+#include <BH1750.h>
+#include <Adafruit_BME280.h>
+#include <ESP32Servo.h>
+#include <FastLED.h>
+
+HardwareSerial Serial;
+TwoWire        Wire;
+CFastLED       FastLED;
+
+namespace {
+  constexpr uint8_t BH1750_ADDR = 0x23;
+  constexpr uint8_t BME280_ADDR = 0x76;
+  constexpr uint8_t MAX_PINS    = 40;
+  constexpr uint8_t MAX_TIMERS  = 8;
+
+  HostHal::Inputs g_inputs;
+  uint64_t        g_nowUs      = 0;
+  time_t          g_localStart = 0;
+  uint32_t        g_rng        = 1;
+  bool            g_verbose    = false;
+  bool            g_pins[MAX_PINS];
+  uint8_t         g_servoAngle = 0;
+  uint16_t        g_bhResult   = 0;   // защёлкнутый результат одиночного измерения
+}
+
+// ===== Таймеры esp_timer =====
+struct esp_timer {
+  esp_timer_cb_t callback = nullptr;
+  void          *arg      = nullptr;
+  uint64_t       periodUs = 0;
+  uint64_t       nextUs   = 0;
+  bool           running  = false;
+};
+
+static esp_timer g_timers[MAX_TIMERS];
+static uint8_t   g_timerCount = 0;
+
+esp_err_t esp_timer_create(const esp_timer_create_args_t *args, esp_timer_handle_t *out) {
+  if (g_timerCount >= MAX_TIMERS || !args || !args->callback) return ESP_FAIL;
+  esp_timer &t = g_timers[g_timerCount++];
+  t          = esp_timer();
+  t.callback = args->callback;
+  t.arg      = args->arg;
+  *out       = &t;
+  return ESP_OK;
+}
+
+esp_err_t esp_timer_start_periodic(esp_timer_handle_t timer, uint64_t periodUs) {
+  if (!timer || periodUs == 0) return ESP_FAIL;
+  timer->periodUs = periodUs;
+  timer->nextUs   = g_nowUs + periodUs;
+  timer->running  = true;
+  return ESP_OK;
+}
+
+esp_err_t esp_timer_stop(esp_timer_handle_t timer) {
+  if (!timer) return ESP_FAIL;
+  timer->running = false;
+  return ESP_OK;
+}
+
+int64_t esp_timer_get_time() {
+  return (int64_t)g_nowUs;
+}
+
+// ===== Часы =====
+unsigned long millis() { return (unsigned long)(g_nowUs / 1000); }
+unsigned long micros() { return (unsigned long)g_nowUs; }
+
+void delay(unsigned long ms) {
+  HostHal::advance((uint64_t)ms * 1000);
+}
+
+bool getLocalTime(struct tm *info, uint32_t ms) {
+  (void)ms;
+  time_t t = g_localStart + (time_t)(g_nowUs / 1000000);
+  gmtime_r(&t, info);   // g_localStart уже в местном времени
+  return true;
+}
+
+// ===== Пины и АЦП =====
+void pinMode(uint8_t pin, uint8_t mode) {
+  (void)pin;
+  (void)mode;
+}
+
+void digitalWrite(uint8_t pin, uint8_t val) {
+  if (pin < MAX_PINS) g_pins[pin] = val != LOW;
+}
+
+int digitalRead(uint8_t pin) {
+  return pin < MAX_PINS && g_pins[pin] ? HIGH : LOW;
+}
+
+// xorshift32: воспроизводимый шум при одинаковом seed
+static float uniform01() {
+  g_rng ^= g_rng << 13;
+  g_rng ^= g_rng >> 17;
+  g_rng ^= g_rng << 5;
+  return (g_rng >> 8) * (1.0f / 16777216.0f);
+}
+
+// Приближённо нормальный шум (сумма четырёх равномерных, СКО 1): АЦП
+// читается миллионы раз за прогон, logf/cosf Бокса — Мюллера заметно дороже
+static float gaussian() {
+  float sum = uniform01() + uniform01() + uniform01() + uniform01();
+  return (sum - 2.0f) * 1.7320508f;
+}
+
+int analogRead(uint8_t pin) {
+  (void)pin;
+  float v = g_inputs.soilAdc + g_inputs.soilAdcNoise * gaussian();
+  return (int)constrain(lroundf(v), 0L, 4095L);
+}
+
+// ===== Serial =====
+size_t HardwareSerial::print(const char *s) {
+  return g_verbose ? (size_t)fputs(s, stdout) : 0;
+}
+
+size_t HardwareSerial::print(long v) {
+  return g_verbose ? (size_t)::printf("%ld", v) : 0;
+}
+
+size_t HardwareSerial::print(double v, int digits) {
+  return g_verbose ? (size_t)::printf("%.*f", digits, v) : 0;
+}
+
+size_t HardwareSerial::println(const char *s) {
+  return g_verbose ? (size_t)::printf("%s\n", s) : 0;
+}
+
+size_t HardwareSerial::println(long v) {
+  return g_verbose ? (size_t)::printf("%ld\n", v) : 0;
+}
+
+size_t HardwareSerial::println(double v, int digits) {
+  return g_verbose ? (size_t)::printf("%.*f\n", digits, v) : 0;
+}
+
+int HardwareSerial::printf(const char *fmt, ...) {
+  if (!g_verbose) return 0;
+  va_list ap;
+  va_start(ap, fmt);
+  int n = vprintf(fmt, ap);
+  va_end(ap);
+  return n;
+}
+
+// ===== I2C =====
+bool TwoWire::begin(int sda, int scl, uint32_t freq) {
+  (void)sda;
+  (void)scl;
+  (void)freq;
+  return true;
+}
+
+void TwoWire::beginTransmission(uint8_t addr) {
+  txAddr = addr;
+  txLen  = 0;
+}
+
+size_t TwoWire::write(uint8_t b) {
+  if (txLen >= sizeof(txBuf)) return 0;
+  txBuf[txLen++] = b;
+  return 1;
+}
+
+uint8_t TwoWire::endTransmission(bool stop) {
+  (void)stop;
+  if (txAddr == BH1750_ADDR) {
+    // Одиночное измерение: результат — освещённость на момент запуска
+    if (txLen == 1 && (txBuf[0] & 0xF0) == 0x20) {
+      float counts = g_inputs.lightLux * 1.2f;
+      g_bhResult   = (uint16_t)constrain(lroundf(counts), 0L, 65535L);
+    }
+    return 0;
+  }
+  return txAddr == BME280_ADDR ? 0 : 2;
+}
+
+uint8_t TwoWire::requestFrom(uint8_t addr, uint8_t len) {
+  rxLen = rxPos = 0;
+  if (addr != BH1750_ADDR || len != 2) return 0;
+  rxBuf[0] = g_bhResult >> 8;
+  rxBuf[1] = g_bhResult & 0xFF;
+  rxLen    = 2;
+  return rxLen;
+}
+
+int TwoWire::read() {
+  return rxPos < rxLen ? rxBuf[rxPos++] : -1;
+}
+
+// ===== Датчики и исполнители =====
+bool BH1750::begin(Mode mode, uint8_t addr, TwoWire *bus) {
+  (void)bus;
+  address = addr;
+  return configure(mode);
+}
+
+bool BH1750::configure(Mode mode) {
+  Wire.beginTransmission(address);
+  Wire.write(mode);
+  return Wire.endTransmission() == 0;
+}
+
+float BH1750::readLightLevel() {
+  if (Wire.requestFrom(address, (uint8_t)2) != 2) return -1.0f;
+  uint16_t raw = (uint16_t)Wire.read() << 8;
+  raw |= (uint8_t)Wire.read();
+  return raw / 1.2f;
+}
+
+bool Adafruit_BME280::begin(uint8_t addr, TwoWire *bus) {
+  (void)bus;
+  return addr == BME280_ADDR;
+}
+
+void Adafruit_BME280::setSampling(sensor_mode, sensor_sampling, sensor_sampling,
+                                  sensor_sampling, sensor_filter, standby_duration) {}
+
+float Adafruit_BME280::readTemperature() { return g_inputs.airTemperature; }
+float Adafruit_BME280::readHumidity()    { return g_inputs.airHumidity; }
+float Adafruit_BME280::readPressure()    { return g_inputs.airPressure * 100.0f; }
+
+int Servo::attach(int pin, int minUs, int maxUs) {
+  (void)minUs;
+  (void)maxUs;
+  return pin;
+}
+
+void Servo::write(int angle) {
+  g_servoAngle = (uint8_t)constrain(angle, 0, 180);
+}
+
+// ===== Управление симуляцией =====
+namespace HostHal {
+
+Inputs &inputs() { return g_inputs; }
+
+void reset(time_t localStart, uint32_t seed) {
+  g_inputs     = Inputs();
+  g_nowUs      = 0;
+  g_localStart = localStart;
+  g_rng        = seed ? seed : 1;
+  g_servoAngle = 0;
+  g_bhResult   = 0;
+  g_timerCount = 0;
+  memset(g_pins, 0, sizeof(g_pins));
+}
+
+uint64_t nowUs() { return g_nowUs; }
+
+void advance(uint64_t us) {
+  uint64_t target = g_nowUs + us;
+  for (;;) {
+    // Ближайший таймер в пределах шага
+    esp_timer *next = nullptr;
+    for (uint8_t i = 0; i < g_timerCount; ++i) {
+      esp_timer &t = g_timers[i];
+      if (t.running && t.nextUs <= target && (!next || t.nextUs < next->nextUs)) next = &t;
+    }
+    if (!next) break;
+
+    g_nowUs       = next->nextUs;
+    next->nextUs += next->periodUs;
+    next->callback(next->arg);
+  }
+  g_nowUs = target;
+}
+
+bool    pinState(uint8_t pin) { return pin < MAX_PINS && g_pins[pin]; }
+uint8_t servoAngle()          { return g_servoAngle; }
+void    setVerbose(bool on)   { g_verbose = on; }
+
+} // namespace HostHal
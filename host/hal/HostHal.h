@@ -0,0 +1,33 @@
+// HostHal.h
+#ifndef HOST_HAL_H
+#define HOST_HAL_H
+
+#include <Arduino.h>
+
+// Управление заглушками железа со стороны симулятора и тестов.
+// Часы идут только по advance(): millis(), micros(), esp_timer_get_time()
+// и getLocalTime() показывают время симуляции.
+namespace HostHal {
+  // То, что «видят» датчики; задаёт модель теплицы
+  struct Inputs {
+    float airTemperature = 22.0f;    // °C, BME280
+    float airHumidity    = 50.0f;    // %, BME280
+    float airPressure    = 1013.0f;  // гПа, BME280
+    float lightLux       = 0.0f;     // BH1750
+    float soilAdc        = 2400.0f;  // отсчёты АЦП датчика почвы
+    float soilAdcNoise   = 0.0f;     // СКО шума одного отсчёта
+  };
+
+  Inputs &inputs();
+
+  void     reset(time_t localStart, uint32_t seed);
+  uint64_t nowUs();
+  // Сдвинуть часы на us, по пути срабатывают таймеры esp_timer
+  void     advance(uint64_t us);
+
+  bool    pinState(uint8_t pin);     // последнее digitalWrite
+  uint8_t servoAngle();
+  void    setVerbose(bool on);
+}
+
+#endif // HOST_HAL_H
@@ -0,0 +1,30 @@
+// Wire.h (host)
+// I2C-шина с двумя устройствами: BH1750 (0x23) и BME280 (0x76).
+#ifndef HOST_WIRE_H
+#define HOST_WIRE_H
+
+#include <Arduino.h>
+
+class TwoWire {
+public:
+  bool    begin(int sda = -1, int scl = -1, uint32_t freq = 0);
+  void    setClock(uint32_t hz) { (void)hz; }
+  void    beginTransmission(uint8_t addr);
+  size_t  write(uint8_t b);
+  uint8_t endTransmission(bool stop = true);   // 0 — ACK, 2 — нет устройства
+  uint8_t requestFrom(uint8_t addr, uint8_t len);
+  int     available() const { return rxLen - rxPos; }
+  int     read();
+
+private:
+  uint8_t txAddr = 0;
+  uint8_t txBuf[8];
+  uint8_t txLen  = 0;
+  uint8_t rxBuf[8];
+  uint8_t rxLen  = 0;
+  uint8_t rxPos  = 0;
+};
+
+extern TwoWire Wire;
+
+#endif // HOST_WIRE_H
@@ -0,0 +1,30 @@
+// esp_timer.h (host)
+// Периодические таймеры срабатывают, когда HostHal двигает часы симуляции.
+#ifndef HOST_ESP_TIMER_H
+#define HOST_ESP_TIMER_H
+
+#include <stdint.h>
+
+typedef int esp_err_t;
+#define ESP_OK   0
+#define ESP_FAIL (-1)
+
+typedef struct esp_timer *esp_timer_handle_t;
+typedef void (*esp_timer_cb_t)(void *arg);
+
+typedef enum { ESP_TIMER_TASK = 0 } esp_timer_dispatch_t;
+
+typedef struct {
+  esp_timer_cb_t       callback;
+  void                *arg;
+  esp_timer_dispatch_t dispatch_method;
+  const char          *name;
+  bool                 skip_unhandled_events;
+} esp_timer_create_args_t;
+
+esp_err_t esp_timer_create(const esp_timer_create_args_t *args, esp_timer_handle_t *out);
+esp_err_t esp_timer_start_periodic(esp_timer_handle_t timer, uint64_t periodUs);
+esp_err_t esp_timer_stop(esp_timer_handle_t timer);
+int64_t   esp_timer_get_time();
+
+#endif // HOST_ESP_TIMER_H
@@ -0,0 +1,13 @@
+// freertos/task.h (host)
+#ifndef HOST_FREERTOS_TASK_H
+#define HOST_FREERTOS_TASK_H
+
+#include "FreeRTOS.h"
+
+typedef void *TaskHandle_t;
+
+inline TaskHandle_t xTaskGetCurrentTaskHandle() { return nullptr; }
+inline uint32_t     ulTaskNotifyTake(BaseType_t, TickType_t) { return 0; }
+inline void         xTaskNotifyGive(TaskHandle_t) {}
+
+#endif // HOST_FREERTOS_TASK_H
@@ -0,0 +1,243 @@
+// GreenhouseSim.cpp
+// Симулятор теплицы: настоящие Automation, Profiles и исполнители Devices
+// (насос, дверь, реле) против модели Plant и заглушек HostHal.
+// Задачи планировщика — те же, что в SmartGreenhouse.ino; часы двигаются
+// скачком до ближайшего дедлайна, поэтому недели проходят за секунды.
+//
+//   greenhouse_sim [--days N] [--profile 0..4] [--mode 0..2] [--seed S]
+//                  [--season summer|autumn] [--verbose]
+//
+// Без --mode прогоняются все три climateMode с одинаковой погодой.
+// autumn — короткий пасмурный день: проверяется, что досветка
+// (Automation::handleLighting) включалась, иначе код выхода 1.
+#include "Automation.h"
+#include "Devices.h"
+#include "Profiles.h"
+#include "Scheduler.h"
+#include "Perf.h"
+#include "Plant.h"
+#include <HostHal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+  constexpr float    PLANT_STEP_S = 1.0f;
+  constexpr time_t   START_LOCAL  = 1780272000;   // 2026-06-01 00:00, местное
+  const char *const  MODE_NAMES[Automation::CLIMATE_MODES] = { "eco", "normal", "aggressive" };
+
+  struct Options {
+    uint32_t      days    = 14;
+    uint8_t       profile = 1;
+    int           mode    = -1;    // -1 — все
+    uint32_t      seed    = 1;
+    Plant::Season season  = Plant::SUMMER;
+    bool          verbose = false;
+  };
+
+  // Истинное время вне комфорта по модели (а не по датчикам), часы
+  struct Comfort {
+    double hot = 0, cold = 0, humid = 0, dry = 0, out = 0;
+    double soilLow = 0;       // почва ниже setpoint − hysteresis
+  };
+
+  Plant   g_plant;
+  Comfort g_comfort;
+  double  g_pendingS = 0;     // накоплено до шага модели
+  double  g_pumpS    = 0;
+
+  Plant::Actuators readActuators() {
+    Plant::Actuators a;
+    bool high = RelayLogic::ACTIVE_HIGH;
+    a.pump     = HostHal::pinState(Pins::RELAY_PUMP)  == high;
+    a.fan      = HostHal::pinState(Pins::RELAY_FAN)   == high;
+    a.light    = HostHal::pinState(Pins::RELAY_LIGHT) == high;
+    a.doorFrac = HostHal::servoAngle() / (float)Constants::SERVO_OPEN_ANGLE;
+    return a;
+  }
+
+  void accountComfort(double dtH) {
+    const SystemSettings &s = g_settings;
+    float t = g_plant.airTemperature;
+    float h = g_plant.airHumidity;
+    bool  hot = t > s.comfortTempMax, cold = t < s.comfortTempMin;
+    bool  humid = h > s.comfortHumMax, dry = h < s.comfortHumMin;
+
+    if (hot)   g_comfort.hot   += dtH;
+    if (cold)  g_comfort.cold  += dtH;
+    if (humid) g_comfort.humid += dtH;
+    if (dry)   g_comfort.dry   += dtH;
+    if (hot || cold || humid || dry) g_comfort.out += dtH;
+    if (g_plant.soilMoisture < s.soilMoistureSetpoint - s.soilMoistureHysteresis) g_comfort.soilLow += dtH;
+  }
+
+  // Сдвинуть часы на ms: исполнители между дедлайнами не меняются,
+  // модель шагает по PLANT_STEP_S и учитывает точное время работы насоса
+  void advance(unsigned long ms) {
+    Plant::Actuators a = readActuators();
+    double left = ms / 1000.0;
+
+    while (left > 0) {
+      double take = min(left, PLANT_STEP_S - g_pendingS);
+      HostHal::advance((uint64_t)llround(take * 1e6));
+      if (a.pump) g_pumpS += take;
+      g_pendingS += take;
+      left       -= take;
+
+      if (g_pendingS >= PLANT_STEP_S - 1e-9) {
+        double   simS = HostHal::nowUs() / 1e6;
+        uint32_t day  = (uint32_t)(simS / 86400.0);
+        float    hour = (float)fmod(simS / 3600.0, 24.0);
+
+        g_plant.step((float)g_pendingS, a, (float)g_pumpS, hour, day);
+        g_plant.publish(HostHal::inputs());
+        accountComfort(g_pendingS / 3600.0);
+        g_pendingS = 0;
+        g_pumpS    = 0;
+      }
+    }
+  }
+
+  // Код выхода процесса режима
+  int runMode(const Options &opt, uint8_t mode) {
+    HostHal::reset(START_LOCAL, opt.seed);
+    HostHal::setVerbose(opt.verbose);
+
+    g_plant.begin(opt.seed, opt.season);
+    g_plant.publish(HostHal::inputs());
+
+    g_settings = SystemSettings();
+    applyCropProfile(opt.profile, g_settings);
+    g_settings.climateMode = mode;
+
+    g_devices.begin();
+    g_automation.begin();
+
+    // Как в setup(), без дисплея, журнала и сети
+    g_scheduler.addPeriodic("sensors",    Constants::SENSOR_READ_INTERVAL_MS,
+                            []() { g_devices.startSensorCycle(); },
+                            Constants::SENSOR_READ_INTERVAL_MS);
+    g_scheduler.addPeriodic("sensor_io",  Constants::SENSOR_POLL_MS,
+                            []() { g_devices.serviceSensors(); });
+    g_scheduler.addPeriodic("actuators",  Constants::ACTUATOR_UPDATE_MS,
+                            []() { PerfScope p(Perf::ACTUATORS); g_devices.loop(); });
+    g_scheduler.addPeriodic("automation", Constants::AUTOMATION_INTERVAL_MS,
+                            []() { PerfScope p(Perf::AUTOMATION); g_automation.run(); },
+                            Constants::AUTOMATION_INTERVAL_MS);
+
+    // Процессорное время: режимы идут параллельно и делят ядра
+    struct timespec c0, c1;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &c0);
+
+    const uint64_t endUs = (uint64_t)opt.days * 86400ULL * 1000000ULL;
+    while (HostHal::nowUs() < endUs) {
+      unsigned long wait = g_scheduler.runDue();
+      if (wait > 0) advance(wait);
+    }
+
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &c1);
+    double cpuS = (c1.tv_sec - c0.tv_sec) + (c1.tv_nsec - c0.tv_nsec) / 1e9;
+
+    double pumpS   = g_devices.pumpMsTotal() / 1000.0;
+    double modeH   = g_automation.modeSec(mode) / 3600.0;
+    double sensedH = g_automation.outOfBandSec(mode) / 3600.0;
+
+    printf("%-10s %7.2f %7.0f %7u %6u %6u %6u %8.1f %8.1f %6.1f %6.1f %6.1f %6.1f %8.1f %7.2f\n",
+           MODE_NAMES[mode], pumpS * Plant::PUMP_LITERS_PER_S, pumpS,
+           (unsigned)g_devices.switchCount(Devices::ACT_PUMP),
+           (unsigned)g_devices.switchCount(Devices::ACT_FAN),
+           (unsigned)g_devices.switchCount(Devices::ACT_LIGHT),
+           (unsigned)g_devices.switchCount(Devices::ACT_DOOR),
+           g_comfort.out, modeH > 0 ? 100.0 * sensedH / modeH : 0.0,
+           g_comfort.hot, g_comfort.cold, g_comfort.humid, g_comfort.dry,
+           g_comfort.soilLow, cpuS);
+    fflush(stdout);
+
+    if (opt.season == Plant::AUTUMN && g_devices.switchCount(Devices::ACT_LIGHT) == 0) {
+      fprintf(stderr, "режим %s: осенью досветка ни разу не включилась\n", MODE_NAMES[mode]);
+      return 1;
+    }
+    return 0;
+  }
+
+  bool parseArgs(int argc, char **argv, Options &opt) {
+    for (int i = 1; i < argc; ++i) {
+      const char *a   = argv[i];
+      const char *val = i + 1 < argc ? argv[i + 1] : nullptr;
+      if      (!strcmp(a, "--verbose"))         opt.verbose = true;
+      else if (!strcmp(a, "--days") && val)    { opt.days    = strtoul(val, nullptr, 10); ++i; }
+      else if (!strcmp(a, "--profile") && val) { opt.profile = (uint8_t)strtoul(val, nullptr, 10); ++i; }
+      else if (!strcmp(a, "--mode") && val)    { opt.mode    = atoi(val); ++i; }
+      else if (!strcmp(a, "--seed") && val)    { opt.seed    = strtoul(val, nullptr, 10); ++i; }
+      else if (!strcmp(a, "--season") && val && !strcmp(val, "summer")) { opt.season = Plant::SUMMER; ++i; }
+      else if (!strcmp(a, "--season") && val && !strcmp(val, "autumn")) { opt.season = Plant::AUTUMN; ++i; }
+      else return false;
+    }
+    // millis() на ESP32 32-битный: дальше 49 суток его переполнение не моделируется
+    return opt.days >= 1 && opt.days <= 48 && opt.profile <= 4 &&
+           opt.mode >= -1 && opt.mode < Automation::CLIMATE_MODES;
+  }
+}
+
+int main(int argc, char **argv) {
+  Options opt;
+  if (!parseArgs(argc, argv, opt)) {
+    fprintf(stderr, "usage: %s [--days 1..48] [--profile 0..4] [--mode 0..2] [--seed N] "
+                    "[--season summer|autumn] [--verbose]\n", argv[0]);
+    return 2;
+  }
+
+  printf("Теплица: %u сут, %s, профиль %u, seed %u; время — часы модели, out_sensed — по учёту Automation\n",
+         (unsigned)opt.days, opt.season == Plant::AUTUMN ? "осень" : "лето",
+         (unsigned)opt.profile, (unsigned)opt.seed);
+  printf("%-10s %7s %7s %7s %6s %6s %6s %8s %8s %6s %6s %6s %6s %8s %7s\n",
+         "mode", "water_l", "pump_s", "sw_pump", "sw_fan", "sw_lgt", "sw_door",
+         "out_h", "sensed_%", "hot_h", "cold_h", "hum_h", "dry_h", "soil_lo", "cpu_s");
+  fflush(stdout);
+
+  // Каждый режим — в своём процессе: глобальные g_devices, g_automation,
+  // g_scheduler стартуют с чистого состояния, погода та же (тот же seed).
+  // Режимы идут параллельно, строки выводятся по порядку через каналы.
+  pid_t pids[Automation::CLIMATE_MODES];
+  int   pipes[Automation::CLIMATE_MODES];
+  for (uint8_t m = 0; m < Automation::CLIMATE_MODES; ++m) {
+    pids[m] = -1;
+    if (opt.mode >= 0 && opt.mode != m) continue;
+
+    int fds[2];
+    if (pipe(fds) != 0) {
+      perror("pipe");
+      return 1;
+    }
+    pids[m] = fork();
+    if (pids[m] < 0) {
+      perror("fork");
+      return 1;
+    }
+    if (pids[m] == 0) {
+      close(fds[0]);
+      dup2(fds[1], STDOUT_FILENO);
+      _exit(runMode(opt, m));
+    }
+    close(fds[1]);
+    pipes[m] = fds[0];
+  }
+
+  int rc = 0;
+  for (uint8_t m = 0; m < Automation::CLIMATE_MODES; ++m) {
+    if (pids[m] < 0) continue;
+
+    char    buf[4096];
+    ssize_t n;
+    while ((n = read(pipes[m], buf, sizeof(buf))) > 0) fwrite(buf, 1, n, stdout);
+    close(pipes[m]);
+    fflush(stdout);
+
+    int status = 0;
+    waitpid(pids[m], &status, 0);
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+      fprintf(stderr, "режим %s: симуляция завершилась с ошибкой\n", MODE_NAMES[m]);
+      rc = 1;
+    }
+  }
+  return rc;
+}
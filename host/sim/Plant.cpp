@@ -0,0 +1,105 @@
+// Plant.cpp
+#include "Plant.h"
+
+namespace {
+  // Погода средней полосы: июнь и октябрь
+  const Plant::Weather SUMMER_WEATHER = { 19.0f, 7.0f, 5.0f, 21.0f, 60000.0f, 0.3f };
+  const Plant::Weather AUTUMN_WEATHER = {  8.0f, 4.0f, 7.5f, 17.5f, 20000.0f, 0.05f };
+
+  constexpr float OUT_RH_MEAN   = 65.0f;
+  constexpr float OUT_RH_AMP    = 20.0f;
+
+  // Тепловой баланс, °C/ч и 1/ч
+  constexpr float SOLAR_GAIN    = 14.0f;    // при ясном полудне
+  constexpr float LAMP_GAIN     = 0.5f;
+  constexpr float G_LEAK        = 0.6f;
+  constexpr float G_DOOR        = 5.0f;     // дверь открыта полностью
+  constexpr float G_FAN         = 2.5f;
+
+  // Влага
+  constexpr float TRANSPIRATION = 1.5f;     // г/м³/ч при ясном небе и влажной почве
+  constexpr float SOIL_DRY_BASE = 0.25f;    // %/ч
+  constexpr float SOIL_DRY_SUN  = 1.2f;     // %/ч при ясном полудне
+  constexpr float PUMP_PCT_PER_S = 1.5f;    // % влажности почвы за секунду полива
+
+  constexpr float LAMP_LUX      = 300.0f;   // фитолампа на датчике освещённости
+
+  // Насыщающая абсолютная влажность, г/м³ (формула Магнуса)
+  float saturation(float t) {
+    return 6.112f * expf(17.67f * t / (t + 243.5f)) * 216.74f / (273.15f + t);
+  }
+}
+
+float Plant::uniform01() {
+  rng ^= rng << 13;
+  rng ^= rng >> 17;
+  rng ^= rng << 5;
+  return (rng >> 8) * (1.0f / 16777216.0f);
+}
+
+void Plant::begin(uint32_t seed, Season season) {
+  weather        = season == AUTUMN ? &AUTUMN_WEATHER : &SUMMER_WEATHER;
+  rng            = seed * 2654435761UL + 1;
+  weatherDay     = UINT32_MAX;
+  airTemperature = weather->outMeanC - weather->outAmpC;
+  airHumidity    = 75.0f;
+  soilMoisture   = 50.0f;
+  absHumidity    = saturation(airTemperature) * airHumidity / 100.0f;
+}
+
+void Plant::rollWeather(uint32_t day) {
+  weatherDay   = day;
+  cloudiness   = weather->clearMin + (1.0f - weather->clearMin) * uniform01();
+  dayMeanShift = (uniform01() - 0.5f) * 6.0f;
+}
+
+void Plant::step(float dtS, const Actuators &a, float pumpS, float hourOfDay, uint32_t day) {
+  if (day != weatherDay) rollWeather(day);
+
+  const float PI = 3.14159265f;
+  float dtH = dtS / 3600.0f;
+
+  // Улица: максимум температуры в 15:00, влажность — в противофазе
+  float phase = sinf(2.0f * PI * (hourOfDay - 9.0f) / 24.0f);
+  outdoorTemperature = weather->outMeanC + dayMeanShift + weather->outAmpC * phase;
+  outdoorHumidity    = OUT_RH_MEAN - OUT_RH_AMP * phase;
+
+  float sun = 0.0f;
+  if (hourOfDay > weather->sunriseH && hourOfDay < weather->sunsetH) {
+    sun = sinf(PI * (hourOfDay - weather->sunriseH) / (weather->sunsetH - weather->sunriseH)) * cloudiness;
+  }
+  lightLux = weather->peakLux * sun + (a.light ? LAMP_LUX : 0.0f);
+  // Нагрев и испарение — от мощности солнца; летний полдень — 1
+  sun *= weather->peakLux / SUMMER_WEATHER.peakLux;
+
+  // Тепло
+  float g  = G_LEAK + G_DOOR * a.doorFrac + (a.fan ? G_FAN : 0.0f);
+  float dT = SOLAR_GAIN * sun + (a.light ? LAMP_GAIN : 0.0f) - g * (airTemperature - outdoorTemperature);
+  airTemperature += dT * dtH;
+
+  // Влага воздуха: растения испаряют, пока почва не пересохла
+  float wet     = constrain((soilMoisture - 20.0f) / 40.0f, 0.0f, 1.0f);
+  float absOut  = saturation(outdoorTemperature) * outdoorHumidity / 100.0f;
+  absHumidity  += (TRANSPIRATION * (0.2f + sun) * wet - g * (absHumidity - absOut)) * dtH;
+  float sat     = saturation(airTemperature);
+  if (absHumidity > sat) absHumidity = sat;          // конденсат
+  airHumidity   = 100.0f * absHumidity / sat;
+
+  // Почва: сухая отдаёт воду медленнее
+  float heat = 1.0f + max(airTemperature - 20.0f, 0.0f) / 10.0f;
+  float dry  = (SOIL_DRY_BASE + SOIL_DRY_SUN * sun * heat) * constrain(soilMoisture / 40.0f, 0.1f, 1.0f);
+  soilMoisture += -dry * dtH + PUMP_PCT_PER_S * pumpS;
+  soilMoisture  = constrain(soilMoisture, 0.0f, 100.0f);
+}
+
+void Plant::publish(HostHal::Inputs &in) const {
+  in.airTemperature = airTemperature;
+  in.airHumidity    = airHumidity;
+  in.airPressure    = 1013.0f;
+  in.lightLux       = lightLux;
+
+  // Обратная калибровка Devices::readSoil(): сухо — большие отсчёты
+  const float span = Constants::SOIL_ADC_MAX - Constants::SOIL_ADC_MIN;
+  in.soilAdc      = Constants::SOIL_ADC_MAX - soilMoisture * span / 100.0f;
+  in.soilAdcNoise = 25.0f;
+}
@@ -0,0 +1,67 @@
+// Plant.h
+#ifndef PLANT_H
+#define PLANT_H
+
+#include "Config.h"
+#include <HostHal.h>
+
+// Модель теплицы для симулятора: один объём воздуха и одна гряда.
+//  - температура: солнечный нагрев + фитолампа, потери через утечки,
+//    открытую дверь и вентилятор (проводимость в 1/ч);
+//  - влажность: абсолютная (г/м³) — испарение растений, обмен с улицей;
+//    относительная пересчитывается по температуре (Магнус);
+//  - почва: высыхание от солнца и жары, прибавка за секунды работы насоса.
+// Погода — суточный ход со случайной облачностью и средней по дням.
+// Сезон задаёт улицу и световой день:
+//  - SUMMER — июнь средней полосы, солнце 5–21 ч, светло весь день;
+//  - AUTUMN — октябрь, солнце 7:30–17:30, пасмурно: утром и вечером в
+//    разрешённые часы освещённость ниже порога и работает досветка.
+class Plant {
+public:
+  enum Season : uint8_t { SUMMER = 0, AUTUMN = 1 };
+
+  struct Weather {
+    float outMeanC, outAmpC;     // средняя и полуразмах суточного хода
+    float sunriseH, sunsetH;
+    float peakLux;               // ясный полдень
+    float clearMin;              // наименьшая доля ясного неба за день
+  };
+
+  struct Actuators {
+    bool  pump     = false;
+    bool  fan      = false;
+    bool  light    = false;
+    float doorFrac = 0.0f;    // 0 — закрыта, 1 — SERVO_OPEN_ANGLE
+  };
+
+  // Истинное состояние (датчики видят его с шумом)
+  float airTemperature = 20.0f;
+  float airHumidity    = 60.0f;
+  float soilMoisture   = 50.0f;
+  float lightLux       = 0.0f;
+
+  float outdoorTemperature = 15.0f;
+  float outdoorHumidity    = 70.0f;
+
+  // Расход воды, л на секунду работы насоса
+  static constexpr float PUMP_LITERS_PER_S = 0.03f;
+
+  void begin(uint32_t seed, Season season = SUMMER);
+  // Шаг dtS секунд; pumpS — сколько из них работал насос
+  void step(float dtS, const Actuators &a, float pumpS, float hourOfDay, uint32_t day);
+  void publish(HostHal::Inputs &in) const;
+
+private:
+  const Weather *weather = nullptr;
+
+  uint32_t rng          = 1;
+  uint32_t weatherDay   = UINT32_MAX;
+  float    cloudiness   = 1.0f;   // доля ясного неба на сегодня
+  float    dayMeanShift = 0.0f;   // отклонение средней температуры дня
+  float    absHumidity  = 10.0f;  // г/м³ внутри
+
+  float uniform01();
+  void  rollWeather(uint32_t day);
+};
+
+#endif // PLANT_H
@@ -0,0 +1,240 @@
+// JsonReaderFuzz.cpp
+// Фаззинг и пропускная способность JsonReader (разбор тел POST /api/…).
+// Собирается с AddressSanitizer и UBSan: каждый вход лежит в куче ровно
+// своей длины без '\0', так что любое чтение за концом тела — падение.
+//  - мутации настоящих тел запросов и случайные байты: разбор не выходит
+//    за буфер, не зацикливается, Value указывает внутрь тела, ключ и
+//    copyString всегда с '\0' в пределах ёмкости;
+//  - ключи длиннее буфера и с \u0000 не совпадают с полем-префиксом;
+//  - бенчмарк: полное тело /api/settings через SettingsFields::apply
+//    (json_bench — тот же файл без санитайзеров, с -DBENCH_ONLY).
+// Код выхода ≠ 0 — есть провалы.
+//
+//   json_fuzz [--iters N] [--seed S]
+#include "JsonReader.h"
+#include "SettingsFields.h"
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+namespace {
+  constexpr size_t KEY_CAP   = 24;    // как в обработчиках WebInterface
+
+  int g_failures = 0;
+
+#ifndef BENCH_ONLY
+  // ===== Фаззинг (в json_bench не собирается) =====
+  constexpr size_t STR_CAP   = 33;
+  constexpr size_t MAX_INPUT = 4096;  // MAX_BODY
+  constexpr uint8_t MAX_NEST = 8;
+
+  void fail(const char *what, const std::string &input) {
+    if (g_failures++ < 10) printf("  FAIL %s: %.*s\n", what, (int)input.size(), input.c_str());
+  }
+
+  const char *const SEEDS[] = {
+    R"({"tempDay":"24.5","tempNight":18,"soilMoistureSetpoint":45,"automationEnabled":true})",
+    R"({"device":"pump","action":"pulse","ms":1500})",
+    R"([{"device":"fan","action":"on"},{"device":"door","action":"open"}])",
+    R"({"commands":[{"device":"light","action":"off"}],"scene":"evening"})",
+    R"({"name":"evening","commands":[{"device":"pump","action":"pulse","ms":800}]})",
+    R"({"ssid":"Теплица \"2\"","password":"päss\\w\/rd"})",
+    R"({"a":{"b":[1,2,{"c":null}],"d":"x\ty"},"e":-1.5e+3,"f":false})",
+    R"({"automationEnabledXXXXXXXXXXXX":true})",
+  };
+
+  // JSON-подобный алфавит — мутации чаще дают почти корректный текст
+  const char ALPHABET[] = "{}[]\":,\\ntrufalse0123456789.-+eE u\x01\xD0\xB9";
+
+  struct Rng {
+    uint32_t state;
+    explicit Rng(uint32_t seed) : state(seed ? seed : 1) {}
+    uint32_t next() {
+      state ^= state << 13;
+      state ^= state >> 17;
+      state ^= state << 5;
+      return state;
+    }
+    uint32_t below(uint32_t n) { return n ? next() % n : 0; }
+  };
+
+  std::string mutate(const std::string &in, Rng &rng) {
+    std::string s = in;
+    uint32_t rounds = 1 + rng.below(4);
+    for (uint32_t r = 0; r < rounds; ++r) {
+      size_t pos = s.empty() ? 0 : rng.below((uint32_t)s.size());
+      switch (rng.below(6)) {
+        case 0: if (!s.empty()) s[pos] = (char)rng.next(); break;
+        case 1: s.insert(pos, 1, ALPHABET[rng.below(sizeof(ALPHABET) - 1)]); break;
+        case 2: if (!s.empty()) s.erase(pos, 1 + rng.below(4)); break;
+        case 3: s.insert(pos, s.substr(rng.below((uint32_t)s.size() + 1), 1 + rng.below(16))); break;
+        case 4: s.resize(rng.below((uint32_t)s.size() + 1)); break;
+        case 5: s.insert(pos, std::string(20 + rng.below(20), 'k')); break;   // длинные ключи
+      }
+    }
+    if (s.size() > MAX_INPUT) s.resize(MAX_INPUT);
+    return s;
+  }
+
+  bool inside(const JsonReader::Value &v, const char *buf, size_t len) {
+    if (v.type == JsonReader::T_BOOL || v.type == JsonReader::T_NULL) return true;
+    return v.start >= buf && v.len <= len && v.start + v.len <= buf + len;
+  }
+
+  void checkValue(const JsonReader::Value &v, const char *buf, size_t len, uint8_t depth,
+                  const std::string &input);
+
+  void walkObject(const char *buf, size_t len, const char *at, size_t n, uint8_t depth,
+                  const std::string &input) {
+    JsonReader r(at, n);
+    if (!r.beginObject()) return;
+    char              key[KEY_CAP];
+    JsonReader::Value v;
+    size_t            guard = 0;
+    while (r.nextMember(key, sizeof(key), v)) {
+      if (memchr(key, '\0', sizeof(key)) == nullptr) fail("key not terminated", input);
+      if (++guard > n) { fail("nextMember does not advance", input); return; }
+      checkValue(v, buf, len, depth, input);
+    }
+    if (r.errorPos() > n) fail("errorPos past end", input);
+  }
+
+  void walkArray(const char *buf, size_t len, const char *at, size_t n, uint8_t depth,
+                 const std::string &input) {
+    JsonReader r(at, n);
+    if (!r.beginArray()) return;
+    JsonReader::Value v;
+    size_t            guard = 0;
+    while (r.nextElement(v)) {
+      if (++guard > n) { fail("nextElement does not advance", input); return; }
+      checkValue(v, buf, len, depth, input);
+    }
+    if (r.errorPos() > n) fail("errorPos past end", input);
+  }
+
+  void checkValue(const JsonReader::Value &v, const char *buf, size_t len, uint8_t depth,
+                  const std::string &input) {
+    if (!inside(v, buf, len)) {
+      fail("value outside body", input);
+      return;
+    }
+    double x;
+    v.asNumber(x);
+    char out[STR_CAP];
+    if (v.copyString(out, sizeof(out)) && memchr(out, '\0', sizeof(out)) == nullptr) {
+      fail("copyString not terminated", input);
+    }
+    v.equals("pump");
+    if (depth >= MAX_NEST) return;
+    if (v.type == JsonReader::T_OBJECT) walkObject(buf, len, v.start, v.len, depth + 1, input);
+    if (v.type == JsonReader::T_ARRAY)  walkArray(buf, len, v.start, v.len, depth + 1, input);
+  }
+
+  // Тело — в куче точно своей длины: ASan ловит чтение за концом
+  void fuzzOne(const std::string &input) {
+    size_t len = input.size();
+    char  *buf = (char *)malloc(len ? len : 1);
+    memcpy(buf, input.data(), len);
+    walkObject(buf, len, buf, len, 0, input);
+    walkArray(buf, len, buf, len, 0, input);
+    free(buf);
+  }
+
+  // ===== Ключи, которые не должны совпасть с коротким полем =====
+  void checkKey(const char *json, const char *mustNotEqual, const char *nextKey) {
+    JsonReader        r(json, strlen(json));
+    JsonReader::Value v;
+    char              key[KEY_CAP];
+    bool              sawNext = false;
+    int               before  = g_failures;
+    r.beginObject();
+    while (r.nextMember(key, sizeof(key), v)) {
+      if (strcmp(key, mustNotEqual) == 0) fail("key matched as prefix", json);
+      if (strcmp(key, nextKey) == 0) sawNext = true;
+    }
+    if (r.failed() || !sawNext) fail("value after bad key not skipped", json);
+    if (g_failures == before) printf("  ok   %s\n", json);
+  }
+
+  void testKeys() {
+    printf("keys\n");
+    checkKey(R"({"automationEnabledXXXXXXXXXXXX":true,"ms":5})", "automationEnabledXXXXXX", "ms");
+    checkKey(R"({"soilMoistureSetpointTooLong":{"x":[1,"]"]},"b":1})", "soilMoistureSetpointToo", "b");
+    checkKey(R"({"ms\u0000xyz":9,"device":"pump"})", "ms", "device");
+    checkKey(R"({"пппппппппппп":1,"ok":2})", "ппппппппппп", "ok");
+  }
+#endif // BENCH_ONLY
+
+  // ===== Пропускная способность =====
+  void benchmark() {
+    SystemSettings s{};
+    char           body[2048];
+    JsonWriter     w(body, sizeof(body));
+    w.beginObject();
+    for (uint8_t i = 0; i < SettingsFields::count(); ++i) {
+      SettingsFields::write(w, s, SettingsFields::field(i));
+    }
+    w.endObject();
+    size_t len = w.length();
+
+    constexpr unsigned N = 200000;
+    unsigned applied = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for (unsigned k = 0; k < N; ++k) {
+      JsonReader        r(body, len);
+      JsonReader::Value v;
+      char              key[KEY_CAP];
+      SystemSettings    next = s;
+      r.beginObject();
+      while (r.nextMember(key, sizeof(key), v)) {
+        const SettingsFields::Field *f = SettingsFields::find(key);
+        if (f && SettingsFields::apply(next, *f, v) == SettingsFields::OK) applied++;
+      }
+    }
+    auto   t1 = std::chrono::steady_clock::now();
+    double s_ = std::chrono::duration<double>(t1 - t0).count();
+    printf("bench /api/settings body %zu bytes, %u fields: %.2f us/body, %.1f MB/s (host)\n",
+           len, applied / N, s_ * 1e6 / N, len * (double)N / s_ / 1e6);
+  }
+}
+
+int main(int argc, char **argv) {
+#ifndef BENCH_ONLY
+  uint32_t iters = 200000, seed = 1;
+  for (int i = 1; i < argc; ++i) {
+    if      (!strcmp(argv[i], "--iters") && i + 1 < argc) iters = (uint32_t)strtoul(argv[++i], nullptr, 10);
+    else if (!strcmp(argv[i], "--seed")  && i + 1 < argc) seed  = (uint32_t)strtoul(argv[++i], nullptr, 10);
+  }
+
+  testKeys();
+
+  printf("fuzz %u inputs, seed %u\n", iters, seed);
+  Rng rng(seed);
+  std::vector<std::string> corpus(std::begin(SEEDS), std::end(SEEDS));
+  auto t0 = std::chrono::steady_clock::now();
+  for (uint32_t k = 0; k < iters; ++k) {
+    std::string input;
+    if (k % 16 == 0) {
+      input.resize(rng.below(256));
+      for (char &c : input) c = (char)rng.next();
+    } else {
+      input = mutate(corpus[rng.below((uint32_t)corpus.size())], rng);
+      if (corpus.size() < 256 && rng.below(64) == 0) corpus.push_back(input);
+    }
+    fuzzOne(input);
+  }
+  double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+  printf("  %.0f inputs/s (sanitizers on)\n", iters / s);
+#else
+  (void)argc;   // у бенчмарка нет параметров
+  (void)argv;
+#endif
+
+  benchmark();
+
+  printf(g_failures ? "FAILED: %d\n" : "all passed\n", g_failures);
+  return g_failures ? 1 : 0;
+}
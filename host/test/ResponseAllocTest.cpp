@@ -0,0 +1,243 @@
+// ResponseAllocTest.cpp
+// Выделения кучи на тело ответа: JsonWriter / MetricsWriter в буфере порции
+// JSON_CHUNK, как WriterResponse в WebInterface.cpp. Счётчик — обёртки
+// malloc/calloc/realloc (через них же идёт operator new), только на время
+// сборки тела. Тела:
+//  - /api/settings — SettingsFields::write по всей таблице;
+//  - /api/sensors  — те же поля и точность, что SENSOR_FLOATS/SENSOR_BOOLS;
+//  - /api/perf     — все каналы Perf с корзинами;
+//  - /metrics      — гистограммы Perf по две порции на канал.
+// Ожидается 0 выделений на тело и ни одной порции больше буфера.
+// Объект ответа (буфер порции внутри, один блок ~2,1 КБ на запрос) и
+// выделения самой ESPAsyncWebServer сюда не входят — см. tools/heap_soak.py.
+// Код выхода ≠ 0 — есть провалы.
+//
+//   alloc_test [--iters N]
+#include "JsonWriter.h"
+#include "MetricsWriter.h"
+#include "Perf.h"
+#include "SettingsFields.h"
+#include <chrono>
+#include <functional>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ===== Счётчик выделений (glibc) =====
+extern "C" {
+  void *__libc_malloc(size_t);
+  void *__libc_calloc(size_t, size_t);
+  void *__libc_realloc(void *, size_t);
+}
+
+namespace {
+  bool     g_counting = false;
+  uint64_t g_allocs   = 0;
+  uint64_t g_bytes    = 0;
+
+  void counted(size_t n) {
+    if (!g_counting) return;
+    g_allocs++;
+    g_bytes += n;
+  }
+}
+
+extern "C" {
+  void *malloc(size_t n)            { counted(n);     return __libc_malloc(n); }
+  void *calloc(size_t k, size_t n)  { counted(k * n); return __libc_calloc(k, n); }
+  void *realloc(void *p, size_t n)  { counted(n);     return __libc_realloc(p, n); }
+}
+
+namespace {
+  constexpr size_t JSON_CHUNK = 2048;   // как в WebInterface.cpp
+
+  int g_failures = 0;
+
+  // Тело как последовательность порций: produce() пишет порцию и говорит,
+  // будет ли следующая (та же схема, что chunkedResponse)
+  template <typename Writer>
+  struct Body {
+    const char                   *name;
+    std::function<bool(Writer &)> produce;
+  };
+
+  struct Result {
+    size_t bytes     = 0;
+    size_t maxChunk  = 0;
+    size_t chunks    = 0;
+    bool   overflow  = false;
+  };
+
+  template <typename Writer>
+  Result build(std::function<bool(Writer &)> &produce, char *buf) {
+    Result r;
+    Writer w(buf, JSON_CHUNK);
+    bool   more = true;
+    while (more) {
+      w.clearBuffer();
+      more = produce(w);
+      if (w.overflow()) r.overflow = true;
+      r.bytes += w.length();
+      r.chunks++;
+      if (w.length() > r.maxChunk) r.maxChunk = w.length();
+    }
+    return r;
+  }
+
+  template <typename Writer>
+  void measure(Body<Writer> &body, unsigned iters) {
+    static char buf[JSON_CHUNK];
+    Result r = build<Writer>(body.produce, buf);   // прогрев и размер
+
+    g_allocs   = 0;
+    g_bytes    = 0;
+    g_counting = true;
+    auto t0 = std::chrono::steady_clock::now();
+    for (unsigned k = 0; k < iters; ++k) build<Writer>(body.produce, buf);
+    auto t1 = std::chrono::steady_clock::now();
+    g_counting = false;
+
+    double perBody = (double)g_allocs / iters;
+    double us      = std::chrono::duration<double>(t1 - t0).count() * 1e6 / iters;
+    bool   ok      = g_allocs == 0 && !r.overflow;
+    printf("  %-4s %-14s %5zu B, %2zu порц., max %4zu B: %.2f выдел./тело (%.0f B), %.2f мкс\n",
+           ok ? "ok" : "FAIL", body.name, r.bytes, r.chunks, r.maxChunk, perBody,
+           iters ? (double)g_bytes / iters : 0.0, us);
+    if (!ok) g_failures++;
+  }
+
+  // Гистограммы с правдоподобным наполнением — все корзины ненулевые,
+  // числа самой большой длины
+  void fillPerf() {
+    for (uint8_t ch = 0; ch < Perf::CHANNEL_COUNT; ++ch) {
+      for (uint8_t b = 0; b < Perf::BUCKETS; ++b) {
+        for (uint8_t k = 0; k < 3; ++k) Perf::record((Perf::Channel)ch, (2UL << b) - 1);
+      }
+      Perf::record((Perf::Channel)ch, 0xFFFFFFFFUL);
+    }
+  }
+}
+
+int main(int argc, char **argv) {
+  unsigned iters = 20000;
+  for (int i = 1; i < argc; ++i) {
+    if (!strcmp(argv[i], "--iters") && i + 1 < argc) iters = (unsigned)strtoul(argv[++i], nullptr, 10);
+  }
+
+  fillPerf();
+  SystemSettings settings{};
+  SensorData     sd{};
+  sd.airTemperature  = -12.3f;
+  sd.airHumidity     = 99.9f;
+  sd.soilMoisture    = NAN;
+  sd.soilMoistureVar = 12.34f;
+  sd.lightLevelLux   = 65535.0f;
+  sd.timestampMs     = 4294967295UL;
+
+  printf("allocations per response body, %u iterations\n", iters);
+
+  // Счётчик вообще видит выделения (иначе 0 ниже ничего не значит)
+  g_counting = true;
+  void *volatile probe = malloc(64);
+  g_counting = false;
+  free(probe);
+  if (g_allocs != 1) {
+    printf("  FAIL allocation counter: %llu\n", (unsigned long long)g_allocs);
+    g_failures++;
+  }
+
+  Body<JsonWriter> settingsBody{"/api/settings", [&](JsonWriter &w) {
+    w.beginObject();
+    for (uint8_t i = 0; i < SettingsFields::count(); ++i) {
+      SettingsFields::write(w, settings, SettingsFields::field(i));
+    }
+    w.endObject();
+    return false;
+  }};
+  measure(settingsBody, iters);
+
+  Body<JsonWriter> sensorsBody{"/api/sensors", [&](JsonWriter &w) {
+    w.beginObject();
+    w.field("airTemperature",  sd.airTemperature, 1);
+    w.field("airHumidity",     sd.airHumidity, 1);
+    w.field("soilMoisture",    isnan(sd.soilMoisture) ? 0.0f : sd.soilMoisture, 1);
+    w.field("soilMoistureVar", sd.soilMoistureVar, 2);
+    w.field("lightLevelLux",   sd.lightLevelLux, 1);
+    w.field("pumpOn",   sd.pumpOn);
+    w.field("fanOn",    sd.fanOn);
+    w.field("lightOn",  sd.lightOn);
+    w.field("doorOpen", sd.doorOpen);
+    w.field("automationEnabled", true);
+    w.field("timestampMs", sd.timestampMs);
+    w.field("version", 4294967295UL);
+    w.endObject();
+    return false;
+  }};
+  measure(sensorsBody, iters);
+
+  uint8_t perfStep = 0;
+  Body<JsonWriter> perfBody{"/api/perf", [&](JsonWriter &w) {
+    if (perfStep == 0) {
+      w.beginObject();
+      w.field("bucketUnit", "log2_us");
+      w.key("subsystems").beginObject();
+      perfStep++;
+      return true;
+    }
+    Perf::Channel   ch = (Perf::Channel)(perfStep - 1);
+    Perf::Histogram h  = Perf::snapshot(ch);
+    w.key(Perf::channelName(ch)).beginObject();
+    w.field("count", h.count);
+    w.field("avgUs", h.avgUs());
+    w.field("p50Us", h.percentileUs(50));
+    w.field("p99Us", h.percentileUs(99));
+    w.field("maxUs", h.maxUs);
+    w.key("buckets").beginArray();
+    for (uint8_t b = 0; b < Perf::BUCKETS; ++b) w.value(h.buckets[b]);
+    w.endArray().endObject();
+    if (++perfStep <= Perf::CHANNEL_COUNT) return true;
+    w.endObject().endObject();
+    perfStep = 0;
+    return false;
+  }};
+  measure(perfBody, iters);
+
+  uint8_t         histStep = 0;
+  Perf::Histogram hist;
+  uint32_t        cumulative = 0;
+  Body<MetricsWriter> metricsBody{"/metrics hist", [&](MetricsWriter &m) {
+    static const char *const NAME  = "greenhouse_subsystem_duration_microseconds";
+    static constexpr uint8_t SPLIT = Perf::BUCKETS / 2;
+    Perf::Channel ch   = (Perf::Channel)(histStep / 2);
+    bool          tail = histStep % 2;
+    histStep++;
+
+    if (!tail) {
+      if (ch == 0) m.family(NAME, "histogram", "Время работы подсистемы за вызов");
+      hist       = Perf::snapshot(ch);
+      cumulative = 0;
+    }
+    uint8_t from = tail ? SPLIT : 0;
+    uint8_t to   = tail ? Perf::BUCKETS - 1 : SPLIT;
+    for (uint8_t b = from; b < to; ++b) {
+      cumulative += hist.buckets[b];
+      m.metric(NAME, "_bucket").label("subsystem", Perf::channelName(ch))
+       .label("le", 2UL << b).value((unsigned long)cumulative);
+    }
+    if (!tail) return true;
+
+    cumulative += hist.buckets[Perf::BUCKETS - 1];
+    m.metric(NAME, "_bucket").label("subsystem", Perf::channelName(ch)).labelInf("le")
+     .value((unsigned long)cumulative);
+    m.metric(NAME, "_sum").label("subsystem", Perf::channelName(ch)).value((unsigned long long)hist.sumUs);
+    m.metric(NAME, "_count").label("subsystem", Perf::channelName(ch)).value((unsigned long)cumulative);
+    if (ch + 1 < Perf::CHANNEL_COUNT) return true;
+    histStep = 0;
+    return false;
+  }};
+  measure(metricsBody, iters);
+
+  printf(g_failures ? "FAILED: %d\n" : "all passed\n", g_failures);
+  return g_failures ? 1 : 0;
+}
@@ -0,0 +1,315 @@
+// SlopeEstimatorTest.cpp
+// Точность SlopeEstimator на известных входах и стоимость add()/fit().
+//  - прямая: наклон точный, stdErr ≈ 0;
+//  - прямая + шум: среднее наклона несмещено, stdErr совпадает с фактическим
+//    разбросом, интервал ±2·stdErr накрывает истину ~95%;
+//  - ровная почва + шум: realTrend (Automation::dryingRate) срабатывает редко;
+//  - ступенька полива: высыхания не видно, после окна наклон снова 0;
+//  - WINDOW на 32 мин совпадает со старым МНК-проходом по кольцу из 32 точек.
+// Точки — раз в минуту, как recordSoilHistory. Код выхода ≠ 0 — есть провалы.
+//
+//   slope_test [--trials N]
+#include "Automation.h"
+#include "SlopeEstimator.h"
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+namespace {
+  constexpr unsigned long MINUTE_MS = 60UL * 1000UL;
+  constexpr unsigned long SPAN_MS   = 32UL * MINUTE_MS;
+  constexpr const char   *MODE_NAMES[] = { "window", "exp" };
+
+  int g_failures = 0;
+
+  void check(bool ok, const char *what, double got, double lo, double hi) {
+    printf("  %-4s %-40s %9.4f  [%g .. %g]\n", ok ? "ok" : "FAIL", what, got, lo, hi);
+    if (!ok) g_failures++;
+  }
+
+  void expectRange(const char *what, double got, double lo, double hi) {
+    check(got >= lo && got <= hi, what, got, lo, hi);
+  }
+
+  // Детерминированный гауссов шум (Бокс — Мюллер над xorshift32)
+  struct Noise {
+    uint32_t state;
+    explicit Noise(uint32_t seed) : state(seed ? seed : 1) {}
+
+    double uniform() {
+      state ^= state << 13;
+      state ^= state >> 17;
+      state ^= state << 5;
+      return (state + 1.0) / 4294967297.0;
+    }
+    double gauss(double sigma) {
+      return sigma * sqrt(-2.0 * log(uniform())) * cos(2.0 * M_PI * uniform());
+    }
+  };
+
+  // ===== Эталон: прежний computeSoilDryingSlope =====
+  // Кольцо последних 32 точек и полный МНК-проход на каждом запросе.
+  struct ReferenceScan {
+    static constexpr uint8_t SOIL_HISTORY_MAX = 32;
+
+    float         soilMoistureHistory[SOIL_HISTORY_MAX];
+    unsigned long soilTimeHistory[SOIL_HISTORY_MAX];
+    uint8_t       soilHistoryCount = 0;
+    uint8_t       soilHistoryIndex = 0;
+
+    void add(unsigned long nowMs, float moisture) {
+      if (soilHistoryCount < SOIL_HISTORY_MAX) soilHistoryCount++;
+      soilMoistureHistory[soilHistoryIndex] = moisture;
+      soilTimeHistory[soilHistoryIndex]     = nowMs;
+      soilHistoryIndex = (soilHistoryIndex + 1) % SOIL_HISTORY_MAX;
+    }
+
+    // Наклон %/час без ограничений; valid = false — точек меньше 4 или нет разброса
+    double slope(bool &valid) const {
+      valid = false;
+      if (soilHistoryCount < 4) return 0.0;
+
+      float n = (float)soilHistoryCount;
+      double sumT = 0.0, sumM = 0.0, sumTT = 0.0, sumTM = 0.0;
+
+      uint8_t firstIdx = (soilHistoryIndex + SOIL_HISTORY_MAX - soilHistoryCount) % SOIL_HISTORY_MAX;
+      unsigned long t0 = soilTimeHistory[firstIdx];
+
+      for (uint8_t i = 0; i < soilHistoryCount; ++i) {
+        uint8_t idx = (firstIdx + i) % SOIL_HISTORY_MAX;
+        double tHours = (double)(soilTimeHistory[idx] - t0) / 3600000.0;
+        double m      = soilMoistureHistory[idx];
+        sumT  += tHours;
+        sumM  += m;
+        sumTT += tHours * tHours;
+        sumTM += tHours * m;
+      }
+
+      double denom = (n * sumTT - sumT * sumT);
+      if (fabs(denom) < 1e-6) return 0.0;
+      valid = true;
+      return (n * sumTM - sumT * sumM) / denom;
+    }
+
+    // Скорость высыхания, как её отдавал старый код
+    float dryingRate() const {
+      bool   valid;
+      double a = slope(valid);
+      if (!valid || a < -20.0 || a > 0.0) return 0.0f;
+      return (float)(-a);
+    }
+  };
+
+  SlopeEstimator make(SlopeEstimator::Mode mode) {
+    SlopeEstimator e;
+    e.configure(mode, SPAN_MS);
+    return e;
+  }
+
+  // y = y0 + rate·t (t — часы) + шум, minutes точек раз в минуту
+  SlopeEstimator::Fit feedLine(SlopeEstimator &e, double y0, double rate, double sigma,
+                               unsigned minutes, Noise &noise) {
+    for (unsigned i = 0; i < minutes; ++i) {
+      double tH = i / 60.0;
+      e.add(1000UL + i * MINUTE_MS, (float)(y0 + rate * tH + noise.gauss(sigma)));
+    }
+    return e.fit();
+  }
+
+  // ===== Прямая без шума =====
+  void testLinear(SlopeEstimator::Mode mode) {
+    printf("linear, %s\n", MODE_NAMES[mode]);
+    const double rates[] = { -2.0, -0.3, 0.0, 1.5 };
+    for (double rate : rates) {
+      SlopeEstimator e = make(mode);
+      Noise noise(1);
+      SlopeEstimator::Fit f = feedLine(e, 55.0, rate, 0.0, 90, noise);
+      char what[64];
+      snprintf(what, sizeof(what), "slope, true %.1f %%/h", rate);
+      expectRange(what, f.slope, rate - 1e-3, rate + 1e-3);
+      expectRange("stdErr", f.stdErr, 0.0, 1e-3);
+      if (!f.valid) check(false, "valid", 0, 1, 1);
+    }
+  }
+
+  // ===== Прямая + шум: несмещённость и калибровка stdErr =====
+  void testNoisy(SlopeEstimator::Mode mode, unsigned trials) {
+    printf("noisy line -1.5 %%/h, sigma 0.5 %%, %s, %u trials\n", MODE_NAMES[mode], trials);
+    const double rate = -1.5, sigma = 0.5;
+    double sum = 0, sum2 = 0, errSum = 0;
+    unsigned covered = 0, detected = 0;
+
+    for (unsigned k = 0; k < trials; ++k) {
+      SlopeEstimator e = make(mode);
+      Noise noise(k + 1);
+      SlopeEstimator::Fit f = feedLine(e, 55.0, rate, sigma, 120, noise);
+      sum    += f.slope;
+      sum2   += (double)f.slope * f.slope;
+      errSum += f.stdErr;
+      if (fabs(f.slope - rate) <= 2.0 * f.stdErr) covered++;
+      bool real;
+      Automation::dryingRate(f, real);
+      if (real) detected++;
+    }
+    double mean   = sum / trials;
+    double spread = sqrt(sum2 / trials - mean * mean);
+    double meanSe = errSum / trials;
+
+    expectRange("mean slope", mean, rate - 0.05, rate + 0.05);
+    expectRange("mean stdErr / actual spread", meanSe / spread, 0.85, 1.15);
+    expectRange("coverage of +-2 stdErr", (double)covered / trials, 0.91, 0.98);
+    // Мощность — справочно: при 32 точках и sigma 0,5 stdErr ≈ 0,57 %/ч
+    printf("       realTrend detected %.1f%%, actual spread %.3f %%/h\n",
+           100.0 * detected / trials, spread);
+  }
+
+  // ===== Ровная почва + шум: ложные тренды =====
+  void testFlat(SlopeEstimator::Mode mode, unsigned trials) {
+    printf("flat + noise 0.5 %%, %s, %u trials\n", MODE_NAMES[mode], trials);
+    unsigned falseTrend = 0;
+    for (unsigned k = 0; k < trials; ++k) {
+      SlopeEstimator e = make(mode);
+      Noise noise(1000003u * (k + 1));
+      bool real;
+      Automation::dryingRate(feedLine(e, 45.0, 0.0, 0.5, 120, noise), real);
+      if (real) falseTrend++;
+    }
+    // Одностороннее 2σ — около 2,3% при нормальном шуме
+    expectRange("false realTrend rate", (double)falseTrend / trials, 0.0, 0.05);
+  }
+
+  // ===== Ступенька полива: +10% мгновенно =====
+  void testStep(SlopeEstimator::Mode mode) {
+    printf("watering step +10 %%, %s\n", MODE_NAMES[mode]);
+    SlopeEstimator e = make(mode);
+    unsigned long t = 1000UL;
+    for (unsigned i = 0; i < 60; ++i, t += MINUTE_MS) e.add(t, 40.0f);
+
+    unsigned realAfterStep = 0;
+    float    maxSlope      = 0.0f;
+    // WINDOW забывает ступеньку через span, EXPONENTIAL — за несколько span
+    unsigned settle = mode == SlopeEstimator::WINDOW ? 33 : 8 * 32;
+    for (unsigned i = 0; i < settle; ++i, t += MINUTE_MS) {
+      e.add(t, 50.0f);
+      SlopeEstimator::Fit f = e.fit();
+      bool real;
+      Automation::dryingRate(f, real);
+      if (real) realAfterStep++;
+      if (f.slope > maxSlope) maxSlope = f.slope;
+    }
+    expectRange("realTrend samples after step", realAfterStep, 0, 0);
+    printf("       peak slope after step %.2f %%/h\n", maxSlope);
+    expectRange("|slope| after settling", fabs(e.fit().slope), 0.0, 0.05);
+  }
+
+  // ===== Совпадение со старым проходом =====
+  // Точки через 61 с — как при тике автоматики чуть позже минутной отметки:
+  // в окно 32 мин попадают ровно 32 последние точки, как в старое кольцо.
+  // При шаге ровно 60 с окно [t-32 мин, t] включает обе границы — 33 точки.
+  void testReference(unsigned trials) {
+    constexpr unsigned long STEP_MS = 61UL * 1000UL;
+    printf("window 32 min vs reference 32-sample scan, %u trials\n", trials);
+    const double rates[] = { -4.0, -1.5, -0.2, 0.0, 0.8 };
+    double   maxSlopeDiff = 0.0, maxRateDiff = 0.0;
+    unsigned countMismatch = 0, validMismatch = 0;
+
+    for (unsigned k = 0; k < trials; ++k) {
+      SlopeEstimator e = make(SlopeEstimator::WINDOW);
+      ReferenceScan  ref;
+      Noise          noise(k + 17);
+      double         rate = rates[k % (sizeof(rates) / sizeof(rates[0]))];
+
+      for (unsigned i = 0; i < 90; ++i) {
+        unsigned long t = 1000UL + i * STEP_MS;
+        float y = (float)(50.0 + rate * (t / 3600000.0) + noise.gauss(0.5));
+        e.add(t, y);
+        ref.add(t, y);
+
+        if (e.count() != ref.soilHistoryCount) countMismatch++;
+        SlopeEstimator::Fit f = e.fit();
+        bool   refValid;
+        double refSlope = ref.slope(refValid);
+        if (f.valid != refValid) { validMismatch++; continue; }
+        if (!refValid) continue;
+
+        bool  real;
+        float rateNew = Automation::dryingRate(f, real);
+        maxSlopeDiff  = fmax(maxSlopeDiff, fabs(f.slope - refSlope));
+        maxRateDiff   = fmax(maxRateDiff, fabs(rateNew - ref.dryingRate()));
+      }
+    }
+    expectRange("points in window != ring", countMismatch, 0, 0);
+    expectRange("valid != reference", validMismatch, 0, 0);
+    expectRange("max |slope - reference|, %/h", maxSlopeDiff, 0.0, 1e-3);
+    expectRange("max |dryingRate - reference|, %/h", maxRateDiff, 0.0, 1e-3);
+  }
+
+  // ===== Стоимость =====
+  // Старый путь: запись в кольцо и полный проход на каждом тике
+  double benchmarkReference() {
+    constexpr unsigned N = 2000000;
+    ReferenceScan ref;
+    Noise noise(7);
+    float ys[1024];
+    for (float &y : ys) y = (float)(50.0 + noise.gauss(0.5));
+
+    auto   t0   = std::chrono::steady_clock::now();
+    double sink = 0;
+    for (unsigned i = 0; i < N; ++i) {
+      ref.add(1000UL + i * MINUTE_MS, ys[i & 1023]);
+      bool valid;
+      sink += ref.slope(valid);
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    double ns = std::chrono::duration<double, std::nano>(t1 - t0).count() / N;
+    printf("bench %-6s add+fit %.1f ns/point (host)%s\n", "ref32", ns,
+           sink == 12345.0 ? " " : "");
+    return ns;
+  }
+
+  double benchmark(SlopeEstimator::Mode mode) {
+    constexpr unsigned N = 2000000;
+    SlopeEstimator e = make(mode);
+    Noise noise(7);
+    float ys[1024];
+    for (float &y : ys) y = (float)(50.0 + noise.gauss(0.5));
+
+    auto   t0   = std::chrono::steady_clock::now();
+    double sink = 0;
+    for (unsigned i = 0; i < N; ++i) {
+      e.add(1000UL + i * MINUTE_MS, ys[i & 1023]);
+      sink += e.fit().slope;
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    double ns = std::chrono::duration<double, std::nano>(t1 - t0).count() / N;
+    printf("bench %-6s add+fit %.1f ns/point (host)%s\n", MODE_NAMES[mode], ns,
+           sink == 12345.0 ? " " : "");
+    return ns;
+  }
+}
+
+int main(int argc, char **argv) {
+  unsigned trials = 4000;
+  for (int i = 1; i < argc; ++i) {
+    if (!strcmp(argv[i], "--trials") && i + 1 < argc) trials = (unsigned)atoi(argv[++i]);
+  }
+  if (trials < 100) trials = 100;
+
+  for (SlopeEstimator::Mode mode : { SlopeEstimator::WINDOW, SlopeEstimator::EXPONENTIAL }) {
+    testLinear(mode);
+    testNoisy(mode, trials);
+    testFlat(mode, trials);
+    testStep(mode);
+  }
+  testReference(trials / 40);
+
+  double refNs = benchmarkReference();
+  double winNs = benchmark(SlopeEstimator::WINDOW);
+  double expNs = benchmark(SlopeEstimator::EXPONENTIAL);
+  printf("speedup vs ref32: window %.1fx, exp %.1fx\n", refNs / winNs, refNs / expNs);
+
+  printf(g_failures ? "FAILED: %d\n" : "all passed\n", g_failures);
+  return g_failures ? 1 : 0;
+}
@@ -0,0 +1,36 @@
+#!/usr/bin/env python3
+# embed_index.py — сжимает web/index.html в IndexHtml.h (gzip, PROGMEM).
+# Запускать из корня скетча после каждого изменения web/index.html:
+#   python3 tools/embed_index.py
+import gzip
+import hashlib
+import os
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+SRC = os.path.join(ROOT, "web", "index.html")
+DST = os.path.join(ROOT, "IndexHtml.h")
+
+with open(SRC, "rb") as f:
+    raw = f.read()
+
+# mtime=0 — одинаковый вход даёт одинаковый архив (и ETag)
+gz = gzip.compress(raw, compresslevel=9, mtime=0)
+etag = '"' + hashlib.sha1(gz).hexdigest()[:16] + '"'
+
+lines = []
+for i in range(0, len(gz), 16):
+    lines.append("  " + ", ".join("0x%02x" % b for b in gz[i:i + 16]) + ",")
+
+with open(DST, "w", encoding="utf-8", newline="\n") as f:
+    f.write("// IndexHtml.h\n")
+    f.write("// Сгенерировано tools/embed_index.py из web/index.html — не редактировать вручную.\n")
+    f.write("#ifndef INDEX_HTML_H\n#define INDEX_HTML_H\n\n")
+    f.write("#include <Arduino.h>\n\n")
+    f.write("static constexpr size_t INDEX_HTML_RAW_LEN = %d;\n" % len(raw))
+    f.write("static constexpr size_t INDEX_HTML_GZ_LEN  = %d;\n" % len(gz))
+    f.write("static const char INDEX_HTML_ETAG[] = %s;\n\n" % ('"\\"' + etag[1:-1] + '\\""'))
+    f.write("static const uint8_t INDEX_HTML_GZ[] PROGMEM = {\n")
+    f.write("\n".join(lines) + "\n")
+    f.write("};\n\n#endif // INDEX_HTML_H\n")
+
+print("index.html: %d -> %d bytes gzip, ETag %s" % (len(raw), len(gz), etag))
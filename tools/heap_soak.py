@@ -0,0 +1,115 @@
+#!/usr/bin/env python3
+# heap_soak.py — длительный прогон GET-маршрутов прошивки и запись кучи.
+# По кругу запрашивает маршруты JSON и /metrics; каждые --sample запросов
+# читает из /metrics свободную кучу, её минимум с загрузки и крупнейший
+# свободный блок. В конце — дрейф за прогон: если ответы не оставляют
+# мусора и не дробят кучу, free возвращается к исходному уровню, а
+# min_free и max_alloc перестают падать после первых минут.
+#   python3 tools/heap_soak.py 192.168.1.50 --minutes 60 --csv soak.csv
+# Только стандартная библиотека Python.
+import argparse
+import base64
+import csv
+import sys
+import time
+import urllib.error
+import urllib.request
+
+PATHS = [
+    "/api/sensors",
+    "/api/sensors.bin",
+    "/api/settings",
+    "/api/scenes",
+    "/api/diagnostics",
+    "/api/perf",
+    "/api/history",
+    "/api/rollup",
+    "/metrics",
+]
+
+HEAP_METRICS = {
+    "greenhouse_heap_free_bytes": "free",
+    "greenhouse_heap_min_free_bytes": "min_free",
+    "greenhouse_heap_max_alloc_bytes": "max_alloc",
+}
+
+
+def fetch(base, path, auth, timeout):
+    req = urllib.request.Request(base + path, headers={"Authorization": auth})
+    with urllib.request.urlopen(req, timeout=timeout) as resp:
+        return resp.read()
+
+
+def heap(base, auth, timeout):
+    text = fetch(base, "/metrics", auth, timeout).decode("utf-8", "replace")
+    out = {}
+    for line in text.splitlines():
+        name, _, value = line.partition(" ")
+        if name in HEAP_METRICS:
+            out[HEAP_METRICS[name]] = int(float(value))
+    if len(out) != len(HEAP_METRICS):
+        raise RuntimeError("в /metrics нет метрик кучи")
+    return out
+
+
+def main():
+    ap = argparse.ArgumentParser(description="Куча прошивки под длительной нагрузкой")
+    ap.add_argument("host", help="адрес устройства, например 192.168.1.50")
+    ap.add_argument("--user", default="admin")
+    ap.add_argument("--password", default="greenhouse")
+    ap.add_argument("--minutes", type=float, default=30.0)
+    ap.add_argument("--sample", type=int, default=200, help="запросов между замерами кучи")
+    ap.add_argument("--timeout", type=float, default=10.0)
+    ap.add_argument("--csv", help="записать замеры в CSV")
+    args = ap.parse_args()
+
+    base = args.host if args.host.startswith("http") else "http://" + args.host
+    base = base.rstrip("/")
+    auth = "Basic " + base64.b64encode(("%s:%s" % (args.user, args.password)).encode()).decode()
+
+    rows = []
+    requests = errors = 0
+    start = time.monotonic()
+    deadline = start + args.minutes * 60.0
+
+    def sample():
+        h = heap(base, auth, args.timeout)
+        row = [round(time.monotonic() - start, 1), requests, errors, h["free"], h["min_free"], h["max_alloc"]]
+        rows.append(row)
+        print("%8.1f s %8d req %5d err  free %7d  min_free %7d  max_alloc %7d" % tuple(row))
+        sys.stdout.flush()
+
+    sample()
+    i = 0
+    while time.monotonic() < deadline:
+        try:
+            fetch(base, PATHS[i % len(PATHS)], auth, args.timeout)
+        except (urllib.error.URLError, OSError) as e:
+            errors += 1
+            if errors <= 5:
+                print("  ошибка %s: %s" % (PATHS[i % len(PATHS)], e))
+        requests += 1
+        i += 1
+        if requests % args.sample == 0:
+            sample()
+    sample()
+
+    if args.csv:
+        with open(args.csv, "w", newline="") as f:
+            w = csv.writer(f)
+            w.writerow(["seconds", "requests", "errors", "free", "min_free", "max_alloc"])
+            w.writerows(rows)
+
+    first, last = rows[0], rows[-1]
+    # Первые замеры — прогрев (буферы TCP, кэши); дрейф считаем от второго
+    ref = rows[1] if len(rows) > 2 else first
+    print()
+    print("запросов %d, ошибок %d, %.0f запр./с" % (requests, errors, requests / max(last[0], 1e-9)))
+    print("free:      %7d -> %7d (%+d после прогрева)" % (first[3], last[3], last[3] - ref[3]))
+    print("min_free:  %7d -> %7d (%+d после прогрева)" % (first[4], last[4], last[4] - ref[4]))
+    print("max_alloc: %7d -> %7d (%+d после прогрева)" % (first[5], last[5], last[5] - ref[5]))
+    return 1 if errors else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
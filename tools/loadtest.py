@@ -0,0 +1,177 @@
+#!/usr/bin/env python3
+# loadtest.py — нагрузочный тест веб-сервера прошивки.
+# N клиентов, у каждого своё keep-alive соединение; запросы идут подряд
+# (по умолчанию) или с периодом --interval, как у открытой панели.
+# Итог: запросов в секунду, задержки p50/p99/max по маршрутам, ошибки и
+# переподключения. До и после прогона читаются гистограммы Perf из /metrics:
+# по их разнице видно, как под нагрузкой работали обработчики (web_http),
+# потоковые ответы (web_ttfb) и не встала ли автоматика (automation,
+# sensors — задача управления).
+#   python3 tools/loadtest.py 192.168.1.50 --clients 3 --seconds 60
+#   python3 tools/loadtest.py 192.168.1.50 --clients 2 --interval 4 --paths /api/sensors
+# Только стандартная библиотека Python.
+import argparse
+import base64
+import http.client
+import re
+import sys
+import threading
+import time
+
+DEFAULT_PATHS = ["/api/sensors", "/api/sensors", "/api/settings", "/metrics"]
+PERF_CHANNELS = ["web_http", "web_ttfb", "automation", "sensors"]
+BUCKET_RE = re.compile(
+    r'^greenhouse_subsystem_duration_microseconds_bucket\{subsystem="([^"]+)",le="([^"]+)"\} (\d+)')
+
+
+def percentile(sorted_values, pct):
+    if not sorted_values:
+        return 0.0
+    k = min(len(sorted_values) - 1, max(0, int(round(pct / 100.0 * len(sorted_values) + 0.5)) - 1))
+    return sorted_values[k]
+
+
+class Client(threading.Thread):
+    def __init__(self, host, port, auth, paths, offset, interval, deadline, timeout):
+        super().__init__(daemon=True)
+        self.host, self.port, self.auth = host, port, auth
+        self.paths, self.offset = paths, offset
+        self.interval, self.deadline, self.timeout = interval, deadline, timeout
+        self.samples = []     # (путь, секунды, статус, байт)
+        self.errors = 0
+        self.connects = 0
+        self.conn = None
+
+    def connect(self):
+        if self.conn:
+            self.conn.close()
+        self.conn = http.client.HTTPConnection(self.host, self.port, timeout=self.timeout)
+        self.connects += 1
+
+    def run(self):
+        i = self.offset
+        next_at = time.monotonic()
+        while time.monotonic() < self.deadline:
+            if self.interval:
+                delay = next_at - time.monotonic()
+                if delay > 0:
+                    time.sleep(delay)
+                next_at += self.interval
+            path = self.paths[i % len(self.paths)]
+            i += 1
+            t0 = time.monotonic()
+            try:
+                if self.conn is None:
+                    self.connect()
+                self.conn.request("GET", path, headers={"Authorization": self.auth})
+                resp = self.conn.getresponse()
+                body = resp.read()
+                self.samples.append((path, time.monotonic() - t0, resp.status, len(body)))
+                if resp.status != 200:
+                    self.errors += 1
+                if resp.getheader("Connection", "").lower() == "close":
+                    self.conn.close()
+                    self.conn = None
+            except (OSError, http.client.HTTPException):
+                self.errors += 1
+                if self.conn:
+                    self.conn.close()
+                self.conn = None
+
+
+def perf_buckets(host, port, auth, timeout):
+    conn = http.client.HTTPConnection(host, port, timeout=timeout)
+    conn.request("GET", "/metrics", headers={"Authorization": auth})
+    text = conn.getresponse().read().decode("utf-8", "replace")
+    conn.close()
+    out = {}
+    for line in text.splitlines():
+        m = BUCKET_RE.match(line)
+        if m:
+            le = float("inf") if m.group(2) == "+Inf" else float(m.group(2))
+            out.setdefault(m.group(1), []).append((le, int(m.group(3))))
+    return out
+
+
+def perf_delta(before, after, channel):
+    # Корзины кумулятивные: разница «после − до» — гистограмма за прогон
+    a = dict(after.get(channel, []))
+    b = dict(before.get(channel, []))
+    rows = sorted((le, a[le] - b.get(le, 0)) for le in a)
+    count = rows[-1][1] if rows else 0
+
+    def bound(pct):
+        for le, c in rows:
+            if c >= count * pct / 100.0:
+                return le
+        return float("inf")
+
+    return count, bound(50), bound(99)
+
+
+def fmt_us(v):
+    return "> 8 с" if v == float("inf") else "≤ %d мкс" % v
+
+
+def main():
+    ap = argparse.ArgumentParser(description="Нагрузочный тест HTTP-сервера прошивки")
+    ap.add_argument("host", help="адрес устройства, например 192.168.1.50 или 192.168.1.50:80")
+    ap.add_argument("--user", default="admin")
+    ap.add_argument("--password", default="greenhouse")
+    ap.add_argument("--clients", type=int, default=3)
+    ap.add_argument("--seconds", type=float, default=30.0)
+    ap.add_argument("--interval", type=float, default=0.0, help="период запросов клиента, с; 0 — подряд")
+    ap.add_argument("--paths", nargs="+", default=DEFAULT_PATHS)
+    ap.add_argument("--timeout", type=float, default=10.0)
+    ap.add_argument("--no-perf", action="store_true", help="не читать гистограммы Perf из /metrics")
+    args = ap.parse_args()
+
+    host, _, port = args.host.replace("http://", "").rstrip("/").partition(":")
+    port = int(port) if port else 80
+    auth = "Basic " + base64.b64encode(("%s:%s" % (args.user, args.password)).encode()).decode()
+
+    before = None if args.no_perf else perf_buckets(host, port, auth, args.timeout)
+
+    start = time.monotonic()
+    deadline = start + args.seconds
+    clients = [Client(host, port, auth, args.paths, k, args.interval, deadline, args.timeout)
+               for k in range(args.clients)]
+    for c in clients:
+        c.start()
+    for c in clients:
+        c.join()
+    elapsed = time.monotonic() - start
+
+    after = None if args.no_perf else perf_buckets(host, port, auth, args.timeout)
+
+    samples = [s for c in clients for s in c.samples]
+    errors = sum(c.errors for c in clients)
+    connects = sum(c.connects for c in clients)
+    ok = [s for s in samples if s[2] == 200]
+
+    print("%d клиентов, %.1f с, %s" % (args.clients, elapsed,
+          "период %.1f с" % args.interval if args.interval else "запросы подряд"))
+    print("запросов %d, ошибок %d, соединений %d, %.1f запр./с, %.1f КБ/с" % (
+        len(samples), errors, connects, len(ok) / elapsed, sum(s[3] for s in ok) / elapsed / 1024))
+    print()
+    print("%-18s %7s %9s %9s %9s %9s" % ("маршрут", "запр.", "p50, мс", "p99, мс", "max, мс", "ср. байт"))
+    for path in sorted(set(args.paths)) + ["все"]:
+        sel = [s for s in ok if path == "все" or s[0] == path]
+        lat = sorted(s[1] * 1000 for s in sel)
+        if not lat:
+            continue
+        print("%-18s %7d %9.1f %9.1f %9.1f %9d" % (
+            path, len(lat), percentile(lat, 50), percentile(lat, 99), lat[-1], sum(s[3] for s in sel) / len(sel)))
+
+    if before is not None:
+        print()
+        print("Perf на устройстве за прогон (границы корзин log2):")
+        for ch in PERF_CHANNELS:
+            count, p50, p99 = perf_delta(before, after, ch)
+            print("  %-11s %7d вызовов  p50 %-14s p99 %s" % (ch, count, fmt_us(p50), fmt_us(p99)))
+
+    return 1 if errors else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
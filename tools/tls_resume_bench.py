@@ -0,0 +1,438 @@
+#!/usr/bin/env python3
+# tls_resume_bench.py — цена полного и возобновлённого TLS-рукопожатия
+# на стороне клиента, против локального TLS-сервера.
+# Сервер — отдельный процесс на 127.0.0.1 с самоподписанным сертификатом
+# (RSA-2048 или ECDSA P-256, как у api.telegram.org и типичных CDN), TLS 1.2
+# и ECDHE — то же, что у mbedtls 2.28 в прошивке. Клиент меряет время
+# рукопожатия и собственное время процессора (только поток клиента,
+# без сервера) для трёх вариантов:
+#   full    — без сохранённой сессии, как WiFiClientSecure при каждом connect;
+#   ticket  — сессия с тикетом RFC 5077, как TlsClient;
+#   id      — сервер без тикетов, возобновление по ID сессии.
+# Клиент — OpenSSL из Python, не mbedtls: абсолютные числа относятся к ПК,
+# показательно отношение. Числа устройства — /metrics,
+# greenhouse_telegram_handshake_* с kind="full"/"resumed".
+#   python3 tools/tls_resume_bench.py --count 200 --key rsa
+#
+# --bot — поддельный Bot API на 0.0.0.0:--port для прошивки (TelegramConfig::
+# TEST_API_*): long poll getUpdates, sendMessage/editMessageText и прочие
+# методы отвечают ok. Раз в --interval с в очередь встаёт команда --command
+# из чата --chat. Считает TLS-соединения (полные и возобновлённые), запросы
+# по методам и время «команда появилась → выдана в getUpdates → ответ
+# sendMessage/editMessageText в тот же чат». --self-test подключает к нему
+# клиента на Python, который ведёт себя как прошивка (два постоянных
+# соединения, переподключение приёма каждые --reconnect запросов).
+#   python3 tools/tls_resume_bench.py --bot --duration 300
+#   python3 tools/tls_resume_bench.py --bot --self-test --duration 60
+# Нужен openssl в PATH (сертификат для сервера).
+import argparse
+import hashlib
+import json
+import threading
+import urllib.parse
+import multiprocessing
+import os
+import socket
+import ssl
+import statistics
+import subprocess
+import sys
+import tempfile
+import time
+
+
+def make_cert(tmp, key):
+    cert = os.path.join(tmp, "cert.pem")
+    keyfile = os.path.join(tmp, "key.pem")
+    newkey = ["-newkey", "rsa:2048"] if key == "rsa" else \
+        ["-newkey", "ec", "-pkeyopt", "ec_paramgen_curve:prime256v1"]
+    subprocess.run(["openssl", "req", "-x509", "-nodes", "-days", "1", "-subj", "/CN=localhost",
+                    "-addext", "subjectAltName=DNS:localhost"] + newkey +
+                   ["-keyout", keyfile, "-out", cert],
+                   check=True, stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL)
+    return cert, keyfile
+
+
+def serve(cert, keyfile, tickets, ready, port_out):
+    ctx = ssl.SSLContext(ssl.PROTOCOL_TLS_SERVER)
+    ctx.minimum_version = ctx.maximum_version = ssl.TLSVersion.TLSv1_2
+    ctx.load_cert_chain(cert, keyfile)
+    if not tickets:
+        ctx.options |= ssl.OP_NO_TICKET
+    srv = socket.socket()
+    srv.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+    srv.bind(("127.0.0.1", 0))
+    srv.listen(16)
+    port_out.value = srv.getsockname()[1]
+    ready.set()
+    while True:
+        conn, _ = srv.accept()
+        try:
+            with ctx.wrap_socket(conn, server_side=True) as s:
+                s.recv(64)
+                s.sendall(b"ok")
+                # Без close_notify OpenSSL выбрасывает сессию из кэша
+                s.unwrap()
+        except (ssl.SSLError, OSError):
+            pass
+
+
+def start_server(cert, keyfile, tickets):
+    ready = multiprocessing.Event()
+    port = multiprocessing.Value("i", 0)
+    p = multiprocessing.Process(target=serve, args=(cert, keyfile, tickets, ready, port), daemon=True)
+    p.start()
+    ready.wait(10)
+    return p, port.value
+
+
+def run(port, cert, count, resume):
+    ctx = ssl.SSLContext(ssl.PROTOCOL_TLS_CLIENT)
+    ctx.minimum_version = ctx.maximum_version = ssl.TLSVersion.TLSv1_2
+    ctx.load_verify_locations(cert)
+    session = None
+    wall, cpu, reused = [], [], 0
+    for i in range(count + 1):
+        raw = socket.create_connection(("127.0.0.1", port))
+        raw.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+        s = ctx.wrap_socket(raw, server_hostname="localhost", do_handshake_on_connect=False,
+                            session=session if resume else None)
+        t0, c0 = time.perf_counter(), time.thread_time()
+        s.do_handshake()
+        c1, t1 = time.thread_time(), time.perf_counter()
+        s.sendall(b"GET")
+        s.recv(64)
+        if i > 0:   # первое соединение — получение сессии
+            wall.append((t1 - t0) * 1e3)
+            cpu.append((c1 - c0) * 1e6)
+            reused += s.session_reused
+        session = s.session
+        try:
+            s.unwrap()
+        except (ssl.SSLError, OSError):
+            pass
+        s.close()
+    return wall, cpu, reused
+
+
+# ===== Поддельный Bot API =====
+
+def make_bot_cert(tmp, key):
+    # Имя api.telegram.org: прошивка проверяет сертификат по нему, куда бы ни соединялась
+    cert = os.path.join(tmp, "bot.pem")
+    keyfile = os.path.join(tmp, "bot.key")
+    newkey = ["-newkey", "rsa:2048"] if key == "rsa" else \
+        ["-newkey", "ec", "-pkeyopt", "ec_paramgen_curve:prime256v1"]
+    if not (os.path.exists(cert) and os.path.exists(keyfile)):
+        subprocess.run(["openssl", "req", "-x509", "-nodes", "-days", "365", "-subj", "/CN=api.telegram.org",
+                        "-addext", "subjectAltName=DNS:api.telegram.org,DNS:localhost",
+                        "-addext", "basicConstraints=critical,CA:TRUE"] + newkey +
+                       ["-keyout", keyfile, "-out", cert],
+                       check=True, stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL)
+    der = subprocess.run(["openssl", "x509", "-in", cert, "-outform", "DER"],
+                         check=True, stdout=subprocess.PIPE).stdout
+    return cert, keyfile, hashlib.sha256(der).hexdigest().upper()
+
+
+def pct(values, q):
+    if not values:
+        return float("nan")
+    v = sorted(values)
+    return v[min(len(v) - 1, len(v) * q // 100)]
+
+
+class FakeBot:
+    def __init__(self, command, chat):
+        self.command = command
+        self.chat = chat
+        self.lock = threading.Condition()
+        self.updates = []        # (update_id, создана, выдана или None)
+        self.next_id = 1
+        self.next_message = 1000
+        self.waiting = []        # выданные команды без ответа: (создана, выдана)
+        self.connections = 0
+        self.resumed = 0
+        self.requests = {}
+        self.total_ms, self.deliver_ms, self.reply_ms = [], [], []
+        self.stop = threading.Event()
+
+    def inject(self):
+        with self.lock:
+            self.updates.append([self.next_id, time.perf_counter(), None])
+            self.next_id += 1
+            self.lock.notify_all()
+
+    def get_updates(self, params):
+        offset = int(params.get("offset", 0) or 0)
+        timeout = min(float(params.get("timeout", 0) or 0), 50.0)
+        deadline = time.perf_counter() + timeout
+        with self.lock:
+            self.updates = [u for u in self.updates if u[0] >= offset]
+            while not self.updates and not self.stop.is_set():
+                left = deadline - time.perf_counter()
+                if left <= 0:
+                    break
+                self.lock.wait(left)
+            now, result = time.perf_counter(), []
+            for u in self.updates:
+                if u[2] is None:
+                    u[2] = now
+                    self.deliver_ms.append((now - u[1]) * 1e3)
+                    self.waiting.append((u[1], now))
+                result.append({"update_id": u[0], "message": {
+                    "message_id": u[0], "date": int(time.time()), "text": self.command,
+                    "from": {"id": int(self.chat), "is_bot": False, "first_name": "bench"},
+                    "chat": {"id": int(self.chat), "type": "private", "first_name": "bench"}}})
+            return result
+
+    def answered(self, chat):
+        with self.lock:
+            self.next_message += 1
+            if str(chat) == str(self.chat) and self.waiting:
+                created, delivered = self.waiting.pop(0)
+                now = time.perf_counter()
+                self.total_ms.append((now - created) * 1e3)
+                self.reply_ms.append((now - delivered) * 1e3)
+            return self.next_message
+
+    def handle(self, method, params):
+        with self.lock:
+            self.requests[method] = self.requests.get(method, 0) + 1
+        if method == "getUpdates":
+            return self.get_updates(params)
+        if method in ("sendMessage", "editMessageText"):
+            chat = params.get("chat_id", "")
+            mid = self.answered(chat)
+            if method == "editMessageText" and params.get("message_id"):
+                mid = int(params["message_id"])
+            return {"message_id": mid, "date": int(time.time()), "text": params.get("text", ""),
+                    "chat": {"id": int(chat or 0), "type": "private"}}
+        if method == "getMe":
+            return {"id": 1, "is_bot": True, "first_name": "fake", "username": "fake_bot"}
+        return True
+
+
+def read_request(s, buf):
+    while b"\r\n\r\n" not in buf:
+        chunk = s.recv(4096)
+        if not chunk:
+            return None, b""
+        buf += chunk
+    head, _, rest = buf.partition(b"\r\n\r\n")
+    lines = head.decode("latin-1").split("\r\n")
+    verb, target = lines[0].split(" ")[:2]
+    headers = {}
+    for line in lines[1:]:
+        k, _, v = line.partition(":")
+        headers[k.strip().lower()] = v.strip()
+    length = int(headers.get("content-length", 0))
+    while len(rest) < length:
+        chunk = s.recv(4096)
+        if not chunk:
+            return None, b""
+        rest += chunk
+    body, rest = rest[:length], rest[length:]
+
+    url = urllib.parse.urlsplit(target)
+    params = {k: v[-1] for k, v in urllib.parse.parse_qs(url.query).items()}
+    if body:
+        if headers.get("content-type", "").startswith("application/json"):
+            try:
+                params.update({k: v if isinstance(v, str) else json.dumps(v) if isinstance(v, (dict, list))
+                               else str(v) for k, v in json.loads(body).items()})
+            except ValueError:
+                pass
+        else:
+            params.update({k: v[-1] for k, v in urllib.parse.parse_qs(body.decode("utf-8", "replace")).items()})
+    return (verb, url.path.rsplit("/", 1)[-1], params), rest
+
+
+def serve_connection(bot, ctx, conn):
+    try:
+        with ctx.wrap_socket(conn, server_side=True) as s:
+            with bot.lock:
+                bot.connections += 1
+                bot.resumed += s.session_reused
+            buf = b""
+            while not bot.stop.is_set():
+                req, buf = read_request(s, buf)
+                if req is None:
+                    break
+                _, method, params = req
+                body = json.dumps({"ok": True, "result": bot.handle(method, params)},
+                                  ensure_ascii=False).encode()
+                s.sendall(b"HTTP/1.1 200 OK\r\nContent-Type: application/json\r\n"
+                          b"Connection: keep-alive\r\nContent-Length: %d\r\n\r\n" % len(body) + body)
+    except (ssl.SSLError, OSError, ValueError):
+        pass
+
+
+def serve_bot(bot, cert, keyfile, port):
+    ctx = ssl.SSLContext(ssl.PROTOCOL_TLS_SERVER)
+    ctx.minimum_version = ctx.maximum_version = ssl.TLSVersion.TLSv1_2
+    ctx.load_cert_chain(cert, keyfile)
+    srv = socket.socket()
+    srv.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+    srv.bind(("0.0.0.0", port))
+    srv.listen(16)
+    srv.settimeout(0.5)
+    while not bot.stop.is_set():
+        try:
+            conn, _ = srv.accept()
+        except socket.timeout:
+            continue
+        threading.Thread(target=serve_connection, args=(bot, ctx, conn), daemon=True).start()
+    srv.close()
+
+
+# Клиент как прошивка: приём — long poll на своём соединении, ответы — на
+# втором; сессия TLS сохраняется и предлагается при переподключении
+class SelfTestClient:
+    def __init__(self, port, cert, chat, reconnect, long_poll):
+        self.port, self.chat, self.reconnect, self.long_poll = port, chat, reconnect, long_poll
+        self.ctx = ssl.SSLContext(ssl.PROTOCOL_TLS_CLIENT)
+        self.ctx.minimum_version = self.ctx.maximum_version = ssl.TLSVersion.TLSv1_2
+        self.ctx.load_verify_locations(cert)
+        self.session = None
+        self.inbox = []
+        self.cv = threading.Condition()
+
+    def connect(self):
+        raw = socket.create_connection(("127.0.0.1", self.port))
+        raw.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+        s = self.ctx.wrap_socket(raw, server_hostname="api.telegram.org", session=self.session)
+        self.session = s.session
+        return s
+
+    def call(self, s, verb, path, body=b""):
+        head = "%s /botTOKEN/%s HTTP/1.1\r\nHost: api.telegram.org\r\n" % (verb, path)
+        if body:
+            head += "Content-Type: application/json\r\nContent-Length: %d\r\n" % len(body)
+        s.sendall(head.encode() + b"\r\n" + body)
+        buf = b""
+        while b"\r\n\r\n" not in buf:
+            buf += s.recv(4096)
+        head, _, rest = buf.partition(b"\r\n\r\n")
+        length = int([l.split(b":")[1] for l in head.split(b"\r\n") if l.lower().startswith(b"content-length")][0])
+        while len(rest) < length:
+            rest += s.recv(4096)
+        return json.loads(rest[:length])["result"]
+
+    def rx(self, stop):
+        offset, s, n = 0, None, 0
+        while not stop.is_set():
+            if s is None:
+                s = self.connect()
+            res = self.call(s, "GET", "getUpdates?offset=%d&limit=1&timeout=%d" % (offset, self.long_poll))
+            for u in res:
+                offset = u["update_id"] + 1
+                with self.cv:
+                    self.inbox.append(u["message"]["chat"]["id"])
+                    self.cv.notify()
+            n += 1
+            if self.reconnect and n % self.reconnect == 0:
+                s.close()
+                s = None
+
+    def tx(self, stop):
+        s = self.connect()
+        while not stop.is_set():
+            with self.cv:
+                while not self.inbox and not stop.is_set():
+                    self.cv.wait(0.5)
+                if not self.inbox:
+                    continue
+                chat = self.inbox.pop(0)
+            self.call(s, "POST", "sendMessage", json.dumps({"chat_id": chat, "text": "ok"}).encode())
+
+
+def run_bot(args):
+    bot = FakeBot(args.command, args.chat)
+    with tempfile.TemporaryDirectory() as tmp:
+        # --cert-dir: тот же сертификат между запусками — прошивку не перешивать
+        cert_dir = args.cert_dir or tmp
+        os.makedirs(cert_dir, exist_ok=True)
+        cert, keyfile, fingerprint = make_bot_cert(cert_dir, args.key)
+        with open(cert) as f:
+            pem = f.read()
+        threading.Thread(target=serve_bot, args=(bot, cert, keyfile, args.port), daemon=True).start()
+
+        print("Поддельный Bot API на порту %d. Для прошивки (Config.h, TelegramConfig):" % args.port)
+        print("  TEST_API_HOST = \"<адрес этого ПК>\", TEST_API_PORT = %d, CHAT_ID = \"%s\"" % (args.port, args.chat))
+        print("  CERT_SHA256   = \"%s\"" % fingerprint)
+        print("  TEST_ROOT_CA  = R\"(" + pem + ")\";")
+        sys.stdout.flush()
+
+        if args.self_test:
+            time.sleep(0.3)
+            client = SelfTestClient(args.port, cert, args.chat, args.reconnect, args.long_poll)
+            for fn in (client.rx, client.tx):
+                threading.Thread(target=fn, args=(bot.stop,), daemon=True).start()
+
+        end = time.monotonic() + args.duration
+        try:
+            while time.monotonic() < end:
+                time.sleep(args.interval)
+                bot.inject()
+        except KeyboardInterrupt:
+            pass
+        bot.stop.set()
+        with bot.lock:
+            bot.lock.notify_all()
+
+    with bot.lock:
+        print("соединений TLS %d: полных %d, возобновлённых %d" % (
+            bot.connections, bot.connections - bot.resumed, bot.resumed))
+        print("запросы: " + ", ".join("%s=%d" % kv for kv in sorted(bot.requests.items())))
+        print("команд отправлено %d, отвечено %d" % (bot.next_id - 1, len(bot.total_ms)))
+        print("%-28s %9s %9s %9s" % ("", "p50, мс", "p99, мс", "max, мс"))
+        for name, v in (("команда → getUpdates", bot.deliver_ms), ("getUpdates → ответ", bot.reply_ms),
+                        ("команда → ответ", bot.total_ms)):
+            print("%-28s %9.1f %9.1f %9.1f" % (name, pct(v, 50), pct(v, 99), max(v) if v else float("nan")))
+        return 0 if bot.total_ms else 1
+
+
+def main():
+    ap = argparse.ArgumentParser(description="Полное против возобновлённого TLS-рукопожатия; --bot — поддельный Bot API")
+    ap.add_argument("--count", type=int, default=200)
+    ap.add_argument("--key", choices=["rsa", "ec"], default="rsa")
+    ap.add_argument("--bot", action="store_true", help="поддельный api.telegram.org для прошивки")
+    ap.add_argument("--port", type=int, default=8443)
+    ap.add_argument("--chat", default="100200300", help="chat_id команд (CHAT_ID прошивки)")
+    ap.add_argument("--command", default="/status")
+    ap.add_argument("--interval", type=float, default=2.0, help="секунд между командами")
+    ap.add_argument("--duration", type=float, default=120.0)
+    ap.add_argument("--cert-dir", help="где хранить сертификат поддельного сервера между запусками")
+    ap.add_argument("--self-test", action="store_true", help="вместо прошивки — клиент на Python")
+    ap.add_argument("--reconnect", type=int, default=10, help="self-test: переподключать приём каждые N запросов")
+    ap.add_argument("--long-poll", type=int, default=25, help="self-test: timeout getUpdates, с")
+    args = ap.parse_args()
+
+    if args.bot:
+        return run_bot(args)
+
+    with tempfile.TemporaryDirectory() as tmp:
+        cert, keyfile = make_cert(tmp, args.key)
+        rows = []
+        for name, tickets, resume in (("full", True, False), ("ticket", True, True), ("id", False, True)):
+            proc, port = start_server(cert, keyfile, tickets)
+            try:
+                wall, cpu, reused = run(port, cert, args.count, resume)
+            finally:
+                proc.terminate()
+            rows.append((name, reused, wall, cpu))
+
+    print("TLS 1.2, %s, %d рукопожатий на вариант, клиент OpenSSL %s" % (
+        "RSA-2048" if args.key == "rsa" else "ECDSA P-256", args.count, ssl.OPENSSL_VERSION.split()[1]))
+    print("%-7s %9s %11s %11s %13s %8s" % ("вариант", "возобн.", "p50, мс", "p99, мс", "CPU ср., мкс", "CPU, %"))
+    base = statistics.mean(rows[0][3])
+    for name, reused, wall, cpu in rows:
+        wall.sort()
+        print("%-7s %8d%% %11.3f %11.3f %13.0f %7.0f%%" % (
+            name, 100 * reused // len(wall), wall[len(wall) // 2], wall[min(len(wall) - 1, len(wall) * 99 // 100)],
+            statistics.mean(cpu), 100 * statistics.mean(cpu) / base))
+    return 0 if rows[1][1] == len(rows[1][2]) and rows[2][1] == len(rows[2][2]) else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())